@@ -0,0 +1,37 @@
+#ifndef _BENCH_H_
+#define _BENCH_H_
+
+/*!
+ * @file bench.h
+ * @brief Tiny helpers shared by the benchmark drivers.
+ */
+
+#include <chrono>     // std::chrono::steady_clock
+#include <cstddef>    // std::size_t
+
+namespace bench {
+    /// Keeps the compiler from optimizing away a value the benchmark computed.
+    template < typename T >
+    inline void do_not_optimize( const T & value ){
+        asm volatile( "" : : "r,m"( value ) : "memory" );
+    }
+
+    /**
+     * @brief Runs 'fn' 'reps' times and returns the average time of one run, in nanoseconds.
+     *
+     * @param reps Number of repetitions.
+     * @param fn The code being measured.
+     * @return double Nanoseconds per run.
+     */
+    template < typename Fn >
+    double ns_per_run( std::size_t reps, Fn fn ){
+        fn(); // Warm up caches and the allocator.
+        auto start = std::chrono::steady_clock::now();
+        for( std::size_t i{0} ; i < reps ; ++i ){
+            fn();
+        }
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>( end - start ).count() / reps;
+    }
+} // namespace bench.
+#endif
@@ -0,0 +1,76 @@
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+#include "vector.h"
+#include "concurrent_vector.h"
+
+/// Runs 'fn( t )' on 'threads' threads at once and waits for all of them.
+template < typename Fn >
+void run_threads( std::size_t threads, Fn fn ){
+    std::vector<std::thread> workers;
+    for( std::size_t t{0} ; t < threads ; ++t ){
+        workers.emplace_back( fn, t );
+    }
+    for( auto & w : workers ){
+        w.join();
+    }
+}
+
+int main( int argc, char * argv[] )
+{
+    // Usage: bench_concurrent_vector [elements] [max threads]
+    const std::size_t n = argc > 1 ? std::strtoull( argv[1], nullptr, 10 ) : 8000000;
+    const std::size_t maxThreads = argc > 2 ? std::strtoull( argv[2], nullptr, 10 ) : 64;
+
+    std::cout << n << " push_back calls split across threads (ms).\n\n";
+    std::cout << std::setw( 8 ) << "threads"
+              << std::setw( 26 ) << "mutex + sc::vector"
+              << std::setw( 26 ) << "sc::concurrent_vector"
+              << std::setw( 26 ) << "grow_by(64) batches" << "\n";
+    std::cout << std::fixed << std::setprecision( 2 );
+
+    for( std::size_t threads{1} ; threads <= maxThreads ; threads *= 2 ){
+        const std::size_t per_thread = n / threads;
+        double locked = bench::ns_per_run( 3, [&](){
+            sc::vector<long long> v;
+            std::mutex m;
+            run_threads( threads, [&]( std::size_t t ){
+                for( std::size_t i{0} ; i < per_thread ; ++i ){
+                    std::lock_guard<std::mutex> lock{ m };
+                    v.push_back( static_cast<long long>( t * per_thread + i ) );
+                }
+            } );
+            bench::do_not_optimize( v.size() );
+        } );
+        double lock_free = bench::ns_per_run( 3, [&](){
+            sc::concurrent_vector<long long> v;
+            run_threads( threads, [&]( std::size_t t ){
+                for( std::size_t i{0} ; i < per_thread ; ++i ){
+                    v.push_back( static_cast<long long>( t * per_thread + i ) );
+                }
+            } );
+            bench::do_not_optimize( v.size() );
+        } );
+        double batched = bench::ns_per_run( 3, [&](){
+            sc::concurrent_vector<long long> v;
+            run_threads( threads, [&]( std::size_t t ){
+                for( std::size_t i{0} ; i + 64 <= per_thread ; i += 64 ){
+                    std::size_t first = v.grow_by( 64, static_cast<long long>( t ) );
+                    bench::do_not_optimize( first );
+                }
+            } );
+            bench::do_not_optimize( v.size() );
+        } );
+        std::cout << std::setw( 8 ) << threads
+                  << std::setw( 26 ) << locked / 1e6
+                  << std::setw( 26 ) << lock_free / 1e6
+                  << std::setw( 26 ) << batched / 1e6 << "\n";
+    }
+
+    return 0;
+}
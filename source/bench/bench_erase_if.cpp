@@ -0,0 +1,54 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <random>
+
+#include "bench.h"
+#include "vector.h"
+
+/// Fills 'c' with 'n' pseudo-random timestamps in [0, 1000).
+template < typename Container >
+void fill( Container & c, std::size_t n ){
+    std::mt19937 gen{ 42 };
+    std::uniform_int_distribution<int> dist{ 0, 999 };
+    c.clear();
+    for( std::size_t i{0} ; i < n ; ++i ){
+        c.push_back( dist( gen ) );
+    }
+}
+
+int main( void )
+{
+    const std::size_t n{10000000};
+    const int cutoffs[]{ 10, 500, 990 };
+
+    std::cout << "Purge the entries older than a cutoff from " << n << " random timestamps (ms).\n\n";
+    std::cout << std::setw( 8 ) << "expired"
+              << std::setw( 22 ) << "std::remove_if+erase"
+              << std::setw( 20 ) << "sc::vector erase_if" << "\n";
+    std::cout << std::fixed << std::setprecision( 2 );
+    for( auto cutoff : cutoffs ){
+        std::vector<int> stl;
+        sc::vector<int> vec;
+        auto expired = [cutoff]( int t ){ return t < cutoff; };
+        // Refilling is part of each run; time it alone to subtract it.
+        double stl_fill = bench::ns_per_run( 3, [&](){ fill( stl, n ); } );
+        double sc_fill = bench::ns_per_run( 3, [&](){ fill( vec, n ); } );
+        double stl_ns = bench::ns_per_run( 3, [&](){
+            fill( stl, n );
+            stl.erase( std::remove_if( stl.begin(), stl.end(), expired ), stl.end() );
+            bench::do_not_optimize( stl.size() );
+        } );
+        double sc_ns = bench::ns_per_run( 3, [&](){
+            fill( vec, n );
+            vec.erase_if( expired );
+            bench::do_not_optimize( vec.size() );
+        } );
+        std::cout << std::setw( 7 ) << cutoff / 10 << "%"
+                  << std::setw( 22 ) << ( stl_ns - stl_fill ) / 1e6
+                  << std::setw( 20 ) << ( sc_ns - sc_fill ) / 1e6 << "\n";
+    }
+
+    return 0;
+}
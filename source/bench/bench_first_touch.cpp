@@ -0,0 +1,102 @@
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <thread>
+
+#include "bench.h"
+#include "vector.h"
+#include "parallel.h"
+
+int main( int argc, char * argv[] )
+{
+    // Usage: bench_first_touch [elements] [max threads]
+    const std::size_t n = argc > 1 ? std::strtoull( argv[1], nullptr, 10 ) : 50000000;
+    std::size_t maxThreads = argc > 2 ? std::strtoull( argv[2], nullptr, 10 ) : std::thread::hardware_concurrency();
+    if( maxThreads == 0 ){
+        maxThreads = 1;
+    }
+
+    sc::vector<double> source( n, 1.5 );
+    sc::vector<double> target( n );
+
+    // Every construction gets a fresh block, so its page faults are part of the cost.
+    std::cout << "Building " << n << " doubles (ms, speedup over the serial member in parentheses).\n"
+              << "for_each is a pass over a vector built with the same policy.\n\n";
+    std::cout << std::setw( 8 ) << "threads"
+              << std::setw( 18 ) << "vector(n)"
+              << std::setw( 18 ) << "vector(other)"
+              << std::setw( 18 ) << "assign(n, x)"
+              << std::setw( 18 ) << "assign(other)"
+              << std::setw( 18 ) << "for_each" << "\n";
+    std::cout << std::fixed << std::setprecision( 2 );
+
+    double base[5];
+    {
+        sc::par::thread_pool pool( maxThreads );
+        base[0] = bench::ns_per_run( 5, [&](){
+            sc::vector<double> vec( n );
+            bench::do_not_optimize( vec.data() );
+        } );
+        base[1] = bench::ns_per_run( 5, [&](){
+            sc::vector<double> vec( source );
+            bench::do_not_optimize( vec.data() );
+        } );
+        base[2] = bench::ns_per_run( 5, [&](){
+            target.assign( n, 2.5 );
+            bench::do_not_optimize( target.data() );
+        } );
+        base[3] = bench::ns_per_run( 5, [&](){
+            target = source;
+            bench::do_not_optimize( target.data() );
+        } );
+        sc::vector<double> serial( n );
+        base[4] = bench::ns_per_run( 5, [&](){
+            sc::par::for_each( serial, []( double & x ){ x += 1.0; }, pool );
+        } );
+    }
+    std::cout << std::setw( 8 ) << "serial";
+    for( int k{0} ; k < 5 ; ++k ){
+        std::cout << std::setw( 10 ) << base[k] / 1e6 << "        ";
+    }
+    std::cout << "\n";
+
+    for( std::size_t threads{1} ; ; threads *= 2 ){
+        if( threads > maxThreads ){
+            threads = maxThreads;
+        }
+        sc::par::thread_pool pool( threads );
+        sc::par::first_touch policy( pool );
+        double ns[5];
+        ns[0] = bench::ns_per_run( 5, [&](){
+            sc::vector<double> vec( n, policy );
+            bench::do_not_optimize( vec.data() );
+        } );
+        ns[1] = bench::ns_per_run( 5, [&](){
+            sc::vector<double> vec( source, policy );
+            bench::do_not_optimize( vec.data() );
+        } );
+        ns[2] = bench::ns_per_run( 5, [&](){
+            target.assign( n, 2.5, policy );
+            bench::do_not_optimize( target.data() );
+        } );
+        ns[3] = bench::ns_per_run( 5, [&](){
+            target.assign( source, policy );
+            bench::do_not_optimize( target.data() );
+        } );
+        sc::vector<double> touched( n, policy );
+        ns[4] = bench::ns_per_run( 5, [&](){
+            sc::par::for_each( touched, []( double & x ){ x += 1.0; }, pool );
+        } );
+
+        std::cout << std::setw( 8 ) << threads;
+        for( int k{0} ; k < 5 ; ++k ){
+            std::cout << std::setw( 10 ) << ns[k] / 1e6 << " (" << std::setw( 4 ) << std::setprecision( 1 ) << base[k] / ns[k] << "x)" << std::setprecision( 2 );
+        }
+        std::cout << "\n";
+        if( threads == maxThreads ){
+            break;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include <iostream>
+#include <iomanip>
+#include <map>
+#include <vector>
+#include <random>
+
+#include "bench.h"
+#include "flat_map.h"
+
+int main( void )
+{
+    const std::size_t sizes[]{ 100, 10000, 1000000 };
+    const std::size_t lookups{1000000};
+
+    std::cout << "Look up " << lookups << " random keys, about half of them present (ns per lookup).\n\n";
+    std::cout << std::setw( 10 ) << "entries"
+              << std::setw( 12 ) << "std::map"
+              << std::setw( 14 ) << "sc::flat_map"
+              << std::setw( 18 ) << "bulk build (ms)" << "\n";
+    std::cout << std::fixed << std::setprecision( 2 );
+    for( auto n : sizes ){
+        std::mt19937 gen{ 42 };
+        std::uniform_int_distribution<int> dist{ 0, int( 2 * n ) };
+        std::vector< std::pair<int, int> > entries;
+        for( std::size_t i{0} ; i < n ; ++i ){
+            entries.push_back( { dist( gen ), int( i ) } );
+        }
+        std::vector<int> probes;
+        for( std::size_t i{0} ; i < lookups ; ++i ){
+            probes.push_back( dist( gen ) );
+        }
+
+        std::map<int, int> tree( entries.begin(), entries.end() );
+        sc::flat_map<int, int> flat;
+        double build_ns = bench::ns_per_run( 3, [&](){
+            flat.clear();
+            flat.insert( entries.begin(), entries.end() );
+        } );
+
+        double tree_ns = bench::ns_per_run( 3, [&](){
+            long long sum{0};
+            for( auto k : probes ){
+                auto it = tree.find( k );
+                sum += it == tree.end() ? 0 : it->second;
+            }
+            bench::do_not_optimize( sum );
+        } );
+        double flat_ns = bench::ns_per_run( 3, [&](){
+            long long sum{0};
+            for( auto k : probes ){
+                auto it = flat.find( k );
+                sum += it == flat.end() ? 0 : it->second;
+            }
+            bench::do_not_optimize( sum );
+        } );
+        std::cout << std::setw( 10 ) << tree.size()
+                  << std::setw( 12 ) << tree_ns / lookups
+                  << std::setw( 14 ) << flat_ns / lookups
+                  << std::setw( 18 ) << build_ns / 1e6 << "\n";
+    }
+
+    return 0;
+}
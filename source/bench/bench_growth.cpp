@@ -0,0 +1,47 @@
+#include <iostream>
+#include <iomanip>
+
+#include "bench.h"
+#include "vector.h"
+#include "allocator.h"
+#include "growth.h"
+
+/// Grows a container to 'n' ints by push_back, one element at a time.
+template < typename Container >
+double grow_to( std::size_t n, std::size_t reps ){
+    return bench::ns_per_run( reps, [n](){
+        Container c;
+        for( std::size_t i{0} ; i < n ; ++i ){
+            c.push_back( static_cast<int>( i ) );
+        }
+        bench::do_not_optimize( c.data() );
+    } );
+}
+
+int main( void )
+{
+    const std::size_t sizes[]{ 1000, 100000, 1000000, 10000000, 100000000 };
+
+    using doubling = sc::vector< int >;
+    using half = sc::vector< int, std::allocator<int>, sc::one_and_half_growth >;
+    using paged = sc::vector< int, std::allocator<int>, sc::size_class_growth<> >;
+    using in_place = sc::vector< int, sc::malloc_allocator<int> >;
+
+    std::cout << "Grow a vector to n ints by push_back (ms per vector).\n\n";
+    std::cout << std::setw( 10 ) << "n"
+              << std::setw( 10 ) << "2x"
+              << std::setw( 10 ) << "1.5x"
+              << std::setw( 14 ) << "size class"
+              << std::setw( 14 ) << "realloc 2x" << "\n";
+    std::cout << std::fixed << std::setprecision( 3 );
+    for( auto n : sizes ){
+        std::size_t reps = n >= 10000000 ? 3 : 100000000 / n;
+        std::cout << std::setw( 10 ) << n
+                  << std::setw( 10 ) << grow_to< doubling >( n, reps ) / 1e6
+                  << std::setw( 10 ) << grow_to< half >( n, reps ) / 1e6
+                  << std::setw( 14 ) << grow_to< paged >( n, reps ) / 1e6
+                  << std::setw( 14 ) << grow_to< in_place >( n, reps ) / 1e6 << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+
+#include "bench.h"
+#include "vector.h"
+#include "mmap_vector.h"
+
+int main( int argc, char * argv[] )
+{
+    const std::size_t n = argc > 1 ? std::strtoull( argv[1], nullptr, 10 ) : 32000000;
+    const std::string path = argc > 2 ? argv[2] : "/tmp/bench_mmap_vector.bin";
+
+    {
+        sc::mmap_vector<double> out{ path };
+        out.reserve( n );
+        for( std::size_t i{0} ; i < n ; ++i ){
+            out.push_back( double( i % 1000 ) );
+        }
+    }
+
+    std::cout << "Opening a file of " << n << " doubles (" << n * sizeof( double ) / ( 1 << 20 ) << " MiB), in ms.\n\n";
+    std::cout << std::setw( 46 ) << "open" << std::setw( 16 ) << "open + sum" << "\n";
+    std::cout << std::fixed << std::setprecision( 3 );
+
+    double read_open = bench::ns_per_run( 5, [&](){
+        std::ifstream in{ path, std::ios::binary };
+        sc::vector<double> v( n );
+        in.read( reinterpret_cast<char *>( v.data() ), std::streamsize( n * sizeof( double ) ) );
+        bench::do_not_optimize( v[n - 1] );
+    } );
+    double read_sum = bench::ns_per_run( 5, [&](){
+        std::ifstream in{ path, std::ios::binary };
+        sc::vector<double> v( n );
+        in.read( reinterpret_cast<char *>( v.data() ), std::streamsize( n * sizeof( double ) ) );
+        double s{0};
+        for( double x : v ){
+            s += x;
+        }
+        bench::do_not_optimize( s );
+    } );
+    std::cout << std::setw( 30 ) << "read into sc::vector"
+              << std::setw( 16 ) << read_open / 1e6 << std::setw( 16 ) << read_sum / 1e6 << "\n";
+
+    double map_open = bench::ns_per_run( 5, [&](){
+        auto v = sc::mmap_vector<double>::open_readonly( path );
+        bench::do_not_optimize( v.size() );
+    } );
+    double map_sum = bench::ns_per_run( 5, [&](){
+        auto v = sc::mmap_vector<double>::open_readonly( path );
+        v.advise( sc::mmap_vector<double>::access::sequential );
+        double s{0};
+        for( double x : v ){
+            s += x;
+        }
+        bench::do_not_optimize( s );
+    } );
+    std::cout << std::setw( 30 ) << "sc::mmap_vector::open_readonly"
+              << std::setw( 16 ) << map_open / 1e6 << std::setw( 16 ) << map_sum / 1e6 << "\n";
+
+    std::remove( path.c_str() );
+    return 0;
+}
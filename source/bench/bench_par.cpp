@@ -0,0 +1,70 @@
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cmath>
+#include <functional>
+#include <thread>
+
+#include "bench.h"
+#include "vector.h"
+#include "parallel.h"
+
+int main( int argc, char * argv[] )
+{
+    // Usage: bench_par [elements] [max threads]
+    const std::size_t n = argc > 1 ? std::strtoull( argv[1], nullptr, 10 ) : 50000000;
+    std::size_t maxThreads = argc > 2 ? std::strtoull( argv[2], nullptr, 10 ) : std::thread::hardware_concurrency();
+    if( maxThreads == 0 ){
+        maxThreads = 1;
+    }
+
+    sc::vector<double> vec( n, 1.0 );
+    sc::vector<double> out( n );
+
+    std::cout << "sc::par over " << n << " doubles (ms, speedup over one thread in parentheses).\n\n";
+    std::cout << std::setw( 8 ) << "threads"
+              << std::setw( 18 ) << "for_each"
+              << std::setw( 18 ) << "transform"
+              << std::setw( 18 ) << "reduce"
+              << std::setw( 18 ) << "transform_reduce"
+              << std::setw( 18 ) << "inclusive_scan" << "\n";
+    std::cout << std::fixed << std::setprecision( 2 );
+
+    double base[5]{};
+    for( std::size_t threads{1} ; ; threads *= 2 ){
+        if( threads > maxThreads ){
+            threads = maxThreads;
+        }
+        sc::par::thread_pool pool( threads );
+        double ns[5];
+        ns[0] = bench::ns_per_run( 5, [&](){
+            sc::par::for_each( vec, []( double & x ){ x = std::sqrt( x ); }, pool );
+        } );
+        ns[1] = bench::ns_per_run( 5, [&](){
+            sc::par::transform( vec, out, []( double x ){ return x * 1.5 + 2.0; }, pool );
+        } );
+        ns[2] = bench::ns_per_run( 5, [&](){
+            bench::do_not_optimize( sc::par::reduce( vec, 0.0, std::plus<double>(), pool ) );
+        } );
+        ns[3] = bench::ns_per_run( 5, [&](){
+            bench::do_not_optimize( sc::par::transform_reduce( vec, out, 0.0, std::plus<double>(), std::multiplies<double>(), pool ) );
+        } );
+        ns[4] = bench::ns_per_run( 5, [&](){
+            sc::par::inclusive_scan( vec, out, std::plus<double>(), pool );
+        } );
+
+        std::cout << std::setw( 8 ) << threads;
+        for( int k{0} ; k < 5 ; ++k ){
+            if( threads == 1 ){
+                base[k] = ns[k];
+            }
+            std::cout << std::setw( 10 ) << ns[k] / 1e6 << " (" << std::setw( 4 ) << std::setprecision( 1 ) << base[k] / ns[k] << "x)" << std::setprecision( 2 );
+        }
+        std::cout << "\n";
+        if( threads == maxThreads ){
+            break;
+        }
+    }
+
+    return 0;
+}
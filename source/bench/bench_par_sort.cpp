@@ -0,0 +1,63 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
+
+#include "bench.h"
+#include "vector.h"
+#include "parallel.h"
+
+int main( int argc, char * argv[] )
+{
+    // Usage: bench_par_sort [elements] [max threads]
+    const std::size_t n = argc > 1 ? std::strtoull( argv[1], nullptr, 10 ) : 20000000;
+    std::size_t maxThreads = argc > 2 ? std::strtoull( argv[2], nullptr, 10 ) : std::thread::hardware_concurrency();
+    if( maxThreads == 0 ){
+        maxThreads = 1;
+    }
+
+    sc::vector<std::uint64_t> input( n );
+    std::uint64_t x{88172645463325252ULL};
+    for( auto & v : input ){
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        v = x;
+    }
+    sc::vector<std::uint64_t> work( n );
+
+    std::cout << "Sorting " << n << " random uint64_t (ms, speedup over std::sort in parentheses).\n\n";
+    std::cout << std::setw( 8 ) << "threads"
+              << std::setw( 14 ) << "std::sort"
+              << std::setw( 22 ) << "par::sort"
+              << std::setw( 22 ) << "par::stable_sort" << "\n";
+    std::cout << std::fixed << std::setprecision( 2 );
+
+    double serial = bench::ns_per_run( 3, [&](){
+        std::copy( input.begin(), input.end(), work.begin() );
+        std::sort( work.begin(), work.end() );
+    } );
+    for( std::size_t threads{1} ; ; threads *= 2 ){
+        if( threads > maxThreads ){
+            threads = maxThreads;
+        }
+        sc::par::thread_pool pool( threads );
+        double unstable = bench::ns_per_run( 3, [&](){
+            std::copy( input.begin(), input.end(), work.begin() );
+            sc::par::sort( work, std::less<std::uint64_t>(), pool );
+        } );
+        double stable = bench::ns_per_run( 3, [&](){
+            std::copy( input.begin(), input.end(), work.begin() );
+            sc::par::stable_sort( work, std::less<std::uint64_t>(), pool );
+        } );
+        std::cout << std::setw( 8 ) << threads
+                  << std::setw( 14 ) << serial / 1e6
+                  << std::setw( 14 ) << unstable / 1e6 << " (" << std::setw( 4 ) << serial / unstable << ")"
+                  << std::setw( 14 ) << stable / 1e6 << " (" << std::setw( 4 ) << serial / stable << ")" << "\n";
+        if( threads == maxThreads ){
+            break;
+        }
+    }
+
+    return 0;
+}
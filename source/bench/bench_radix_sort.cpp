@@ -0,0 +1,65 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+#include "bench.h"
+#include "vector.h"
+#include "radix_sort.h"
+
+/// Fills 'vec' with 'n' pseudo random keys of type T.
+template < typename T >
+void fill_random( sc::vector<T> & vec, std::size_t n ){
+    std::uint64_t x{88172645463325252ULL};
+    vec = sc::vector<T>( n );
+    for( auto & v : vec ){
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        v = static_cast<T>( static_cast<std::int64_t>( x ) );
+    }
+}
+
+/// Prints ns per element of std::sort and sc::radix_sort on 'n' random keys of type T.
+template < typename T >
+void compare( const char * name, std::size_t n ){
+    sc::vector<T> input;
+    fill_random( input, n );
+    sc::vector<T> work( n );
+    std::size_t reps = n < 100000 ? 200 : n < 10000000 ? 5 : 1;
+    double serial = bench::ns_per_run( reps, [&](){
+        std::copy( input.begin(), input.end(), work.begin() );
+        std::sort( work.data(), work.data() + n );
+    } );
+    double radix = bench::ns_per_run( reps, [&](){
+        std::copy( input.begin(), input.end(), work.begin() );
+        sc::radix_sort( work );
+    } );
+    std::cout << std::setw( 10 ) << name
+              << std::setw( 14 ) << n
+              << std::setw( 14 ) << serial / n
+              << std::setw( 14 ) << radix / n
+              << std::setw( 10 ) << serial / radix << "\n";
+}
+
+int main( int argc, char * argv[] )
+{
+    // Usage: bench_radix_sort [max elements]
+    const std::size_t maxN = argc > 1 ? std::strtoull( argv[1], nullptr, 10 ) : 10000000;
+
+    std::cout << "Sorting random keys (ns per element, copy included).\n\n";
+    std::cout << std::setw( 10 ) << "type"
+              << std::setw( 14 ) << "n"
+              << std::setw( 14 ) << "std::sort"
+              << std::setw( 14 ) << "radix_sort"
+              << std::setw( 10 ) << "speedup" << "\n";
+    std::cout << std::fixed << std::setprecision( 2 );
+
+    for( std::size_t n{1000} ; n <= maxN ; n *= 10 ){
+        compare<std::uint32_t>( "uint32_t", n );
+        compare<std::uint64_t>( "uint64_t", n );
+        compare<std::int64_t>( "int64_t", n );
+        compare<float>( "float", n );
+    }
+
+    return 0;
+}
@@ -0,0 +1,126 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+#include "vector.h"
+#include "rcu_vector.h"
+
+/// A routing table entry.
+struct Route {
+    unsigned prefix;
+    unsigned mask;
+    unsigned next_hop;
+    unsigned metric;
+};
+
+/// Latencies of the reads of every reader, in nanoseconds.
+struct Latencies {
+    std::vector<double> ns;
+
+    void report( const char * name ) const{
+        std::vector<double> sorted( ns );
+        std::sort( sorted.begin(), sorted.end() );
+        auto at = [&]( double q ){ return sorted[std::size_t( q * ( sorted.size() - 1 ) )] / 1e3; };
+        std::cout << std::setw( 22 ) << name
+                  << std::setw( 12 ) << sorted.size()
+                  << std::setw( 12 ) << at( 0.5 )
+                  << std::setw( 12 ) << at( 0.99 )
+                  << std::setw( 12 ) << at( 0.999 )
+                  << std::setw( 12 ) << sorted.back() / 1e3 << "\n";
+    }
+};
+
+/// Runs 'readers' threads calling 'read()' (which returns a checksum) while one writer calls 'write()' every millisecond.
+template < typename Read, typename Write >
+Latencies measure( std::size_t readers, int writes, Read read, Write write ){
+    using clock = std::chrono::steady_clock;
+    std::atomic<bool> done{false};
+    std::vector<std::vector<double>> per_reader( readers );
+    std::vector<std::thread> threads;
+    for( std::size_t r{0} ; r < readers ; ++r ){
+        threads.emplace_back( [&, r](){
+            while( !done.load( std::memory_order_relaxed ) ){
+                auto start = clock::now();
+                bench::do_not_optimize( read() );
+                per_reader[r].push_back( std::chrono::duration<double, std::nano>( clock::now() - start ).count() );
+            }
+        } );
+    }
+    for( int w{0} ; w < writes ; ++w ){
+        write( w );
+        std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+    }
+    done = true;
+    Latencies result;
+    for( std::size_t r{0} ; r < readers ; ++r ){
+        threads[r].join();
+        result.ns.insert( result.ns.end(), per_reader[r].begin(), per_reader[r].end() );
+    }
+    return result;
+}
+
+int main( int argc, char * argv[] )
+{
+    // Usage: bench_rcu_vector [routes] [readers]
+    const std::size_t n = argc > 1 ? std::strtoull( argv[1], nullptr, 10 ) : 4096;
+    const std::size_t readers = argc > 2 ? std::strtoull( argv[2], nullptr, 10 ) : 8;
+    const int writes{200};
+
+    sc::vector<Route> initial;
+    for( std::size_t i{0} ; i < n ; ++i ){
+        initial.push_back( Route{ unsigned( i ) << 8, 0xffffff00u, unsigned( i % 16 ), 1 } );
+    }
+
+    std::cout << readers << " readers scanning " << n << " routes while a writer updates every ms (us per scan).\n\n";
+    std::cout << std::setw( 22 ) << ""
+              << std::setw( 12 ) << "scans"
+              << std::setw( 12 ) << "p50"
+              << std::setw( 12 ) << "p99"
+              << std::setw( 12 ) << "p99.9"
+              << std::setw( 12 ) << "max" << "\n";
+    std::cout << std::fixed << std::setprecision( 2 );
+
+    auto scan = []( const sc::vector<Route> & table ){
+        unsigned hops{0};
+        for( const auto & r : table ){
+            hops += r.next_hop * r.metric;
+        }
+        return hops;
+    };
+
+    {
+        sc::vector<Route> table( initial );
+        std::mutex m;
+        Latencies l = measure( readers, writes,
+            [&](){ std::lock_guard<std::mutex> lock{ m }; return scan( table ); },
+            [&]( int w ){
+                std::lock_guard<std::mutex> lock{ m };
+                for( std::size_t i = std::size_t( w ) ; i < table.size() ; i += 64 ){
+                    table[i].metric = unsigned( w );
+                }
+            } );
+        l.report( "mutex + sc::vector" );
+    }
+    {
+        sc::rcu_vector<Route> table{ initial };
+        Latencies l = measure( readers, writes,
+            [&](){ auto snap = table.read(); return scan( *snap ); },
+            [&]( int w ){
+                table.update( [w]( sc::vector<Route> & next ){
+                    for( std::size_t i = std::size_t( w ) ; i < next.size() ; i += 64 ){
+                        next[i].metric = unsigned( w );
+                    }
+                } );
+            } );
+        l.report( "sc::rcu_vector" );
+    }
+
+    return 0;
+}
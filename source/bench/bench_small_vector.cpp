@@ -0,0 +1,46 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+#include "bench.h"
+#include "vector.h"
+#include "small_vector.h"
+
+/// Builds a container with 'n' elements by push_back, reads it back and lets it die.
+template < typename Container >
+double fill_and_destroy( std::size_t n, std::size_t reps ){
+    return bench::ns_per_run( reps, [n](){
+        Container c;
+        for( std::size_t i{0} ; i < n ; ++i ){
+            c.push_back( static_cast<int>( i ) );
+        }
+        long sum{0};
+        for( std::size_t i{0} ; i < c.size() ; ++i ){
+            sum += c[i];
+        }
+        bench::do_not_optimize( sum );
+    } );
+}
+
+int main( void )
+{
+    const std::size_t reps{200000};
+    const std::size_t sizes[]{ 0, 1, 2, 4, 6, 8, 12, 16, 24, 32, 48, 64 };
+
+    std::cout << "Build, read and destroy a container of n ints (ns per container).\n\n";
+    std::cout << std::setw( 4 ) << "n"
+              << std::setw( 14 ) << "sc::vector"
+              << std::setw( 18 ) << "small_vector<8>"
+              << std::setw( 19 ) << "small_vector<16>"
+              << std::setw( 19 ) << "small_vector<64>" << "\n";
+    std::cout << std::fixed << std::setprecision( 1 );
+    for( auto n : sizes ){
+        std::cout << std::setw( 4 ) << n
+                  << std::setw( 14 ) << fill_and_destroy< sc::vector<int> >( n, reps )
+                  << std::setw( 18 ) << fill_and_destroy< sc::small_vector<int, 8> >( n, reps )
+                  << std::setw( 19 ) << fill_and_destroy< sc::small_vector<int, 16> >( n, reps )
+                  << std::setw( 19 ) << fill_and_destroy< sc::small_vector<int, 64> >( n, reps ) << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,64 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+
+#include "bench.h"
+#include "vector.h"
+#include "snapshot.h"
+
+int main( int argc, char * argv[] )
+{
+    const std::size_t n = argc > 1 ? std::strtoull( argv[1], nullptr, 10 ) : 4000000;
+    const std::string text_path = "/tmp/bench_snapshot.txt";
+    const std::string snap_path = "/tmp/bench_snapshot.bin";
+
+    sc::vector<double> v;
+    for( std::size_t i{0} ; i < n ; ++i ){
+        v.push_back( double( i ) * 0.25 );
+    }
+
+    std::cout << "Persisting " << n << " doubles, in ms.\n\n";
+    std::cout << std::setw( 34 ) << "save" << std::setw( 16 ) << "reload" << "\n";
+    std::cout << std::fixed << std::setprecision( 3 );
+
+    double text_save = bench::ns_per_run( 3, [&](){
+        std::ofstream out{ text_path };
+        for( double x : v ){
+            out << x << '\n';
+        }
+    } );
+    double text_load = bench::ns_per_run( 3, [&](){
+        std::ifstream in{ text_path };
+        sc::vector<double> r;
+        double x;
+        while( in >> x ){
+            r.push_back( x );
+        }
+        bench::do_not_optimize( r.size() );
+    } );
+    std::cout << std::setw( 18 ) << "text" << std::setw( 16 ) << text_save / 1e6
+              << std::setw( 16 ) << text_load / 1e6 << "\n";
+
+    double snap_save = bench::ns_per_run( 3, [&](){
+        sc::save( v, snap_path );
+    } );
+    double snap_load = bench::ns_per_run( 3, [&](){
+        sc::vector<double> r = sc::load<double>( snap_path );
+        bench::do_not_optimize( r.size() );
+    } );
+    double snap_view = bench::ns_per_run( 3, [&](){
+        sc::snapshot_view<double> r = sc::load_view<double>( snap_path );
+        bench::do_not_optimize( r.size() );
+    } );
+    std::cout << std::setw( 18 ) << "sc::load" << std::setw( 16 ) << snap_save / 1e6
+              << std::setw( 16 ) << snap_load / 1e6 << "\n";
+    std::cout << std::setw( 18 ) << "sc::load_view" << std::setw( 16 ) << snap_save / 1e6
+              << std::setw( 16 ) << snap_view / 1e6 << "\n";
+
+    std::remove( text_path.c_str() );
+    std::remove( snap_path.c_str() );
+    return 0;
+}
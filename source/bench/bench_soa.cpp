@@ -0,0 +1,57 @@
+#include <iostream>
+#include <iomanip>
+
+#include "bench.h"
+#include "vector.h"
+#include "soa_vector.h"
+
+/// A twelve-field record, of which the hot loop reads two.
+struct Particle {
+    double x, y, z;
+    double vx, vy, vz;
+    double mass, charge;
+    long long id, flags, cell, owner;
+};
+
+int main( void )
+{
+    const std::size_t n{4000000};
+
+    sc::vector<Particle> aos;
+    aos.reserve( n );
+    sc::soa_vector<double, double, double, double, double, double, double, double,
+                   long long, long long, long long, long long> soa;
+    soa.reserve( n );
+    for( std::size_t i{0} ; i < n ; ++i ){
+        double v = double( i % 1000 ) * 0.001;
+        long long id = static_cast<long long>( i );
+        aos.push_back( Particle{ v, v, v, v, v, v, 1.0 + v, v, id, 0, 0, 0 } );
+        soa.emplace_back( v, v, v, v, v, v, 1.0 + v, v, id, 0LL, 0LL, 0LL );
+    }
+
+    std::cout << "Kinetic energy of " << n << " particles, reading 2 of 12 fields (ms).\n\n";
+    std::cout << std::setw( 26 ) << "sc::vector<Particle>"
+              << std::setw( 26 ) << "sc::soa_vector<...>" << "\n";
+    std::cout << std::fixed << std::setprecision( 2 );
+
+    double aos_ns = bench::ns_per_run( 10, [&](){
+        double e{0};
+        for( std::size_t i{0} ; i < n ; ++i ){
+            e += 0.5 * aos[i].mass * aos[i].vx * aos[i].vx;
+        }
+        bench::do_not_optimize( e );
+    } );
+    double soa_ns = bench::ns_per_run( 10, [&](){
+        const double * mass = soa.data<6>();
+        const double * vx = soa.data<3>();
+        double e{0};
+        for( std::size_t i{0} ; i < n ; ++i ){
+            e += 0.5 * mass[i] * vx[i] * vx[i];
+        }
+        bench::do_not_optimize( e );
+    } );
+    std::cout << std::setw( 26 ) << aos_ns / 1e6
+              << std::setw( 26 ) << soa_ns / 1e6 << "\n";
+
+    return 0;
+}
@@ -0,0 +1,46 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+#include "bench.h"
+#include "vector.h"
+#include "stable_vector.h"
+
+/// A record big enough for a reallocation to hurt.
+struct Record {
+    double values[8];
+};
+
+/// Appends 'n' records, returning the slowest single push_back in microseconds.
+template < typename Container >
+double worst_push_back( std::size_t n )
+{
+    using clock = std::chrono::steady_clock;
+    Container c;
+    double worst{0};
+    for( std::size_t i{0} ; i < n ; ++i ){
+        auto start = clock::now();
+        c.push_back( Record{ { double( i ) } } );
+        double us = std::chrono::duration<double, std::micro>( clock::now() - start ).count();
+        worst = us > worst ? us : worst;
+    }
+    bench::do_not_optimize( c[n / 2] );
+    return worst;
+}
+
+int main( void )
+{
+    std::cout << "Slowest single push_back of a 64-byte record (us).\n\n";
+    std::cout << std::setw( 12 ) << "n"
+              << std::setw( 24 ) << "sc::vector"
+              << std::setw( 24 ) << "sc::stable_vector" << "\n";
+    std::cout << std::fixed << std::setprecision( 1 );
+
+    for( std::size_t n : { std::size_t( 100000 ), std::size_t( 1000000 ), std::size_t( 8000000 ) } ){
+        std::cout << std::setw( 12 ) << n
+                  << std::setw( 24 ) << worst_push_back< sc::vector<Record> >( n )
+                  << std::setw( 24 ) << worst_push_back< sc::stable_vector<Record> >( n ) << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,486 @@
+#ifndef _ALLOCATOR_H_
+#define _ALLOCATOR_H_
+
+#include <cstddef>      // std::size_t, std::max_align_t
+#include <cstdint>      // std::uintptr_t
+#include <new>          // ::operator new, ::operator delete, std::bad_alloc
+#include <cstdlib>      // std::malloc, std::realloc, std::free
+
+/// Sequence container namespace.
+namespace sc {
+    /// Monotonic (bump pointer) memory resource.
+    /*!
+     * Memory is carved from large chunks by advancing a pointer; releasing a
+     * single block does nothing. All chunks are returned at once by release()
+     * or by the destructor, which makes it a good fit for short-lived
+     * containers that die together (e.g. everything built while serving one
+     * request).
+     */
+    class arena
+    {
+        public:
+            /**
+             * @brief Construct a new arena object.
+             *
+             * @param chunkSize Size in bytes of each chunk requested from the system.
+             */
+            explicit arena( std::size_t chunkSize = 64 * 1024 )
+                : m_chunk_size{chunkSize}
+            { /* empty */ }
+
+            arena( const arena & ) = delete;
+            arena & operator=( const arena & ) = delete;
+
+            /**
+             * @brief Destroy the arena object, returning every chunk to the system.
+             *
+             */
+            ~arena( void ){
+                release();
+            }
+
+            /**
+             * @brief Returns 'bytes' bytes aligned to 'alignment' from the current chunk, opening a new one if needed.
+             *
+             * @param bytes Number of bytes requested.
+             * @param alignment Required alignment, a power of two.
+             * @return void* The memory block.
+             */
+            void * allocate( std::size_t bytes, std::size_t alignment ){
+                std::size_t offset = AlignedOffset( alignment );
+                if( m_head == nullptr || offset + bytes > m_head->size ){
+                    // Oversized requests get a chunk of their own.
+                    std::size_t need = bytes + alignment;
+                    NewChunk( need > m_chunk_size ? need : m_chunk_size );
+                    offset = AlignedOffset( alignment );
+                }
+                m_used = offset + bytes;
+                m_allocated += bytes;
+                return Payload( m_head ) + offset;
+            }
+
+            /**
+             * @brief Individual blocks are never reclaimed; the memory comes back on release().
+             *
+             */
+            void deallocate( void *, std::size_t ){ /* empty */ }
+
+            /**
+             * @brief Returns all chunks to the system. Every block handed out becomes invalid.
+             *
+             */
+            void release( void ){
+                while( m_head != nullptr ){
+                    Chunk * next = m_head->next;
+                    ::operator delete( m_head );
+                    m_head = next;
+                }
+                m_used = 0;
+                m_allocated = 0;
+            }
+
+            /**
+             * @brief Return the number of bytes handed out since the last release().
+             *
+             * @return std::size_t
+             */
+            std::size_t bytes_allocated( void ) const{
+                return m_allocated;
+            }
+
+        private:
+            /// Header placed at the start of each chunk.
+            struct Chunk {
+                Chunk * next;      //!< The previously opened chunk.
+                std::size_t size;  //!< Usable bytes after the header.
+            };
+
+            /// First usable byte of a chunk, kept at the strictest fundamental alignment.
+            static char * Payload( Chunk * c ){
+                return reinterpret_cast<char *>( c ) + AlignUp( sizeof( Chunk ), alignof( std::max_align_t ) );
+            }
+
+            /// Rounds 'n' up to a multiple of 'alignment'.
+            static std::size_t AlignUp( std::size_t n, std::size_t alignment ){
+                return ( n + alignment - 1 ) & ~( alignment - 1 );
+            }
+
+            /// First offset, not below m_used, whose address in the current chunk is aligned to 'alignment'.
+            /*!
+             * The payload itself is only max_align_t aligned, so stricter alignments
+             * (over-aligned SIMD types) are taken on the absolute address.
+             */
+            std::size_t AlignedOffset( std::size_t alignment ) const{
+                if( m_head == nullptr ){
+                    return 0;
+                }
+                std::uintptr_t at = reinterpret_cast<std::uintptr_t>( Payload( m_head ) ) + m_used;
+                return m_used + ( AlignUp( at, alignment ) - at );
+            }
+
+            /// Opens a chunk with at least 'bytes' usable bytes and makes it current.
+            void NewChunk( std::size_t bytes ){
+                std::size_t header = AlignUp( sizeof( Chunk ), alignof( std::max_align_t ) );
+                Chunk * c = static_cast<Chunk *>( ::operator new( header + bytes ) );
+                c->next = m_head;
+                c->size = bytes;
+                m_head = c;
+                m_used = 0;
+            }
+
+            std::size_t m_chunk_size;       //!< Default chunk size.
+            Chunk * m_head = nullptr;       //!< The chunk we are carving from.
+            std::size_t m_used = 0;         //!< Bytes already used in the current chunk.
+            std::size_t m_allocated = 0;    //!< Bytes handed out, for tracking.
+    };
+
+    /// Allocator that draws its memory from an sc::arena.
+    /*!
+     * Copies share the same arena, and two allocators compare equal when they
+     * do. The allocator is not propagated on assignment or swap, so a
+     * container keeps drawing from the arena it was built with.
+     *
+     * \tparam T The type of the elements.
+     */
+    template < typename T >
+    class arena_allocator
+    {
+        public:
+            using value_type = T;   //!< The value type.
+
+            /**
+             * @brief Construct a new arena_allocator object bound to 'a'.
+             *
+             * @param a The arena that will supply the memory. It must outlive the allocator.
+             */
+            arena_allocator( arena & a ) noexcept
+                : m_arena{&a}
+            { /* empty */ }
+
+            /**
+             * @brief Construct a new arena_allocator object that shares the arena of an allocator of another type.
+             *
+             * @param other The allocator to rebind from.
+             */
+            template < typename U >
+            arena_allocator( const arena_allocator<U> & other ) noexcept
+                : m_arena{other.resource()}
+            { /* empty */ }
+
+            /**
+             * @brief Allocates memory for 'n' objects of type T.
+             *
+             * @param n Number of objects.
+             * @return T* The uninitialized block.
+             */
+            T * allocate( std::size_t n ){
+                return static_cast<T *>( m_arena->allocate( n * sizeof( T ), alignof( T ) ) );
+            }
+
+            /**
+             * @brief Hands a block back to the arena (which ignores it).
+             *
+             * @param p The block.
+             * @param n Number of objects it was allocated for.
+             */
+            void deallocate( T * p, std::size_t n ) noexcept{
+                m_arena->deallocate( p, n * sizeof( T ) );
+            }
+
+            /**
+             * @brief Return the arena behind this allocator.
+             *
+             * @return arena*
+             */
+            arena * resource( void ) const noexcept{
+                return m_arena;
+            }
+
+        private:
+            arena * m_arena; //!< The memory source.
+    };
+
+    template < typename T, typename U >
+    bool operator==( const arena_allocator<T> & lhs, const arena_allocator<U> & rhs ){
+        return lhs.resource() == rhs.resource();
+    }
+
+    template < typename T, typename U >
+    bool operator!=( const arena_allocator<T> & lhs, const arena_allocator<U> & rhs ){
+        return !( lhs == rhs );
+    }
+
+    /// Pool of equally sized blocks.
+    /*!
+     * The pool reserves 'blockCount' blocks of 'blockSize' bytes up front and
+     * keeps the free ones in an intrusive singly linked list, so allocation and
+     * deallocation are a couple of pointer moves. Requests that do not fit in a
+     * block, or that arrive when the pool is exhausted, are forwarded to the
+     * global operator new.
+     */
+    class fixed_pool
+    {
+        public:
+            /**
+             * @brief Construct a new fixed_pool object.
+             *
+             * @param blockSize Size in bytes of each block.
+             * @param blockCount Number of blocks in the pool.
+             */
+            fixed_pool( std::size_t blockSize, std::size_t blockCount )
+                : m_block_size{ AlignUp( blockSize < sizeof( Node ) ? sizeof( Node ) : blockSize ) }, m_block_count{blockCount}
+            {
+                m_begin = static_cast<char *>( ::operator new( m_block_size * m_block_count ) );
+                for( std::size_t i{m_block_count} ; i > 0 ; --i ){
+                    Node * n = reinterpret_cast<Node *>( m_begin + ( i - 1 ) * m_block_size );
+                    n->next = m_free;
+                    m_free = n;
+                }
+            }
+
+            fixed_pool( const fixed_pool & ) = delete;
+            fixed_pool & operator=( const fixed_pool & ) = delete;
+
+            /**
+             * @brief Destroy the fixed_pool object. Blocks still in use become invalid.
+             *
+             */
+            ~fixed_pool( void ){
+                ::operator delete( m_begin );
+            }
+
+            /**
+             * @brief Returns a block able to hold 'bytes' bytes.
+             *
+             * @param bytes Number of bytes requested.
+             * @return void* The memory block.
+             */
+            void * allocate( std::size_t bytes ){
+                if( bytes > m_block_size || m_free == nullptr ){
+                    return ::operator new( bytes );
+                }
+                Node * n = m_free;
+                m_free = n->next;
+                ++m_in_use;
+                return n;
+            }
+
+            /**
+             * @brief Gives back a block obtained from allocate().
+             *
+             * @param p The block.
+             */
+            void deallocate( void * p ){
+                if( !owns( p ) ){
+                    ::operator delete( p );
+                    return;
+                }
+                Node * n = static_cast<Node *>( p );
+                n->next = m_free;
+                m_free = n;
+                --m_in_use;
+            }
+
+            /**
+             * @brief Check whether 'p' points into the pool's own blocks.
+             *
+             * @param p A pointer.
+             * @return true If it belongs to the pool.
+             * @return false Otherwise.
+             */
+            bool owns( const void * p ) const{
+                const char * c = static_cast<const char *>( p );
+                return c >= m_begin && c < m_begin + m_block_size * m_block_count;
+            }
+
+            /**
+             * @brief Return the size of each block.
+             *
+             * @return std::size_t
+             */
+            std::size_t block_size( void ) const{
+                return m_block_size;
+            }
+
+            /**
+             * @brief Return the number of blocks currently handed out.
+             *
+             * @return std::size_t
+             */
+            std::size_t in_use( void ) const{
+                return m_in_use;
+            }
+
+        private:
+            /// A free block, reused as a list node.
+            struct Node {
+                Node * next; //!< Next free block.
+            };
+
+            /// Rounds 'n' up to a multiple of the strictest fundamental alignment.
+            static std::size_t AlignUp( std::size_t n ){
+                return ( n + alignof( std::max_align_t ) - 1 ) & ~( alignof( std::max_align_t ) - 1 );
+            }
+
+            std::size_t m_block_size;   //!< Size of each block.
+            std::size_t m_block_count;  //!< Number of blocks.
+            char * m_begin = nullptr;   //!< The pool's memory.
+            Node * m_free = nullptr;    //!< Head of the free list.
+            std::size_t m_in_use = 0;   //!< Blocks handed out.
+    };
+
+    /// Allocator that draws its memory from an sc::fixed_pool.
+    /*!
+     * Copies share the same pool, and two allocators compare equal when they do.
+     *
+     * \tparam T The type of the elements.
+     */
+    template < typename T >
+    class pool_allocator
+    {
+        public:
+            using value_type = T;   //!< The value type.
+
+            /**
+             * @brief Construct a new pool_allocator object bound to 'p'.
+             *
+             * @param p The pool that will supply the memory. It must outlive the allocator.
+             */
+            pool_allocator( fixed_pool & p ) noexcept
+                : m_pool{&p}
+            { /* empty */ }
+
+            /**
+             * @brief Construct a new pool_allocator object that shares the pool of an allocator of another type.
+             *
+             * @param other The allocator to rebind from.
+             */
+            template < typename U >
+            pool_allocator( const pool_allocator<U> & other ) noexcept
+                : m_pool{other.resource()}
+            { /* empty */ }
+
+            /**
+             * @brief Allocates memory for 'n' objects of type T.
+             *
+             * @param n Number of objects.
+             * @return T* The uninitialized block.
+             */
+            T * allocate( std::size_t n ){
+                return static_cast<T *>( m_pool->allocate( n * sizeof( T ) ) );
+            }
+
+            /**
+             * @brief Returns a block to the pool.
+             *
+             * @param p The block.
+             */
+            void deallocate( T * p, std::size_t ) noexcept{
+                m_pool->deallocate( p );
+            }
+
+            /**
+             * @brief Return the pool behind this allocator.
+             *
+             * @return fixed_pool*
+             */
+            fixed_pool * resource( void ) const noexcept{
+                return m_pool;
+            }
+
+        private:
+            fixed_pool * m_pool; //!< The memory source.
+    };
+
+    template < typename T, typename U >
+    bool operator==( const pool_allocator<T> & lhs, const pool_allocator<U> & rhs ){
+        return lhs.resource() == rhs.resource();
+    }
+
+    template < typename T, typename U >
+    bool operator!=( const pool_allocator<T> & lhs, const pool_allocator<U> & rhs ){
+        return !( lhs == rhs );
+    }
+
+    /// Allocator backed by malloc(), able to resize a block with realloc().
+    /*!
+     * sc::vector detects the reallocate() member and, for trivially
+     * relocatable elements, grows its buffer through it instead of
+     * allocating a new block and copying. The C library can then extend the
+     * block in place; for large blocks glibc keeps them in their own mapping
+     * and resizes it with mremap(), so the pages are remapped rather than
+     * copied, however large the buffer is.
+     *
+     * All instances are interchangeable and compare equal.
+     *
+     * \tparam T The type of the elements.
+     */
+    template < typename T >
+    class malloc_allocator
+    {
+        public:
+            using value_type = T;   //!< The value type.
+
+            malloc_allocator( void ) noexcept = default;
+
+            /**
+             * @brief Construct a new malloc_allocator object from one of another type.
+             *
+             */
+            template < typename U >
+            malloc_allocator( const malloc_allocator<U> & ) noexcept
+            { /* empty */ }
+
+            /**
+             * @brief Allocates memory for 'n' objects of type T.
+             *
+             * @param n Number of objects.
+             * @return T* The uninitialized block.
+             */
+            T * allocate( std::size_t n ){
+                void * p = std::malloc( n * sizeof( T ) );
+                if( p == nullptr ){
+                    throw std::bad_alloc();
+                }
+                return static_cast<T *>( p );
+            }
+
+            /**
+             * @brief Resizes a block obtained from allocate(), possibly moving it. The contents up
+             * to the smaller of both sizes are carried over byte by byte, as by memcpy.
+             * On failure the original block is left untouched.
+             *
+             * @param p The block.
+             * @param n Number of objects it was allocated for.
+             * @param newN Number of objects it must hold.
+             * @return T* The resized block.
+             */
+            T * reallocate( T * p, std::size_t, std::size_t newN ){
+                void * q = std::realloc( static_cast<void *>( p ), newN * sizeof( T ) );
+                if( q == nullptr ){
+                    throw std::bad_alloc();
+                }
+                return static_cast<T *>( q );
+            }
+
+            /**
+             * @brief Returns a block to the C library.
+             *
+             * @param p The block.
+             */
+            void deallocate( T * p, std::size_t ) noexcept{
+                std::free( p );
+            }
+    };
+
+    template < typename T, typename U >
+    bool operator==( const malloc_allocator<T> &, const malloc_allocator<U> & ){
+        return true;
+    }
+
+    template < typename T, typename U >
+    bool operator!=( const malloc_allocator<T> &, const malloc_allocator<U> & ){
+        return false;
+    }
+} // namespace sc.
+#endif
@@ -0,0 +1,465 @@
+#ifndef _CONCURRENT_VECTOR_H_
+#define _CONCURRENT_VECTOR_H_
+
+#include <atomic>       // std::atomic
+#include <cstddef>      // std::size_t, std::ptrdiff_t, std::max_align_t
+#include <cstdlib>      // std::calloc, std::free
+#include <new>          // std::bad_alloc
+#include <stdexcept>    // std::out_of_range, std::length_error
+#include <type_traits>  // std::is_nothrow_destructible
+#include <utility>      // std::forward
+
+#include "stable_vector.h"
+
+/// Sequence container namespace.
+namespace sc {
+    /// An append-only vector that many threads can grow and read at once without locks.
+    /*!
+     * The storage is laid out like stable_vector's: segment k holds
+     * FirstSegment << k elements and elements never move, so a thread
+     * growing the vector can not invalidate what another one is reading.
+     *
+     * push_back(), emplace_back() and grow_by() claim their slots with one
+     * fetch_add on a counter. The thread whose slots fall in a segment that
+     * does not exist yet allocates it and installs it with a compare and
+     * swap; if another thread won, it frees its own block, which was never
+     * touched (segments come zeroed from calloc). No thread ever waits for
+     * another.
+     *
+     * size() counts the published elements, a prefix of the slots. A
+     * thread that finishes the slots at the front of the unpublished ones
+     * moves size() past them with a compare and swap, and then over the
+     * slots other threads finished meanwhile. Those threads, finding they
+     * were not at the front, set a ready flag on each of their slots
+     * instead, and leave them for whoever catches up. Every index below size() can be read with a table
+     * lookup and no synchronization, which makes operator[] wait-free.
+     *
+     * If building an element throws, the exception reaches the caller and
+     * the slot is flagged dead: it is published like a ready one, so size()
+     * keeps growing past it, but it holds no element and is never
+     * destroyed. is_dead() tells such slots apart; the copies skip them.
+     * If the segment of a slot can not be allocated, the claim is handed
+     * back, unless other threads have claimed past it meanwhile without
+     * allocating the segment either, and then size() stops there. clear(),
+     * the destructor and the assignment operators need the vector to
+     * themselves.
+     *
+     * \tparam T The type of the elements.
+     * \tparam FirstSegment Number of elements in the first segment, a power of two.
+     */
+    template < typename T, std::size_t FirstSegment = 64 >
+    class concurrent_vector
+    {
+        static_assert( FirstSegment > 0 && ( FirstSegment & ( FirstSegment - 1 ) ) == 0,
+                       "sc::concurrent_vector needs a power of two first segment" );
+        static_assert( alignof( T ) <= alignof( std::max_align_t ),
+                       "sc::concurrent_vector can not align segments past max_align_t" );
+
+        using flag_type = std::atomic<unsigned char>;
+
+        //=== Aliases
+        public:
+            using size_type = std::size_t;                  //!< The size type.
+            using difference_type = std::ptrdiff_t;         //!< The difference type.
+            using value_type = T;                           //!< The value type.
+            using pointer = T *;                            //!< Pointer to a value stored in the container.
+            using const_pointer = const T *;                //!< Pointer to a const value stored in the container.
+            using reference = T &;                          //!< Reference to a value stored in the container.
+            using const_reference = const T &;              //!< Const reference to a value stored in the container.
+            using iterator = stable_iterator< concurrent_vector, false >;      //!< The iterator.
+            using const_iterator = stable_iterator< concurrent_vector, true >; //!< The const iterator.
+
+            static const size_type max_segments = sizeof( size_type ) * 8; //!< Size of the block table.
+
+        public:
+            //=== [I] SPECIAL MEMBERS
+
+            /// Construct a new empty concurrent_vector object.
+            concurrent_vector( void ){
+                for( auto & segment : m_table ){
+                    segment.store( nullptr, std::memory_order_relaxed );
+                }
+            }
+
+            /**
+             * @brief Construct a new concurrent_vector object with a copy of the published elements of 'other'.
+             *
+             * @param other Another concurrent_vector object of the same type.
+             */
+            concurrent_vector( const concurrent_vector & other )
+                : concurrent_vector()
+            {
+                // The delegating constructor has finished, so the destructor cleans up if this throws.
+                CopyFrom( other );
+            }
+
+            /**
+             * @brief Copies the published elements of 'rhs'.
+             *
+             * @param rhs A concurrent_vector object of the same type.
+             * @return concurrent_vector& always returns *this enabling things like a = b = c.
+             */
+            concurrent_vector & operator=( const concurrent_vector & rhs ){
+                if( this != &rhs ){
+                    clear();
+                    CopyFrom( rhs );
+                }
+                return *this;
+            }
+
+            /**
+             * @brief Destroy the concurrent_vector object.
+             *
+             */
+            ~concurrent_vector( void ){
+                Release();
+            }
+
+            //=== [II] ITERATORS
+
+            iterator begin( void ){ return iterator( this, 0 ); }
+            iterator end( void ){ return iterator( this, size() ); }
+            const_iterator begin( void ) const{ return const_iterator( this, 0 ); }
+            const_iterator end( void ) const{ return const_iterator( this, size() ); }
+            const_iterator cbegin( void ) const{ return begin(); }
+            const_iterator cend( void ) const{ return end(); }
+
+            //=== [III] CAPACITY
+
+            /// Return the number of published elements: every one below it can be read.
+            size_type size( void ) const{ return m_size.load( std::memory_order_acquire ); }
+            /// Check whether no element has been published.
+            bool empty( void ) const{ return size() == 0; }
+            /// Return how many elements fit in the segments allocated without a gap.
+            size_type capacity( void ) const{
+                size_type k{0};
+                while( k < max_segments && m_table[k].load( std::memory_order_acquire ) != nullptr ){
+                    ++k;
+                }
+                return SegmentStart( k );
+            }
+
+            /**
+             * @brief Allocates segments until at least 'n' elements fit. Safe to call while other threads push.
+             *
+             * @param n Number of elements.
+             */
+            void reserve( size_type n ){
+                if( n > 0 ){
+                    EnsureSegments( 0, SegmentOf( n - 1 ) );
+                }
+            }
+
+            //=== [IV] MODIFIERS
+
+            /// Appends a copy of 'value', returning its index.
+            size_type push_back( const_reference value ){ return emplace_back( value ); }
+            /// Appends 'value', moving it, and returns its index.
+            size_type push_back( T && value ){ return emplace_back( std::move( value ) ); }
+
+            /**
+             * @brief Appends an element built from 'args' and returns its index.
+             *
+             * @param args Arguments forwarded to the element's constructor.
+             * @return size_type Index of the new element.
+             */
+            template < typename... Args >
+            size_type emplace_back( Args&&... args ){
+                size_type index = m_claimed.fetch_add( 1, std::memory_order_relaxed );
+                size_type k = SegmentOf( index );
+                try{
+                    EnsureSegments( k, k );
+                }catch(...){
+                    Abandon( index, index + 1 );
+                    throw;
+                }
+                try{
+                    ::new( static_cast<void *>( Slot( index ) ) ) T( std::forward<Args>( args )... );
+                }catch(...){
+                    Bury( index, index + 1 );
+                    throw;
+                }
+                Finish( index, index + 1 );
+                return index;
+            }
+
+            /**
+             * @brief Appends 'n' value-initialized elements in one claim and returns the index of the first.
+             *
+             * @param n Number of elements.
+             * @return size_type Index of the first new element.
+             */
+            size_type grow_by( size_type n ){
+                return GrowBy( n, [this]( size_type i ){ ::new( static_cast<void *>( Slot( i ) ) ) T(); } );
+            }
+
+            /**
+             * @brief Appends 'n' copies of 'value' in one claim and returns the index of the first.
+             *
+             * @param n Number of elements.
+             * @param value Value copied into the new elements.
+             * @return size_type Index of the first new element.
+             */
+            size_type grow_by( size_type n, const_reference value ){
+                return GrowBy( n, [this, &value]( size_type i ){ ::new( static_cast<void *>( Slot( i ) ) ) T( value ); } );
+            }
+
+            /// Destroys every element and releases the segments. No other thread may use the vector meanwhile.
+            void clear( void ){
+                Release();
+            }
+
+            //=== [V] ELEMENT ACCESS
+
+            /// Check whether published slot 'pos' belongs to a push that threw, and so holds no element.
+            bool is_dead( size_type pos ) const{
+                return Flag( pos ).load( std::memory_order_acquire ) == dead;
+            }
+
+            /// Element 'pos', which must be below size(), or returned by a push on this thread.
+            reference operator[]( size_type pos ){ return *Slot( pos ); }
+            /// Element 'pos', which must be below size(), or returned by a push on this thread.
+            const_reference operator[]( size_type pos ) const{ return *Slot( pos ); }
+
+            /**
+             * @brief Return the element at 'pos', which must have been published.
+             *
+             * @param pos Position of the element.
+             * @return reference
+             */
+            reference at( size_type pos ){
+                if( pos >= size() ){
+                    throw std::out_of_range{"Posição Acessada Fora do Range"};
+                }
+                return *Slot( pos );
+            }
+
+            /**
+             * @brief Return the element at 'pos', which must have been published.
+             *
+             * @param pos Position of the element.
+             * @return const_reference
+             */
+            const_reference at( size_type pos ) const{
+                if( pos >= size() ){
+                    throw std::out_of_range{"Posição Acessada Fora do Range"};
+                }
+                return *Slot( pos );
+            }
+
+            reference front( void ){
+                if( empty() ){
+                    throw std::length_error ("[concurrent_vector::front()]: vector vazio.");
+                }
+                return *Slot( 0 );
+            }
+            const_reference front( void ) const{
+                if( empty() ){
+                    throw std::length_error ("[concurrent_vector::front()]: vector vazio.");
+                }
+                return *Slot( 0 );
+            }
+
+            //=== [VI] SEGMENTS
+
+            /// Return the first element slot of segment 'k'.
+            pointer segment_data( size_type k ){ return Segment( k ); }
+            /// Return the first element slot of segment 'k'.
+            const_pointer segment_data( size_type k ) const{ return Segment( k ); }
+
+            /// Segment that holds element 'index'.
+            static size_type SegmentOf( size_type index ){
+                return HighestSetBit( index / FirstSegment + 1 );
+            }
+            /// Index of the first element of segment 'k'.
+            static size_type SegmentStart( size_type k ){
+                return FirstSegment * ( ( size_type( 1 ) << k ) - 1 );
+            }
+            /// Number of elements segment 'k' holds.
+            static size_type SegmentSize( size_type k ){
+                return FirstSegment << k;
+            }
+
+        private:
+            /// Claims 'n' slots at once and builds each with 'build'.
+            template < typename Build >
+            size_type GrowBy( size_type n, Build build ){
+                if( n == 0 ){
+                    return m_claimed.load( std::memory_order_relaxed );
+                }
+                size_type first = m_claimed.fetch_add( n, std::memory_order_relaxed );
+                try{
+                    EnsureSegments( SegmentOf( first ), SegmentOf( first + n - 1 ) );
+                }catch(...){
+                    Abandon( first, first + n );
+                    throw;
+                }
+                size_type i{first};
+                try{
+                    for( ; i < first + n ; ++i ){
+                        build( i );
+                    }
+                }catch(...){
+                    // The ones built get published and later destroyed; the rest are dead.
+                    Bury( i, first + n );
+                    Finish( first, i );
+                    throw;
+                }
+                Finish( first, first + n );
+                return first;
+            }
+
+            /// Publishes the slots [first, last), just built.
+            void Finish( size_type first, size_type last ){
+                if( first == last ){
+                    return;
+                }
+                // At the front of the unpublished slots, publishing is one compare and swap
+                // and the ready flags are never needed.
+                size_type expected = first;
+                if( !m_size.compare_exchange_strong( expected, last, std::memory_order_seq_cst ) ){
+                    for( size_type i{first} ; i < last ; ++i ){
+                        Flag( i ).store( built, std::memory_order_seq_cst );
+                    }
+                }
+                Publish();
+            }
+
+            /// Flags the slots [first, last), whose elements could not be built, dead and publishes them.
+            void Bury( size_type first, size_type last ){
+                for( size_type i{first} ; i < last ; ++i ){
+                    Flag( i ).store( dead, std::memory_order_seq_cst );
+                }
+                Publish();
+            }
+
+            /// Gives back the slots [first, last), whose segments could not be allocated.
+            void Abandon( size_type first, size_type last ){
+                size_type expected = last;
+                if( m_claimed.compare_exchange_strong( expected, first, std::memory_order_relaxed ) ){
+                    return;
+                }
+                // Later slots were claimed meanwhile. If their writers brought the segments
+                // along, the slots can be buried; if not, there is nowhere to flag them.
+                for( size_type k{SegmentOf( first )} ; k <= SegmentOf( last - 1 ) ; ++k ){
+                    if( m_table[k].load( std::memory_order_acquire ) == nullptr ){
+                        return;
+                    }
+                }
+                Bury( first, last );
+            }
+
+            /// Appends a copy of every published element of 'other' that is not dead.
+            void CopyFrom( const concurrent_vector & other ){
+                size_type count = other.size();
+                for( size_type i{0} ; i < count ; ++i ){
+                    if( !other.is_dead( i ) ){
+                        push_back( other[i] );
+                    }
+                }
+            }
+
+            /// Moves size() over every ready slot that follows it.
+            void Publish( void ){
+                size_type published = m_size.load( std::memory_order_seq_cst );
+                for( ;; ){
+                    size_type claimed = m_claimed.load( std::memory_order_relaxed );
+                    size_type end = published;
+                    while( end < claimed && Ready( end ) ){
+                        ++end;
+                    }
+                    if( end == published ){
+                        return;
+                    }
+                    // On failure 'published' is reloaded and the scan resumes from there.
+                    m_size.compare_exchange_weak( published, end, std::memory_order_seq_cst );
+                }
+            }
+
+            /// Makes sure segments 'first' through 'last' exist.
+            void EnsureSegments( size_type first, size_type last ){
+                for( size_type k{first} ; k <= last ; ++k ){
+                    if( m_table[k].load( std::memory_order_acquire ) != nullptr ){
+                        continue;
+                    }
+                    if( k >= max_segments - 1 ){
+                        throw std::length_error ("[concurrent_vector]: o número máximo de segmentos foi atingido.");
+                    }
+                    size_type count = SegmentSize( k );
+                    // The elements, then one ready flag per element. calloc hands out zeroed
+                    // memory, so clear flags cost nothing until they are used.
+                    void * block = std::calloc( count, sizeof( T ) + sizeof( flag_type ) );
+                    if( block == nullptr ){
+                        throw std::bad_alloc();
+                    }
+                    unsigned char * expected = nullptr;
+                    if( !m_table[k].compare_exchange_strong( expected, static_cast<unsigned char *>( block ),
+                                                             std::memory_order_acq_rel ) ){
+                        std::free( block );
+                    }
+                }
+            }
+
+            /// The block of segment 'k'.
+            pointer Segment( size_type k ) const{
+                return reinterpret_cast<pointer>( m_table[k].load( std::memory_order_acquire ) );
+            }
+
+            /// The slot of element 'index', whose segment must exist.
+            pointer Slot( size_type index ) const{
+                size_type k = SegmentOf( index );
+                return Segment( k ) + ( index - SegmentStart( k ) );
+            }
+
+            /// The ready flag of element 'index', whose segment must exist.
+            flag_type & Flag( size_type index ) const{
+                size_type k = SegmentOf( index );
+                unsigned char * block = m_table[k].load( std::memory_order_acquire );
+                flag_type * flags = reinterpret_cast<flag_type *>( block + SegmentSize( k ) * sizeof( T ) );
+                return flags[index - SegmentStart( k )];
+            }
+
+            /// Whether slot 'index' has been built or buried. False if its segment could not be allocated.
+            bool Ready( size_type index ) const{
+                if( m_table[SegmentOf( index )].load( std::memory_order_acquire ) == nullptr ){
+                    return false;
+                }
+                return Flag( index ).load( std::memory_order_seq_cst ) != 0;
+            }
+
+            /// Destroys the built elements and frees every segment.
+            void Release( void ){
+                size_type claimed = m_claimed.load( std::memory_order_acquire );
+                size_type published = m_size.load( std::memory_order_acquire );
+                for( size_type k{0} ; k < max_segments ; ++k ){
+                    unsigned char * block = m_table[k].load( std::memory_order_acquire );
+                    if( block == nullptr ){
+                        continue;
+                    }
+                    size_type start = SegmentStart( k );
+                    size_type end = claimed < start + SegmentSize( k ) ? claimed : start + SegmentSize( k );
+                    for( size_type i{start} ; i < end ; ++i ){
+                        unsigned char flag = Flag( i ).load( std::memory_order_relaxed );
+                        if( flag == built || ( i < published && flag != dead ) ){
+                            Slot( i )->~T();
+                        }
+                    }
+                    std::free( block );
+                    m_table[k].store( nullptr, std::memory_order_relaxed );
+                }
+                m_claimed.store( 0, std::memory_order_relaxed );
+                m_size.store( 0, std::memory_order_release );
+            }
+
+            static const unsigned char built = 1;   //!< Flag of a slot built off the front of the unpublished ones.
+            static const unsigned char dead = 2;    //!< Flag of a slot whose element threw while being built.
+
+            std::atomic<unsigned char *> m_table[max_segments];    //!< The block table: segment k holds FirstSegment << k elements.
+            std::atomic<size_type> m_claimed{0};                    //!< Slots handed out to writers.
+            std::atomic<size_type> m_size{0};                       //!< Slots published: built, and all the ones before them too.
+    };
+
+    template < typename T, std::size_t FirstSegment >
+    const std::size_t concurrent_vector< T, FirstSegment >::max_segments;
+} // namespace sc.
+#endif
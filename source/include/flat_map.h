@@ -0,0 +1,446 @@
+#ifndef _FLAT_MAP_H_
+#define _FLAT_MAP_H_
+
+#include <cstddef>      // std::size_t
+#include <algorithm>    // std::lower_bound, std::upper_bound
+#include <functional>   // std::less
+#include <initializer_list> // std::initializer_list
+#include <memory>       // std::allocator
+#include <stdexcept>    // std::out_of_range
+#include <tuple>        // std::forward_as_tuple
+#include <utility>      // std::pair, std::piecewise_construct, std::move, std::forward
+
+#include "vector.h"
+#include "flat_set.h"
+
+/// Sequence container namespace.
+namespace sc {
+    /// A sorted map with unique keys, stored as key/value pairs contiguous in an sc::vector.
+    /*!
+     * The same trade-offs as sc::flat_set apply: binary-search lookups over
+     * contiguous pairs, O(n) single insertions and erasures, and bulk
+     * insertion by appending, sorting and merging in one pass.
+     *
+     * The elements are std::pair<Key, T> rather than std::pair<const Key, T>,
+     * so that they can be shifted and sorted in place. Modifying a key through
+     * an iterator breaks the ordering and is not allowed.
+     *
+     * \tparam Key The type of the keys.
+     * \tparam T The type of the mapped values.
+     * \tparam Compare Strict weak ordering of the keys.
+     * \tparam Alloc Allocator of the underlying vector.
+     */
+    template < typename Key, typename T, typename Compare = std::less<Key>,
+               typename Alloc = std::allocator< std::pair<Key, T> > >
+    class flat_map
+    {
+        //=== Aliases
+        public:
+            using value_type = std::pair<Key, T>;                           //!< The value type.
+            using container_type = vector<value_type, Alloc>;               //!< The underlying sequence.
+            using key_type = Key;                                           //!< The key type.
+            using mapped_type = T;                                          //!< The mapped type.
+            using key_compare = Compare;                                    //!< The ordering of the keys.
+            using size_type = typename container_type::size_type;           //!< The size type.
+            using reference = value_type &;                                 //!< Reference to a value.
+            using const_reference = const value_type &;                     //!< Const reference to a value.
+            using iterator = typename container_type::iterator;             //!< Iterator.
+            using const_iterator = typename container_type::const_iterator; //!< Const iterator.
+            using reverse_iterator = typename container_type::reverse_iterator;             //!< Reverse iterator.
+            using const_reverse_iterator = typename container_type::const_reverse_iterator; //!< Const reverse iterator.
+
+            /// Orders the elements by their keys.
+            class value_compare
+            {
+                public:
+                    explicit value_compare( const Compare & comp ) : m_comp{comp} { /* empty */ }
+                    bool operator()( const value_type & lhs, const value_type & rhs ) const{ return m_comp( lhs.first, rhs.first ); }
+                    bool operator()( const value_type & lhs, const key_type & rhs ) const{ return m_comp( lhs.first, rhs ); }
+                    bool operator()( const key_type & lhs, const value_type & rhs ) const{ return m_comp( lhs, rhs.first ); }
+                private:
+                    Compare m_comp; //!< The ordering of the keys.
+            };
+
+        public:
+            //=== [I] SPECIAL MEMBERS
+
+            /**
+             * @brief Construct a new empty flat_map object.
+             *
+             * @param comp The ordering of the keys.
+             */
+            explicit flat_map( const Compare & comp = Compare() )
+                : m_comp{comp}
+            { /* empty */ }
+
+            /**
+             * @brief Construct a new flat_map object with the elements in the range [first, last).
+             * Of several elements with equivalent keys, the first one is kept.
+             *
+             * @tparam InputItr Input iterator type
+             * @param first Input iterator to the initial position in a range.
+             * @param last Input iterator to the final position in a range.
+             * @param comp The ordering of the keys.
+             */
+            template < typename InputItr >
+            flat_map( InputItr first, InputItr last, const Compare & comp = Compare() )
+                : m_comp{comp}
+            {
+                insert( first, last );
+            }
+
+            /**
+             * @brief Construct a new flat_map object with the elements in 'init'.
+             * Of several elements with equivalent keys, the first one is kept.
+             *
+             * @param init An initializer_list object.
+             * @param comp The ordering of the keys.
+             */
+            flat_map( std::initializer_list<value_type> init, const Compare & comp = Compare() )
+                : m_comp{comp}
+            {
+                insert( init.begin(), init.end() );
+            }
+
+            /**
+             * @brief Construct a new flat_map object that adopts 'seq' as is, without copying or sorting it.
+             *
+             * @param seq A sequence sorted by key and without equivalent keys.
+             * @param comp The ordering of the keys.
+             */
+            flat_map( sorted_unique_t, container_type seq, const Compare & comp = Compare() )
+                : m_seq{std::move( seq )}, m_comp{comp}
+            { /* empty */ }
+
+            /**
+             * @brief Replaces the contents with the elements in 'init'.
+             *
+             * @param init An initializer_list object.
+             * @return flat_map& always returns *this enabling things like a = b = c.
+             */
+            flat_map & operator=( std::initializer_list<value_type> init ){
+                m_seq.clear();
+                insert( init.begin(), init.end() );
+                return *this;
+            }
+
+            //=== [II] ITERATORS
+
+            /// Return an iterator to the element with the smallest key.
+            iterator begin( void ){ return m_seq.begin(); }
+            /// Return an iterator past the element with the largest key.
+            iterator end( void ){ return m_seq.end(); }
+            /// Return an iterator to the element with the smallest key.
+            const_iterator begin( void ) const{ return m_seq.begin(); }
+            /// Return an iterator past the element with the largest key.
+            const_iterator end( void ) const{ return m_seq.end(); }
+            /// Return an iterator to the element with the smallest key.
+            const_iterator cbegin( void ) const{ return m_seq.cbegin(); }
+            /// Return an iterator past the element with the largest key.
+            const_iterator cend( void ) const{ return m_seq.cend(); }
+            /// Return a reverse iterator to the element with the largest key.
+            reverse_iterator rbegin( void ){ return m_seq.rbegin(); }
+            /// Return a reverse iterator before the element with the smallest key.
+            reverse_iterator rend( void ){ return m_seq.rend(); }
+            /// Return a reverse iterator to the element with the largest key.
+            const_reverse_iterator rbegin( void ) const{ return m_seq.rbegin(); }
+            /// Return a reverse iterator before the element with the smallest key.
+            const_reverse_iterator rend( void ) const{ return m_seq.rend(); }
+
+            //=== [III] CAPACITY
+
+            /// Return the number of elements.
+            size_type size( void ) const{ return m_seq.size(); }
+            /// Check whether there are no elements.
+            bool empty( void ) const{ return m_seq.empty(); }
+            /// Return how many elements fit before the storage grows.
+            size_type capacity( void ) const{ return m_seq.capacity(); }
+            /// Makes room for at least 'n' elements.
+            void reserve( size_type n ){ m_seq.reserve( n ); }
+            /// Releases the unused capacity.
+            void shrink_to_fit( void ){ m_seq.shrink_to_fit(); }
+
+            //=== [IV] ELEMENT ACCESS
+
+            /**
+             * @brief Return the value mapped to 'key', inserting a value-initialized one first if the key is absent.
+             *
+             * @param key The key.
+             * @return mapped_type& The mapped value.
+             */
+            mapped_type & operator[]( const key_type & key ){
+                return try_emplace( key ).first->second;
+            }
+
+            /**
+             * @brief Return the value mapped to 'key', moving the key in if it is absent.
+             *
+             * @param key The key.
+             * @return mapped_type& The mapped value.
+             */
+            mapped_type & operator[]( key_type && key ){
+                return try_emplace( std::move( key ) ).first->second;
+            }
+
+            /**
+             * @brief Return the value mapped to 'key'.
+             *
+             * @param key The key.
+             * @return mapped_type& The mapped value.
+             */
+            mapped_type & at( const key_type & key ){
+                iterator it = find( key );
+                if( it == end() ){
+                    throw std::out_of_range{"[flat_map::at()]: chave não encontrada."};
+                }
+                return it->second;
+            }
+
+            /**
+             * @brief Return the value mapped to 'key'.
+             *
+             * @param key The key.
+             * @return const mapped_type& The mapped value.
+             */
+            const mapped_type & at( const key_type & key ) const{
+                const_iterator it = find( key );
+                if( it == end() ){
+                    throw std::out_of_range{"[flat_map::at()]: chave não encontrada."};
+                }
+                return it->second;
+            }
+
+            //=== [V] MODIFIERS
+
+            /// Removes every element.
+            void clear( void ){ m_seq.clear(); }
+
+            /**
+             * @brief Inserts 'value' unless its key is already present.
+             *
+             * @param value The element.
+             * @return std::pair<iterator, bool> The element with that key, and whether it was inserted.
+             */
+            std::pair<iterator, bool> insert( const value_type & value ){
+                iterator it = lower_bound( value.first );
+                if( it != end() && !m_comp( value.first, it->first ) ){
+                    return { it, false };
+                }
+                return { m_seq.insert( it, value ), true };
+            }
+
+            /**
+             * @brief Inserts 'value', by moving it, unless its key is already present.
+             *
+             * @param value The element.
+             * @return std::pair<iterator, bool> The element with that key, and whether it was inserted.
+             */
+            std::pair<iterator, bool> insert( value_type && value ){
+                iterator it = lower_bound( value.first );
+                if( it != end() && !m_comp( value.first, it->first ) ){
+                    return { it, false };
+                }
+                return { m_seq.insert( it, std::move( value ) ), true };
+            }
+
+            /**
+             * @brief Inserts an element built from 'args' unless its key is already present.
+             *
+             * @param args Arguments forwarded to the constructor of value_type.
+             * @return std::pair<iterator, bool> The element with that key, and whether it was inserted.
+             */
+            template < typename... Args >
+            std::pair<iterator, bool> emplace( Args&&... args ){
+                return insert( value_type( std::forward<Args>( args )... ) );
+            }
+
+            /**
+             * @brief Inserts an element with 'key' and a value built from 'args', only if the key is absent.
+             * Nothing is built, nor moved from, when the key is present.
+             *
+             * @param key The key.
+             * @param args Arguments forwarded to the constructor of the mapped value.
+             * @return std::pair<iterator, bool> The element with that key, and whether it was inserted.
+             */
+            template < typename K, typename... Args >
+            std::pair<iterator, bool> try_emplace( K && key, Args&&... args ){
+                iterator it = lower_bound( key );
+                if( it != end() && !m_comp( key, it->first ) ){
+                    return { it, false };
+                }
+                return { m_seq.emplace( it, std::piecewise_construct,
+                                        std::forward_as_tuple( std::forward<K>( key ) ),
+                                        std::forward_as_tuple( std::forward<Args>( args )... ) ), true };
+            }
+
+            /**
+             * @brief Maps 'key' to 'obj', inserting the element or assigning to the value already there.
+             *
+             * @param key The key.
+             * @param obj The mapped value.
+             * @return std::pair<iterator, bool> The element with that key, and whether it was inserted.
+             */
+            template < typename M >
+            std::pair<iterator, bool> insert_or_assign( const key_type & key, M && obj ){
+                std::pair<iterator, bool> result = try_emplace( key, std::forward<M>( obj ) );
+                if( !result.second ){
+                    result.first->second = std::forward<M>( obj );
+                }
+                return result;
+            }
+
+            /**
+             * @brief Inserts the elements in the range [first, last) whose keys are not present yet. They are
+             * appended, sorted, and merged into the existing ones in a single pass. Of several new elements
+             * with equivalent keys, the first one is kept.
+             *
+             * @tparam InputItr Input iterator type
+             * @param first Input iterator to the initial position in a range.
+             * @param last Input iterator to the final position in a range.
+             */
+            template < typename InputItr >
+            void insert( InputItr first, InputItr last ){
+                size_type oldSize = m_seq.size();
+                m_seq.insert( m_seq.end(), first, last );
+                MergeSortedTail( m_seq, oldSize, value_comp() );
+            }
+
+            /**
+             * @brief Inserts the elements in 'ilist' whose keys are not present yet.
+             *
+             * @param ilist An initializer_list object.
+             */
+            void insert( std::initializer_list<value_type> ilist ){
+                insert( ilist.begin(), ilist.end() );
+            }
+
+            /**
+             * @brief Removes the element at 'pos'.
+             *
+             * @param pos Iterator to the element.
+             * @return iterator The element that followed it.
+             */
+            iterator erase( const_iterator pos ){
+                return m_seq.erase( pos );
+            }
+
+            /**
+             * @brief Removes the elements in [first, last).
+             *
+             * @return iterator The element that followed the last one removed.
+             */
+            iterator erase( const_iterator first, const_iterator last ){
+                return m_seq.erase( first, last );
+            }
+
+            /**
+             * @brief Removes the element with a key equivalent to 'key', if present.
+             *
+             * @param key The key.
+             * @return size_type The number of elements removed, 0 or 1.
+             */
+            size_type erase( const key_type & key ){
+                const_iterator it = find( key );
+                if( it == cend() ){
+                    return 0;
+                }
+                m_seq.erase( it );
+                return 1;
+            }
+
+            /**
+             * @brief Hands over the underlying sequence, leaving the map empty.
+             *
+             * @return container_type The elements, sorted by key.
+             */
+            container_type extract( void ){
+                container_type seq{ std::move( m_seq ) };
+                m_seq.clear();
+                return seq;
+            }
+
+            /**
+             * @brief Replaces the underlying sequence with 'seq', without copying or sorting it.
+             *
+             * @param seq A sequence sorted by key and without equivalent keys.
+             */
+            void replace( container_type && seq ){
+                m_seq = std::move( seq );
+            }
+
+            //=== [VI] LOOKUP
+
+            /**
+             * @brief Return an iterator to the element with a key equivalent to 'key', or end() if there is none.
+             *
+             * @param key The key.
+             * @return iterator
+             */
+            iterator find( const key_type & key ){
+                iterator it = lower_bound( key );
+                return it != end() && !m_comp( key, it->first ) ? it : end();
+            }
+
+            /**
+             * @brief Return an iterator to the element with a key equivalent to 'key', or end() if there is none.
+             *
+             * @param key The key.
+             * @return const_iterator
+             */
+            const_iterator find( const key_type & key ) const{
+                const_iterator it = lower_bound( key );
+                return it != end() && !m_comp( key, it->first ) ? it : end();
+            }
+
+            /// Check whether an element with a key equivalent to 'key' is present.
+            bool contains( const key_type & key ) const{ return find( key ) != end(); }
+            /// Return the number of elements with a key equivalent to 'key', 0 or 1.
+            size_type count( const key_type & key ) const{ return contains( key ) ? 1 : 0; }
+            /// Return an iterator to the first element whose key is not less than 'key'.
+            iterator lower_bound( const key_type & key ){ return std::lower_bound( begin(), end(), key, value_comp() ); }
+            /// Return an iterator to the first element whose key is not less than 'key'.
+            const_iterator lower_bound( const key_type & key ) const{ return std::lower_bound( begin(), end(), key, value_comp() ); }
+            /// Return an iterator to the first element whose key is greater than 'key'.
+            iterator upper_bound( const key_type & key ){ return std::upper_bound( begin(), end(), key, value_comp() ); }
+            /// Return an iterator to the first element whose key is greater than 'key'.
+            const_iterator upper_bound( const key_type & key ) const{ return std::upper_bound( begin(), end(), key, value_comp() ); }
+
+            /// Return the range of elements with a key equivalent to 'key', empty or of one element.
+            std::pair<iterator, iterator> equal_range( const key_type & key ){
+                iterator it = lower_bound( key );
+                return { it, it != end() && !m_comp( key, it->first ) ? it + 1 : it };
+            }
+
+            /// Return the range of elements with a key equivalent to 'key', empty or of one element.
+            std::pair<const_iterator, const_iterator> equal_range( const key_type & key ) const{
+                const_iterator it = lower_bound( key );
+                return { it, it != end() && !m_comp( key, it->first ) ? it + 1 : it };
+            }
+
+            //=== [VII] OBSERVERS
+
+            /// Return the underlying sequence, sorted by key, for zero-copy iteration.
+            const container_type & sequence( void ) const{ return m_seq; }
+            /// Return a pointer to the element with the smallest key; the elements are contiguous.
+            const value_type * data( void ) const{ return m_seq.data(); }
+            /// Return the ordering of the keys.
+            key_compare key_comp( void ) const{ return m_comp; }
+            /// Return the ordering of the elements, by key.
+            value_compare value_comp( void ) const{ return value_compare( m_comp ); }
+
+            friend void swap( flat_map & first_, flat_map & second_ ){
+                using std::swap;
+                swap( first_.m_seq, second_.m_seq );
+                swap( first_.m_comp, second_.m_comp );
+            }
+
+            friend bool operator==( const flat_map & lhs, const flat_map & rhs ){ return lhs.m_seq == rhs.m_seq; }
+            friend bool operator!=( const flat_map & lhs, const flat_map & rhs ){ return lhs.m_seq != rhs.m_seq; }
+            friend bool operator<( const flat_map & lhs, const flat_map & rhs ){ return lhs.m_seq < rhs.m_seq; }
+
+        private:
+            container_type m_seq;   //!< The elements, sorted by key and with unique keys.
+            Compare m_comp;         //!< The ordering of the keys.
+    };
+} // namespace sc.
+#endif
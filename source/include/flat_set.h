@@ -0,0 +1,353 @@
+#ifndef _FLAT_SET_H_
+#define _FLAT_SET_H_
+
+#include <cstddef>      // std::size_t
+#include <algorithm>    // std::lower_bound, std::upper_bound, std::stable_sort, std::inplace_merge
+#include <functional>   // std::less
+#include <initializer_list> // std::initializer_list
+#include <iterator>     // std::distance
+#include <memory>       // std::allocator
+#include <utility>      // std::pair, std::move, std::forward
+
+#include "vector.h"
+
+/// Sequence container namespace.
+namespace sc {
+    /// Tag telling a flat container that the sequence it is given is already sorted and free of duplicates.
+    struct sorted_unique_t { explicit sorted_unique_t( ) = default; };
+    /// The only value of sorted_unique_t.
+    const sorted_unique_t sorted_unique{};
+
+    /**
+     * @brief Sorts the elements appended to 'seq' from 'oldSize' on, merges them into the sorted
+     * prefix and drops every element equivalent to an earlier one. Sorting and merging are
+     * stable, so elements already in the container win over new ones, and among new ones
+     * the first wins.
+     *
+     * @param seq A sequence whose first 'oldSize' elements are sorted and unique.
+     * @param oldSize Length of the sorted prefix.
+     * @param less Strict weak ordering of the elements.
+     */
+    template < typename Seq, typename Less >
+    void MergeSortedTail( Seq & seq, std::size_t oldSize, Less less ){
+        auto first = seq.begin();
+        auto middle = first + oldSize;
+        std::stable_sort( middle, seq.end(), less );
+        if( oldSize != 0 && middle != seq.end() && less( *middle, *( middle - 1 ) ) ){
+            std::inplace_merge( first, middle, seq.end(), less );
+        }
+        // Keep the first of each run of equivalent elements.
+        auto out = first;
+        for( auto it = first ; it != seq.end() ; ++it ){
+            if( out == first || less( *( out - 1 ), *it ) ){
+                if( out != it ){
+                    *out = std::move( *it );
+                }
+                ++out;
+            }
+        }
+        seq.erase( out, seq.end() );
+    }
+
+    /// A sorted set of unique keys stored contiguously in an sc::vector.
+    /*!
+     * Lookups are binary searches over contiguous keys, which touch far fewer
+     * cache lines than a walk down a node-based tree. Single insertions and
+     * erasures shift the elements after the position, so they are O(n); bulk
+     * insertion appends the new keys, sorts them and merges them in, in
+     * O(n + m log m) overall. The elements are always sorted, so iterating is
+     * just walking the underlying vector, which sequence() exposes.
+     *
+     * Iterators, references and pointers are invalidated by every insertion
+     * and erasure, as with sc::vector.
+     *
+     * \tparam Key The type of the keys.
+     * \tparam Compare Strict weak ordering of the keys.
+     * \tparam Alloc Allocator of the underlying vector.
+     */
+    template < typename Key, typename Compare = std::less<Key>, typename Alloc = std::allocator<Key> >
+    class flat_set
+    {
+        //=== Aliases
+        public:
+            using container_type = vector<Key, Alloc>;                      //!< The underlying sequence.
+            using key_type = Key;                                           //!< The key type.
+            using value_type = Key;                                         //!< The value type.
+            using key_compare = Compare;                                    //!< The ordering of the keys.
+            using value_compare = Compare;                                  //!< The ordering of the values.
+            using size_type = typename container_type::size_type;           //!< The size type.
+            using reference = value_type &;                                 //!< Reference to a value.
+            using const_reference = const value_type &;                     //!< Const reference to a value.
+            using iterator = typename container_type::const_iterator;       //!< Keys are never modified in place.
+            using const_iterator = typename container_type::const_iterator; //!< Const iterator.
+            using reverse_iterator = typename container_type::const_reverse_iterator;       //!< Reverse iterator.
+            using const_reverse_iterator = typename container_type::const_reverse_iterator; //!< Const reverse iterator.
+
+        public:
+            //=== [I] SPECIAL MEMBERS
+
+            /**
+             * @brief Construct a new empty flat_set object.
+             *
+             * @param comp The ordering of the keys.
+             */
+            explicit flat_set( const Compare & comp = Compare() )
+                : m_comp{comp}
+            { /* empty */ }
+
+            /**
+             * @brief Construct a new flat_set object with the keys in the range [first, last), duplicates dropped.
+             *
+             * @tparam InputItr Input iterator type
+             * @param first Input iterator to the initial position in a range.
+             * @param last Input iterator to the final position in a range.
+             * @param comp The ordering of the keys.
+             */
+            template < typename InputItr >
+            flat_set( InputItr first, InputItr last, const Compare & comp = Compare() )
+                : m_comp{comp}
+            {
+                insert( first, last );
+            }
+
+            /**
+             * @brief Construct a new flat_set object with the keys in 'init', duplicates dropped.
+             *
+             * @param init An initializer_list object.
+             * @param comp The ordering of the keys.
+             */
+            flat_set( std::initializer_list<Key> init, const Compare & comp = Compare() )
+                : m_comp{comp}
+            {
+                insert( init.begin(), init.end() );
+            }
+
+            /**
+             * @brief Construct a new flat_set object that adopts 'seq' as is, without copying or sorting it.
+             *
+             * @param seq A sequence sorted by 'comp' and without equivalent keys.
+             * @param comp The ordering of the keys.
+             */
+            flat_set( sorted_unique_t, container_type seq, const Compare & comp = Compare() )
+                : m_seq{std::move( seq )}, m_comp{comp}
+            { /* empty */ }
+
+            /**
+             * @brief Replaces the contents with the keys in 'init', duplicates dropped.
+             *
+             * @param init An initializer_list object.
+             * @return flat_set& always returns *this enabling things like a = b = c.
+             */
+            flat_set & operator=( std::initializer_list<Key> init ){
+                m_seq.clear();
+                insert( init.begin(), init.end() );
+                return *this;
+            }
+
+            //=== [II] ITERATORS
+
+            /// Return an iterator to the smallest key.
+            const_iterator begin( void ) const{ return m_seq.cbegin(); }
+            /// Return an iterator past the largest key.
+            const_iterator end( void ) const{ return m_seq.cend(); }
+            /// Return an iterator to the smallest key.
+            const_iterator cbegin( void ) const{ return m_seq.cbegin(); }
+            /// Return an iterator past the largest key.
+            const_iterator cend( void ) const{ return m_seq.cend(); }
+            /// Return a reverse iterator to the largest key.
+            const_reverse_iterator rbegin( void ) const{ return m_seq.crbegin(); }
+            /// Return a reverse iterator before the smallest key.
+            const_reverse_iterator rend( void ) const{ return m_seq.crend(); }
+
+            //=== [III] CAPACITY
+
+            /// Return the number of keys.
+            size_type size( void ) const{ return m_seq.size(); }
+            /// Check whether there are no keys.
+            bool empty( void ) const{ return m_seq.empty(); }
+            /// Return how many keys fit before the storage grows.
+            size_type capacity( void ) const{ return m_seq.capacity(); }
+            /// Makes room for at least 'n' keys.
+            void reserve( size_type n ){ m_seq.reserve( n ); }
+            /// Releases the unused capacity.
+            void shrink_to_fit( void ){ m_seq.shrink_to_fit(); }
+
+            //=== [IV] MODIFIERS
+
+            /// Removes every key.
+            void clear( void ){ m_seq.clear(); }
+
+            /**
+             * @brief Inserts 'value' unless an equivalent key is already present.
+             *
+             * @param value The key.
+             * @return std::pair<iterator, bool> The key with that value, and whether it was inserted.
+             */
+            std::pair<iterator, bool> insert( const value_type & value ){
+                return InsertUnique( value );
+            }
+
+            /**
+             * @brief Inserts 'value', by moving it, unless an equivalent key is already present.
+             *
+             * @param value The key.
+             * @return std::pair<iterator, bool> The key with that value, and whether it was inserted.
+             */
+            std::pair<iterator, bool> insert( value_type && value ){
+                return InsertUnique( std::move( value ) );
+            }
+
+            /**
+             * @brief Inserts a key built from 'args' unless an equivalent key is already present.
+             *
+             * @param args Arguments forwarded to the key's constructor.
+             * @return std::pair<iterator, bool> The key with that value, and whether it was inserted.
+             */
+            template < typename... Args >
+            std::pair<iterator, bool> emplace( Args&&... args ){
+                return InsertUnique( value_type( std::forward<Args>( args )... ) );
+            }
+
+            /**
+             * @brief Inserts the keys in the range [first, last) that are not present yet. They are appended,
+             * sorted, and merged into the existing ones in a single pass.
+             *
+             * @tparam InputItr Input iterator type
+             * @param first Input iterator to the initial position in a range.
+             * @param last Input iterator to the final position in a range.
+             */
+            template < typename InputItr >
+            void insert( InputItr first, InputItr last ){
+                size_type oldSize = m_seq.size();
+                m_seq.insert( m_seq.end(), first, last );
+                MergeSortedTail( m_seq, oldSize, m_comp );
+            }
+
+            /**
+             * @brief Inserts the keys in 'ilist' that are not present yet.
+             *
+             * @param ilist An initializer_list object.
+             */
+            void insert( std::initializer_list<Key> ilist ){
+                insert( ilist.begin(), ilist.end() );
+            }
+
+            /**
+             * @brief Removes the key at 'pos'.
+             *
+             * @param pos Iterator to the key.
+             * @return iterator The key that followed it.
+             */
+            iterator erase( const_iterator pos ){
+                return m_seq.erase( pos );
+            }
+
+            /**
+             * @brief Removes the keys in [first, last).
+             *
+             * @return iterator The key that followed the last one removed.
+             */
+            iterator erase( const_iterator first, const_iterator last ){
+                return m_seq.erase( first, last );
+            }
+
+            /**
+             * @brief Removes the key equivalent to 'key', if present.
+             *
+             * @param key The key.
+             * @return size_type The number of keys removed, 0 or 1.
+             */
+            size_type erase( const key_type & key ){
+                const_iterator it = find( key );
+                if( it == end() ){
+                    return 0;
+                }
+                m_seq.erase( it );
+                return 1;
+            }
+
+            /**
+             * @brief Hands over the underlying sequence, leaving the set empty.
+             *
+             * @return container_type The sorted keys.
+             */
+            container_type extract( void ){
+                container_type seq{ std::move( m_seq ) };
+                m_seq.clear();
+                return seq;
+            }
+
+            /**
+             * @brief Replaces the underlying sequence with 'seq', without copying or sorting it.
+             *
+             * @param seq A sequence sorted by key_comp() and without equivalent keys.
+             */
+            void replace( container_type && seq ){
+                m_seq = std::move( seq );
+            }
+
+            //=== [V] LOOKUP
+
+            /**
+             * @brief Return an iterator to the key equivalent to 'key', or end() if there is none.
+             *
+             * @param key The key.
+             * @return const_iterator
+             */
+            const_iterator find( const key_type & key ) const{
+                const_iterator it = lower_bound( key );
+                return it != end() && !m_comp( key, *it ) ? it : end();
+            }
+
+            /// Check whether a key equivalent to 'key' is present.
+            bool contains( const key_type & key ) const{ return find( key ) != end(); }
+            /// Return the number of keys equivalent to 'key', 0 or 1.
+            size_type count( const key_type & key ) const{ return contains( key ) ? 1 : 0; }
+            /// Return an iterator to the first key not less than 'key'.
+            const_iterator lower_bound( const key_type & key ) const{ return std::lower_bound( begin(), end(), key, m_comp ); }
+            /// Return an iterator to the first key greater than 'key'.
+            const_iterator upper_bound( const key_type & key ) const{ return std::upper_bound( begin(), end(), key, m_comp ); }
+
+            /// Return the range of keys equivalent to 'key', empty or of one key.
+            std::pair<const_iterator, const_iterator> equal_range( const key_type & key ) const{
+                const_iterator it = lower_bound( key );
+                return { it, it != end() && !m_comp( key, *it ) ? it + 1 : it };
+            }
+
+            //=== [VI] OBSERVERS
+
+            /// Return the underlying sorted sequence, for zero-copy iteration.
+            const container_type & sequence( void ) const{ return m_seq; }
+            /// Return a pointer to the smallest key; the keys are contiguous.
+            const value_type * data( void ) const{ return m_seq.data(); }
+            /// Return the ordering of the keys.
+            key_compare key_comp( void ) const{ return m_comp; }
+            /// Return the ordering of the values, the same as key_comp().
+            value_compare value_comp( void ) const{ return m_comp; }
+
+            friend void swap( flat_set & first_, flat_set & second_ ){
+                using std::swap;
+                swap( first_.m_seq, second_.m_seq );
+                swap( first_.m_comp, second_.m_comp );
+            }
+
+            friend bool operator==( const flat_set & lhs, const flat_set & rhs ){ return lhs.m_seq == rhs.m_seq; }
+            friend bool operator!=( const flat_set & lhs, const flat_set & rhs ){ return lhs.m_seq != rhs.m_seq; }
+            friend bool operator<( const flat_set & lhs, const flat_set & rhs ){ return lhs.m_seq < rhs.m_seq; }
+
+        private:
+            /// Inserts 'value' at its sorted position, unless an equivalent key is there already.
+            template < typename V >
+            std::pair<iterator, bool> InsertUnique( V && value ){
+                const_iterator it = lower_bound( value );
+                if( it != end() && !m_comp( value, *it ) ){
+                    return { it, false };
+                }
+                return { m_seq.insert( it, std::forward<V>( value ) ), true };
+            }
+
+            container_type m_seq;   //!< The keys, sorted and unique.
+            Compare m_comp;         //!< The ordering of the keys.
+    };
+} // namespace sc.
+#endif
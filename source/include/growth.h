@@ -0,0 +1,108 @@
+#ifndef _GROWTH_H_
+#define _GROWTH_H_
+
+#include <cstddef>      // std::size_t
+
+/// Sequence container namespace.
+namespace sc {
+    /// Growth policy that multiplies the capacity by Num/Den each time the container fills up.
+    /*!
+     * A growth policy is a type with a static member
+     *
+     *     std::size_t grow( std::size_t capacity, std::size_t required, std::size_t elemSize );
+     *
+     * returning the new capacity, in elements, for a container that holds
+     * 'capacity' elements of 'elemSize' bytes and needs room for at least
+     * 'required' of them. The result must not be smaller than 'required'.
+     *
+     * A factor of 2 wastes the least time copying; 1.5 lets the allocator
+     * reuse the blocks freed by earlier growths and wastes less memory.
+     *
+     * \tparam Num Numerator of the growth factor.
+     * \tparam Den Denominator of the growth factor.
+     * \tparam MinCapacity The capacity of the first block ever allocated.
+     */
+    template < std::size_t Num, std::size_t Den = 1, std::size_t MinCapacity = 1 >
+    struct geometric_growth
+    {
+        static_assert( Num > Den && Den > 0, "sc::geometric_growth needs a factor greater than one" );
+
+        /**
+         * @brief Computes the capacity that follows 'capacity'.
+         *
+         * @param capacity Current capacity.
+         * @param required Minimum capacity needed.
+         * @return std::size_t The new capacity.
+         */
+        static std::size_t grow( std::size_t capacity, std::size_t required, std::size_t ){
+            std::size_t next = capacity / Den * Num + capacity % Den * Num / Den;
+            if( next <= capacity ){
+                next = capacity + 1;
+            }
+            if( next < MinCapacity ){
+                next = MinCapacity;
+            }
+            return next < required ? required : next;
+        }
+    };
+
+    /// Doubles the capacity on each growth, starting from a single element.
+    using double_growth = geometric_growth< 2 >;
+
+    /// Grows the capacity by half on each growth, starting from a single element.
+    using one_and_half_growth = geometric_growth< 3, 2 >;
+
+    /// Growth policy that rounds the blocks chosen by 'Base' up to what the allocator would hand out anyway.
+    /*!
+     * Small blocks are rounded up to the size classes used by common malloc
+     * implementations (16 bytes up to 128, then four classes per power of
+     * two), large blocks to whole pages. The slack that the allocator would
+     * otherwise keep hidden becomes usable capacity, and large buffers map
+     * cleanly onto pages, which is what lets realloc() grow them in place.
+     *
+     * \tparam Base The policy that picks the unrounded capacity.
+     * \tparam PageSize Size of a page, in bytes. Blocks at least this large are page rounded.
+     */
+    template < typename Base = double_growth, std::size_t PageSize = 4096 >
+    struct size_class_growth
+    {
+        static_assert( ( PageSize & ( PageSize - 1 ) ) == 0, "sc::size_class_growth needs a power of two page size" );
+
+        /**
+         * @brief Computes the capacity that follows 'capacity'.
+         *
+         * @param capacity Current capacity.
+         * @param required Minimum capacity needed.
+         * @param elemSize Size of an element, in bytes.
+         * @return std::size_t The new capacity.
+         */
+        static std::size_t grow( std::size_t capacity, std::size_t required, std::size_t elemSize ){
+            std::size_t next = Base::grow( capacity, required, elemSize );
+            std::size_t bytes = RoundBytes( next * elemSize );
+            return bytes / elemSize;
+        }
+
+        /**
+         * @brief Rounds a block size up to its size class, or to whole pages.
+         *
+         * @param bytes Size of the block, in bytes.
+         * @return std::size_t The rounded size.
+         */
+        static std::size_t RoundBytes( std::size_t bytes ){
+            if( bytes >= PageSize ){
+                return ( bytes + PageSize - 1 ) & ~( PageSize - 1 );
+            }
+            if( bytes <= 128 ){
+                return ( bytes + 15 ) & ~std::size_t( 15 );
+            }
+            // Four classes between consecutive powers of two: (2^k, 2^(k+1)] in steps of 2^(k-2).
+            std::size_t k = 0;
+            for( std::size_t b = bytes - 1 ; b > 1 ; b >>= 1 ){
+                ++k;
+            }
+            std::size_t step = std::size_t( 1 ) << ( k - 2 );
+            return ( bytes + step - 1 ) & ~( step - 1 );
+        }
+    };
+} // namespace sc.
+#endif
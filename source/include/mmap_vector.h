@@ -0,0 +1,485 @@
+#ifndef _MMAP_VECTOR_H_
+#define _MMAP_VECTOR_H_
+
+#include <cerrno>       // errno
+#include <cstddef>      // std::size_t, std::ptrdiff_t
+#include <cstring>      // std::memcpy
+#include <algorithm>    // std::fill
+#include <stdexcept>    // std::out_of_range, std::length_error, std::logic_error, std::runtime_error
+#include <string>       // std::string
+#include <system_error> // std::system_error, std::generic_category
+#include <type_traits>  // std::is_trivially_copyable
+#include <utility>      // std::swap
+
+#include <fcntl.h>      // open
+#include <sys/mman.h>   // mmap, mremap, munmap, msync, madvise
+#include <sys/stat.h>   // fstat
+#include <unistd.h>     // close, ftruncate
+
+#include "growth.h"
+
+/// Sequence container namespace.
+namespace sc {
+    /// A vector whose elements live in a memory-mapped file.
+    /*!
+     * The file holds the elements and nothing else: size() * sizeof(T) raw
+     * bytes. Opening maps the file without reading it, so the cost does not
+     * depend on its size; the kernel loads pages on first touch and may
+     * drop clean ones under memory pressure, which lets the data be larger
+     * than RAM. advise() tells the kernel how the pages will be used.
+     *
+     * Growing extends the file with ftruncate() and the mapping with
+     * mremap(), which moves page table entries instead of copying bytes,
+     * but like any growth of sc::vector it may change data() and
+     * invalidates pointers to the elements. While open for writing the file
+     * is as large as capacity(); close() truncates it back to size().
+     * flush() does the same and writes the dirty pages out without closing,
+     * so the file can be reopened as it is even if close() never runs.
+     *
+     * A vector returned by open_readonly() maps the file read only and
+     * throws std::logic_error from every member that would change it.
+     *
+     * \tparam T The type of the elements. It must be trivially copyable.
+     * \tparam Growth Policy that picks the next capacity when the file fills up.
+     */
+    template < typename T, typename Growth = double_growth >
+    class mmap_vector
+    {
+        static_assert( std::is_trivially_copyable<T>::value, "sc::mmap_vector needs a trivially copyable type" );
+
+        //=== Aliases
+        public:
+            using size_type = std::size_t;              //!< The size type.
+            using difference_type = std::ptrdiff_t;     //!< The difference type.
+            using value_type = T;                       //!< The value type.
+            using pointer = T *;                        //!< Pointer to a value stored in the container.
+            using const_pointer = const T *;            //!< Pointer to a const value stored in the container.
+            using reference = T &;                      //!< Reference to a value stored in the container.
+            using const_reference = const T &;          //!< Const reference to a value stored in the container.
+            using iterator = T *;                       //!< The iterator: the elements are one array.
+            using const_iterator = const T *;           //!< The const iterator.
+
+            /// How the program is going to read the elements, for advise().
+            enum class access { normal, sequential, random, will_need, dont_need };
+
+        public:
+            //=== [I] SPECIAL MEMBERS
+
+            /**
+             * @brief Construct a new mmap_vector object that is not backed by any file.
+             * Nothing but open() or being assigned to works on it.
+             */
+            mmap_vector( void ) = default;
+
+            /**
+             * @brief Construct a new mmap_vector object over the file at 'path', open for writing.
+             * The file is created empty if it does not exist.
+             *
+             * @param path Path of the file.
+             */
+            explicit mmap_vector( const std::string & path ){
+                open( path );
+            }
+
+            mmap_vector( const mmap_vector & ) = delete;
+            mmap_vector & operator=( const mmap_vector & ) = delete;
+
+            /**
+             * @brief Construct a new mmap_vector object that takes over the file of 'other', which is left closed.
+             *
+             * @param other Another mmap_vector object of the same type.
+             */
+            mmap_vector( mmap_vector && other ) noexcept{
+                swap( *this, other );
+            }
+
+            /**
+             * @brief Closes this vector's file and takes over the one of 'rhs', which is left closed.
+             *
+             * @param rhs An mmap_vector object of the same type.
+             * @return mmap_vector& always returns *this enabling things like a = b = c.
+             */
+            mmap_vector & operator=( mmap_vector && rhs ){
+                if( this != &rhs ){
+                    close();
+                    swap( *this, rhs );
+                }
+                return *this;
+            }
+
+            /**
+             * @brief Destroy the mmap_vector object, closing its file.
+             *
+             */
+            ~mmap_vector( void ){
+                try{
+                    close();
+                }catch(...){
+                    // A destructor must not throw; the file keeps its capacity-sized tail.
+                }
+            }
+
+            /**
+             * @brief Opens the file at 'path' for writing, creating it if needed, after closing the current one.
+             *
+             * @param path Path of the file.
+             */
+            void open( const std::string & path ){
+                close();
+                Map( path, false );
+            }
+
+            /**
+             * @brief Returns a vector over the file at 'path', mapped read only.
+             *
+             * @param path Path of an existing file.
+             * @return mmap_vector The vector.
+             */
+            static mmap_vector open_readonly( const std::string & path ){
+                mmap_vector result;
+                result.Map( path, true );
+                return result;
+            }
+
+            /**
+             * @brief Unmaps and closes the file, truncating it to size() elements first if it was open for writing.
+             *
+             */
+            void close( void ){
+                if( m_fd < 0 ){
+                    return;
+                }
+                if( m_data != nullptr ){
+                    ::munmap( m_data, m_capacity * sizeof( T ) );
+                }
+                int fd = m_fd;
+                bool truncate = !m_read_only && m_capacity != m_size;
+                off_t bytes = static_cast<off_t>( m_size * sizeof( T ) );
+                m_data = nullptr;
+                m_size = 0;
+                m_capacity = 0;
+                m_fd = -1;
+                m_path.clear();
+                int error = truncate && ::ftruncate( fd, bytes ) != 0 ? errno : 0;
+                ::close( fd );
+                if( error != 0 ){
+                    throw std::system_error( error, std::generic_category(), "[mmap_vector::close()]: ftruncate falhou" );
+                }
+            }
+
+            //=== [II] ITERATORS
+
+            iterator begin( void ){ return m_data; }
+            iterator end( void ){ return m_data + m_size; }
+            const_iterator begin( void ) const{ return m_data; }
+            const_iterator end( void ) const{ return m_data + m_size; }
+            const_iterator cbegin( void ) const{ return begin(); }
+            const_iterator cend( void ) const{ return end(); }
+
+            //=== [III] CAPACITY
+
+            /// Return the number of elements.
+            size_type size( void ) const{ return m_size; }
+            /// Return how many elements fit in the file as it is mapped now.
+            size_type capacity( void ) const{ return m_capacity; }
+            /// Check whether there are no elements.
+            bool empty( void ) const{ return m_size == 0; }
+            /// Check whether a file is open.
+            bool is_open( void ) const{ return m_fd >= 0; }
+            /// Check whether the file was opened by open_readonly().
+            bool read_only( void ) const{ return m_read_only; }
+            /// Return the path of the open file.
+            const std::string & path( void ) const{ return m_path; }
+
+            /**
+             * @brief Extends the file so that at least 'n' elements fit.
+             *
+             * @param n Number of elements.
+             */
+            void reserve( size_type n ){
+                Writable( "reserve" );
+                if( n > m_capacity ){
+                    Remap( n );
+                }
+            }
+
+            /// Shrinks the file and the mapping to size() elements.
+            void shrink_to_fit( void ){
+                Writable( "shrink_to_fit" );
+                if( m_capacity > m_size ){
+                    Remap( m_size );
+                }
+            }
+
+            //=== [IV] MODIFIERS
+
+            /// Removes every element. The file keeps its capacity until close() or shrink_to_fit().
+            void clear( void ){
+                Writable( "clear" );
+                m_size = 0;
+            }
+
+            /// Appends a copy of 'value'.
+            void push_back( const_reference value ){
+                Writable( "push_back" );
+                if( m_size == m_capacity ){
+                    // 'value' may live in the mapping, which mremap() may move.
+                    T copy( value );
+                    Remap( Growth::grow( m_capacity, m_size + 1, sizeof( T ) ) );
+                    m_data[m_size++] = copy;
+                    return;
+                }
+                m_data[m_size++] = value;
+            }
+
+            /// Removes the last element.
+            void pop_back( void ){
+                Writable( "pop_back" );
+                if( empty() ){
+                    throw std::length_error ("[mmap_vector::pop_back()]: não posso remover um elemento de um vector vazio.");
+                }
+                --m_size;
+            }
+
+            /**
+             * @brief Changes the number of elements to 'count'; new elements are copies of 'value'.
+             *
+             * @param count New size.
+             * @param value Value of the elements added.
+             */
+            void resize( size_type count, const_reference value = T() ){
+                Writable( "resize" );
+                if( count > m_capacity ){
+                    T copy( value );
+                    Remap( count );
+                    std::fill( m_data + m_size, m_data + count, copy );
+                }else if( count > m_size ){
+                    std::fill( m_data + m_size, m_data + count, value );
+                }
+                m_size = count;
+            }
+
+            /**
+             * @brief Replaces the contents with the range [first, first + count), copied in one go.
+             *
+             * @param first The elements.
+             * @param count Number of elements.
+             */
+            void assign( const_pointer first, size_type count ){
+                Writable( "assign" );
+                if( count > m_capacity ){
+                    Remap( count );
+                }
+                if( count > 0 ){
+                    std::memcpy( m_data, first, count * sizeof( T ) );
+                }
+                m_size = count;
+            }
+
+            /**
+             * @brief Trims the file and the mapping to size() elements and writes the dirty pages back, waiting for the disk.
+             * The next insertion grows the file again.
+             *
+             */
+            void flush( void ){
+                Writable( "flush" );
+                if( m_capacity > m_size ){
+                    // The file has no header, so its length is the only record of size().
+                    Remap( m_size );
+                }
+                if( m_size > 0 && ::msync( m_data, m_size * sizeof( T ), MS_SYNC ) != 0 ){
+                    throw std::system_error( errno, std::generic_category(), "[mmap_vector::flush()]: msync falhou" );
+                }
+            }
+
+            /**
+             * @brief Tells the kernel how the elements are going to be read, so it can read ahead or not.
+             *
+             * @param pattern The access pattern.
+             */
+            void advise( access pattern ) const{
+                if( m_data == nullptr ){
+                    return;
+                }
+                int advice = MADV_NORMAL;
+                switch( pattern ){
+                    case access::normal:     advice = MADV_NORMAL; break;
+                    case access::sequential: advice = MADV_SEQUENTIAL; break;
+                    case access::random:     advice = MADV_RANDOM; break;
+                    case access::will_need:  advice = MADV_WILLNEED; break;
+                    case access::dont_need:  advice = MADV_DONTNEED; break;
+                }
+                if( ::madvise( static_cast<void *>( m_data ), m_capacity * sizeof( T ), advice ) != 0 ){
+                    throw std::system_error( errno, std::generic_category(), "[mmap_vector::advise()]: madvise falhou" );
+                }
+            }
+
+            //=== [V] ELEMENT ACCESS
+
+            reference operator[]( size_type pos ){ return m_data[pos]; }
+            const_reference operator[]( size_type pos ) const{ return m_data[pos]; }
+
+            /**
+             * @brief Return the element at 'pos', with bounds checking.
+             *
+             * @param pos Position of the element.
+             * @return reference
+             */
+            reference at( size_type pos ){
+                if( pos >= m_size ){
+                    throw std::out_of_range{"Posição Acessada Fora do Range"};
+                }
+                return m_data[pos];
+            }
+
+            /**
+             * @brief Return the element at 'pos', with bounds checking.
+             *
+             * @param pos Position of the element.
+             * @return const_reference
+             */
+            const_reference at( size_type pos ) const{
+                if( pos >= m_size ){
+                    throw std::out_of_range{"Posição Acessada Fora do Range"};
+                }
+                return m_data[pos];
+            }
+
+            reference front( void ){
+                if( empty() ){
+                    throw std::length_error ("[mmap_vector::front()]: vector vazio.");
+                }
+                return m_data[0];
+            }
+            const_reference front( void ) const{
+                if( empty() ){
+                    throw std::length_error ("[mmap_vector::front()]: vector vazio.");
+                }
+                return m_data[0];
+            }
+            reference back( void ){
+                if( empty() ){
+                    throw std::length_error ("[mmap_vector::back()]: vector vazio.");
+                }
+                return m_data[m_size - 1];
+            }
+            const_reference back( void ) const{
+                if( empty() ){
+                    throw std::length_error ("[mmap_vector::back()]: vector vazio.");
+                }
+                return m_data[m_size - 1];
+            }
+
+            pointer data( void ){ return m_data; }
+            const_pointer data( void ) const{ return m_data; }
+
+            friend void swap( mmap_vector & first_, mmap_vector & second_ ) noexcept{
+                using std::swap;
+                swap( first_.m_data, second_.m_data );
+                swap( first_.m_size, second_.m_size );
+                swap( first_.m_capacity, second_.m_capacity );
+                swap( first_.m_fd, second_.m_fd );
+                swap( first_.m_read_only, second_.m_read_only );
+                swap( first_.m_path, second_.m_path );
+            }
+
+        private:
+            /// Opens and maps the file at 'path'. Must be called on a closed vector.
+            void Map( const std::string & path, bool readOnly ){
+                int fd = readOnly ? ::open( path.c_str(), O_RDONLY | O_CLOEXEC )
+                                  : ::open( path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644 );
+                if( fd < 0 ){
+                    throw std::system_error( errno, std::generic_category(), "[mmap_vector::open()]: não consegui abrir " + path );
+                }
+                struct stat info;
+                if( ::fstat( fd, &info ) != 0 ){
+                    int error = errno;
+                    ::close( fd );
+                    throw std::system_error( error, std::generic_category(), "[mmap_vector::open()]: fstat falhou" );
+                }
+                size_type bytes = static_cast<size_type>( info.st_size );
+                if( bytes % sizeof( T ) != 0 ){
+                    ::close( fd );
+                    throw std::runtime_error( "[mmap_vector::open()]: o tamanho de " + path + " não é múltiplo do tamanho do elemento." );
+                }
+                void * addr = nullptr;
+                if( bytes > 0 ){
+                    addr = ::mmap( nullptr, bytes, readOnly ? PROT_READ : PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+                    if( addr == MAP_FAILED ){
+                        int error = errno;
+                        ::close( fd );
+                        throw std::system_error( error, std::generic_category(), "[mmap_vector::open()]: mmap falhou" );
+                    }
+                }
+                m_fd = fd;
+                m_data = static_cast<pointer>( addr );
+                m_size = bytes / sizeof( T );
+                m_capacity = m_size;
+                m_read_only = readOnly;
+                m_path = path;
+            }
+
+            /// Resizes the file and its mapping to 'newCapacity' elements, which must not be below size().
+            void Remap( size_type newCapacity ){
+                size_type oldBytes = m_capacity * sizeof( T );
+                size_type newBytes = newCapacity * sizeof( T );
+                // The file must be long enough before pages past its old end are mapped,
+                // and must keep its length until the pages past its new end are unmapped.
+                if( newBytes > oldBytes ){
+                    Truncate( newBytes );
+                }
+                void * addr = nullptr;
+                if( newBytes == 0 ){
+                    ::munmap( m_data, oldBytes );
+                }else if( m_data == nullptr ){
+                    addr = ::mmap( nullptr, newBytes, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0 );
+                }else{
+#if defined(__linux__)
+                    addr = ::mremap( m_data, oldBytes, newBytes, MREMAP_MAYMOVE );
+#else
+                    addr = ::mmap( nullptr, newBytes, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0 );
+                    if( addr != MAP_FAILED ){
+                        ::munmap( m_data, oldBytes );
+                    }
+#endif
+                }
+                if( addr == MAP_FAILED ){
+                    int error = errno;
+                    if( newBytes > oldBytes ){
+                        Truncate( oldBytes );
+                    }
+                    throw std::system_error( error, std::generic_category(), "[mmap_vector]: não consegui mapear o arquivo" );
+                }
+                if( newBytes < oldBytes ){
+                    Truncate( newBytes );
+                }
+                m_data = static_cast<pointer>( addr );
+                m_capacity = newCapacity;
+            }
+
+            /// Sets the length of the file to 'bytes'.
+            void Truncate( size_type bytes ){
+                if( ::ftruncate( m_fd, static_cast<off_t>( bytes ) ) != 0 ){
+                    throw std::system_error( errno, std::generic_category(), "[mmap_vector]: ftruncate falhou" );
+                }
+            }
+
+            /// Throws unless a file is open for writing.
+            void Writable( const char * member ) const{
+                if( m_fd < 0 ){
+                    throw std::logic_error( std::string( "[mmap_vector::" ) + member + "()]: nenhum arquivo aberto." );
+                }
+                if( m_read_only ){
+                    throw std::logic_error( std::string( "[mmap_vector::" ) + member + "()]: o arquivo foi aberto somente para leitura." );
+                }
+            }
+
+            pointer m_data = nullptr;       //!< The mapping.
+            size_type m_size = 0;           //!< Number of elements.
+            size_type m_capacity = 0;       //!< Number of elements the mapping and the file hold.
+            int m_fd = -1;                  //!< The file descriptor, or -1 when closed.
+            bool m_read_only = false;       //!< Whether the file was opened by open_readonly().
+            std::string m_path;             //!< Path of the open file.
+    };
+} // namespace sc.
+#endif
@@ -0,0 +1,723 @@
+#ifndef _PARALLEL_H_
+#define _PARALLEL_H_
+
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uintptr_t
+#include <atomic>       // std::atomic
+#include <thread>       // std::thread
+#include <mutex>        // std::mutex, std::unique_lock, std::lock_guard
+#include <condition_variable> // std::condition_variable
+#include <functional>   // std::function, std::plus
+#include <exception>    // std::exception_ptr, std::current_exception, std::rethrow_exception
+#include <stdexcept>    // std::length_error
+#include <algorithm>    // std::sort, std::stable_sort, std::merge, std::move
+#include <iterator>     // std::make_move_iterator
+#include <memory>       // std::uninitialized_copy
+#include <new>          // ::operator new, ::operator delete
+#include <utility>      // std::swap
+
+#include "vector.h"
+
+/// Sequence container namespace.
+namespace sc {
+    /// Parallel algorithms over the contiguous storage of sc::vector.
+    namespace par {
+        /// A fixed set of worker threads that run batches of indexed tasks.
+        /*!
+         * run( tasks, fn ) calls fn(0) ... fn(tasks-1) spread over the workers
+         * and the calling thread, and returns once all of them have finished.
+         * The workers sleep between batches, so a pool is meant to be created
+         * once and reused; default_pool() is shared by the whole program.
+         *
+         * A batch started from inside one of the pool's own tasks runs on the
+         * calling thread alone, and batches from different threads take turns.
+         */
+        class thread_pool
+        {
+            public:
+                /**
+                 * @brief Construct a new thread_pool object that runs tasks on 'threads' threads, the caller's included.
+                 *
+                 * @param threads Number of threads, by default one per hardware thread.
+                 */
+                explicit thread_pool( std::size_t threads = std::thread::hardware_concurrency() ){
+                    if( threads == 0 ){
+                        threads = 1;
+                    }
+                    m_workers.reserve( threads - 1 );
+                    for( std::size_t i{1} ; i < threads ; ++i ){
+                        m_workers.emplace_back( [this]( ){ WorkerLoop(); } );
+                    }
+                }
+
+                thread_pool( const thread_pool & ) = delete;
+                thread_pool & operator=( const thread_pool & ) = delete;
+
+                /**
+                 * @brief Destroy the thread_pool object, joining every worker.
+                 *
+                 */
+                ~thread_pool( void ){
+                    {
+                        std::lock_guard<std::mutex> lock( m_mutex );
+                        m_stop = true;
+                    }
+                    m_wake.notify_all();
+                    for( auto & worker : m_workers ){
+                        worker.join();
+                    }
+                }
+
+                /**
+                 * @brief Return the number of threads that run tasks, the caller's included.
+                 *
+                 * @return std::size_t
+                 */
+                std::size_t size( void ) const{
+                    return m_workers.size() + 1;
+                }
+
+                /**
+                 * @brief Runs fn(i) for every i in [0, tasks) and waits for all of them.
+                 * If tasks throw, the tasks not yet started are skipped and the first exception is rethrown.
+                 *
+                 * @param tasks Number of tasks.
+                 * @param fn The task body, called with the task index.
+                 */
+                void run( std::size_t tasks, const std::function<void(std::size_t)> & fn ){
+                    if( tasks == 0 ){
+                        return;
+                    }
+                    if( tasks == 1 || m_workers.empty() || CurrentPool() == this ){
+                        for( std::size_t i{0} ; i < tasks ; ++i ){
+                            fn( i );
+                        }
+                        return;
+                    }
+                    std::lock_guard<std::mutex> turn( m_run_mutex );
+                    {
+                        std::lock_guard<std::mutex> lock( m_mutex );
+                        m_job = &fn;
+                        m_tasks = tasks;
+                        m_next.store( 0 );
+                        m_active = m_workers.size();
+                        m_error = nullptr;
+                        ++m_generation;
+                    }
+                    m_wake.notify_all();
+                    // A task run here that starts a batch of its own must run it inline, as on a
+                    // worker: m_run_mutex is ours until this batch ends.
+                    thread_pool * outer = CurrentPool();
+                    CurrentPool() = this;
+                    Work();
+                    CurrentPool() = outer;
+
+                    std::unique_lock<std::mutex> lock( m_mutex );
+                    m_done.wait( lock, [this]( ){ return m_active == 0; } );
+                    m_job = nullptr;
+                    if( m_error ){
+                        std::exception_ptr error = m_error;
+                        m_error = nullptr;
+                        std::rethrow_exception( error );
+                    }
+                }
+
+            private:
+                /// The pool whose task the calling thread is running, if any.
+                static thread_pool *& CurrentPool( void ){
+                    static thread_local thread_pool * current = nullptr;
+                    return current;
+                }
+
+                /// Body of each worker: wait for a new batch, help with it, check out.
+                void WorkerLoop( void ){
+                    CurrentPool() = this;
+                    std::size_t seen{0};
+                    for( ;; ){
+                        {
+                            std::unique_lock<std::mutex> lock( m_mutex );
+                            m_wake.wait( lock, [&]( ){ return m_stop || m_generation != seen; } );
+                            if( m_stop ){
+                                return;
+                            }
+                            seen = m_generation;
+                        }
+                        Work();
+                        std::lock_guard<std::mutex> lock( m_mutex );
+                        if( --m_active == 0 ){
+                            m_done.notify_one();
+                        }
+                    }
+                }
+
+                /// Claims and runs tasks of the current batch until none is left.
+                void Work( void ){
+                    for( std::size_t i = m_next.fetch_add( 1 ) ; i < m_tasks ; i = m_next.fetch_add( 1 ) ){
+                        try{
+                            ( *m_job )( i );
+                        }catch(...){
+                            std::lock_guard<std::mutex> lock( m_mutex );
+                            if( !m_error ){
+                                m_error = std::current_exception();
+                            }
+                            m_next.store( m_tasks );
+                        }
+                    }
+                }
+
+                vector<std::thread> m_workers;      //!< The worker threads.
+                std::mutex m_run_mutex;             //!< Held by the thread whose batch is running.
+                std::mutex m_mutex;                 //!< Guards the batch state below.
+                std::condition_variable m_wake;     //!< Signals a new batch, or shutdown.
+                std::condition_variable m_done;     //!< Signals that every worker checked out.
+                const std::function<void(std::size_t)> * m_job = nullptr; //!< The task body of the current batch.
+                std::size_t m_tasks = 0;            //!< Number of tasks in the current batch.
+                std::atomic<std::size_t> m_next{0}; //!< Next task to claim.
+                std::size_t m_active = 0;           //!< Workers that have not finished the current batch.
+                std::size_t m_generation = 0;       //!< Number of batches started so far.
+                std::exception_ptr m_error;         //!< First exception thrown by a task of the current batch.
+                bool m_stop = false;                //!< Whether the workers must quit.
+        };
+
+        /**
+         * @brief Return the pool shared by every parallel algorithm that is not given one.
+         *
+         * @return thread_pool& A pool with one thread per hardware thread.
+         */
+        inline thread_pool & default_pool( void ){
+            static thread_pool pool;
+            return pool;
+        }
+
+        const std::size_t cache_line = 64;          //!< Chunk boundaries fall on multiples of this, in bytes.
+        const std::size_t min_chunk_bytes = 1 << 16; //!< Smaller chunks are not worth a thread.
+        const std::size_t chunks_per_thread = 4;    //!< Spare chunks let fast threads help slow ones.
+
+        /// The result of one chunk, followed by a cache line of padding. Each chunk's thread writes its
+        /// own slot, so slots must share neither a word (as vector<bool> would pack them) nor a line.
+        template < typename R >
+        struct ChunkSlot {
+            R value;                    //!< The chunk's result.
+            char pad[cache_line];       //!< Keeps the next slot off this one's cache line.
+        };
+
+        /**
+         * @brief Return how many chunks 'n' elements of type T are split into on 'pool'.
+         *
+         * @param n Number of elements.
+         * @param pool The pool that will run the chunks.
+         * @return std::size_t At least one.
+         */
+        template < typename T >
+        std::size_t ChunkCount( std::size_t n, const thread_pool & pool ){
+            std::size_t byChunkSize = n * sizeof( T ) / min_chunk_bytes;
+            std::size_t byThreads = pool.size() * chunks_per_thread;
+            std::size_t chunks = byChunkSize < byThreads ? byChunkSize : byThreads;
+            return chunks == 0 ? 1 : chunks;
+        }
+
+        /**
+         * @brief Return the index where chunk 'i' of 'chunks' starts. Inner boundaries are moved
+         * forward to the next cache line, so that no two threads write to the same line.
+         *
+         * @param data The elements.
+         * @param n Number of elements.
+         * @param chunks Number of chunks.
+         * @param i Chunk index, in [0, chunks].
+         * @return std::size_t The first element of the chunk.
+         */
+        template < typename T >
+        std::size_t ChunkStart( const T * data, std::size_t n, std::size_t chunks, std::size_t i ){
+            if( i == 0 ){
+                return 0;
+            }
+            if( i >= chunks ){
+                return n;
+            }
+            std::size_t pos = n / chunks * i + n % chunks * i / chunks;
+            std::uintptr_t base = reinterpret_cast<std::uintptr_t>( data );
+            std::uintptr_t at = reinterpret_cast<std::uintptr_t>( data + pos );
+            std::uintptr_t aligned = ( at + cache_line - 1 ) & ~std::uintptr_t( cache_line - 1 );
+            if( ( aligned - base ) % sizeof( T ) == 0 ){
+                pos = ( aligned - base ) / sizeof( T );
+            }
+            return pos < n ? pos : n;
+        }
+
+        /**
+         * @brief Runs fn(first, last, chunk) over cache-aligned chunks of [0, n), in parallel.
+         *
+         * @param pool The pool that runs the chunks.
+         * @param data The elements being split.
+         * @param n Number of elements.
+         * @param chunks Number of chunks, from ChunkCount().
+         * @param fn Called with the bounds and the index of each chunk.
+         */
+        template < typename T, typename Fn >
+        void ForChunks( thread_pool & pool, const T * data, std::size_t n, std::size_t chunks, Fn fn ){
+            pool.run( chunks, [&]( std::size_t c ){
+                fn( ChunkStart( data, n, chunks, c ), ChunkStart( data, n, chunks, c + 1 ), c );
+            } );
+        }
+
+        /// Makes sc::vector initialize or copy its elements in chunks spread over a thread pool.
+        /*!
+         * Pass it to the vector( count, policy ) and vector( other, policy )
+         * constructors or to the assign() overloads that take a policy:
+         *
+         *     sc::vector<double> v( n, sc::par::first_touch() );
+         *     sc::vector<double> w( v, sc::par::first_touch( pool ) );
+         *
+         * Copies run at the combined memory bandwidth of the threads. A fresh
+         * block's pages are first touched by the threads that fill them, so the
+         * OS spreads them over the NUMA nodes of those threads instead of
+         * placing all of them on the caller's node. The chunks are the ones
+         * for_each(), transform() and the other algorithms here use for the
+         * same vector, so later passes over it mostly read local memory.
+         */
+        class first_touch
+        {
+            public:
+                /**
+                 * @brief Construct a new first_touch object that runs the chunks on 'pool'.
+                 *
+                 * @param pool The pool that runs the work.
+                 */
+                explicit first_touch( thread_pool & pool = default_pool() ) : m_pool{&pool}{ /* empty */ }
+
+                /**
+                 * @brief Runs fn(first, last) over cache-aligned chunks of [0, n), in parallel.
+                 *
+                 * @param data The slots being initialized.
+                 * @param n Number of slots.
+                 * @param fn Called with the bounds of each chunk.
+                 */
+                template < typename T, typename Fn >
+                void for_chunks( const T * data, std::size_t n, Fn fn ) const{
+                    ForChunks( *m_pool, data, n, ChunkCount<T>( n, *m_pool ), [&]( std::size_t first, std::size_t last, std::size_t ){
+                        fn( first, last );
+                    } );
+                }
+
+            private:
+                thread_pool * m_pool;   //!< The pool that runs the chunks.
+        };
+
+        /**
+         * @brief Applies 'fn' to every element of 'vec', in parallel.
+         *
+         * @param vec The elements.
+         * @param fn Called with a reference to each element. It must be safe to call concurrently.
+         * @param pool The pool that runs the work.
+         */
+        template < typename T, typename Alloc, typename Growth, typename Fn >
+        void for_each( vector<T, Alloc, Growth> & vec, Fn fn, thread_pool & pool = default_pool() ){
+            T * data = vec.data();
+            std::size_t n = vec.size();
+            ForChunks( pool, data, n, ChunkCount<T>( n, pool ), [&]( std::size_t first, std::size_t last, std::size_t ){
+                for( std::size_t i{first} ; i < last ; ++i ){
+                    fn( data[i] );
+                }
+            } );
+        }
+
+        /**
+         * @brief Applies 'fn' to every element of 'vec', in parallel.
+         *
+         * @param vec The elements.
+         * @param fn Called with a const reference to each element. It must be safe to call concurrently.
+         * @param pool The pool that runs the work.
+         */
+        template < typename T, typename Alloc, typename Growth, typename Fn >
+        void for_each( const vector<T, Alloc, Growth> & vec, Fn fn, thread_pool & pool = default_pool() ){
+            const T * data = vec.data();
+            std::size_t n = vec.size();
+            ForChunks( pool, data, n, ChunkCount<T>( n, pool ), [&]( std::size_t first, std::size_t last, std::size_t ){
+                for( std::size_t i{first} ; i < last ; ++i ){
+                    fn( data[i] );
+                }
+            } );
+        }
+
+        /**
+         * @brief Stores fn(in[i]) in out[i] for every element, in parallel. 'in' and 'out' may be the same vector.
+         *
+         * @param in The source elements.
+         * @param out The destination. It must have as many elements as 'in'.
+         * @param fn The transformation. It must be safe to call concurrently.
+         * @param pool The pool that runs the work.
+         */
+        template < typename T, typename A1, typename G1, typename U, typename A2, typename G2, typename Fn >
+        void transform( const vector<T, A1, G1> & in, vector<U, A2, G2> & out, Fn fn, thread_pool & pool = default_pool() ){
+            if( out.size() != in.size() ){
+                throw std::length_error( "[par::transform()]: os vectors de entrada e de saída têm tamanhos diferentes." );
+            }
+            const T * src = in.data();
+            U * dest = out.data();
+            std::size_t n = in.size();
+            // Chunks follow the destination, whose cache lines are the ones written.
+            ForChunks( pool, dest, n, ChunkCount<U>( n, pool ), [&]( std::size_t first, std::size_t last, std::size_t ){
+                for( std::size_t i{first} ; i < last ; ++i ){
+                    dest[i] = fn( src[i] );
+                }
+            } );
+        }
+
+        /**
+         * @brief Combines at(i) for every i in [0, n), and 'init', with 'op', in parallel.
+         * Each chunk is reduced on its own and the partial results are combined in order.
+         *
+         * @param pool The pool that runs the work.
+         * @param data The elements the chunks follow.
+         * @param n Number of elements.
+         * @param init The initial value.
+         * @param op The reduction, an associative binary operation.
+         * @param at Returns the value that stands for element i.
+         * @return R The reduced value.
+         */
+        template < typename T, typename R, typename Op, typename At >
+        R ReduceChunks( thread_pool & pool, const T * data, std::size_t n, R init, Op op, At at ){
+            if( n == 0 ){
+                return init;
+            }
+            std::size_t chunks = ChunkCount<T>( n, pool );
+            vector< ChunkSlot<R> > partial( chunks, ChunkSlot<R>{ init, {} } );
+            ForChunks( pool, data, n, chunks, [&]( std::size_t first, std::size_t last, std::size_t c ){
+                R acc = at( first );
+                for( std::size_t i{first + 1} ; i < last ; ++i ){
+                    acc = op( acc, at( i ) );
+                }
+                partial[c].value = acc;
+            } );
+            R result = init;
+            for( std::size_t c{0} ; c < chunks ; ++c ){
+                result = op( result, partial[c].value );
+            }
+            return result;
+        }
+
+        /**
+         * @brief Combines fn(vec[i]) for every element, and 'init', with 'op', in parallel.
+         * The partial results of the chunks are combined in order, so 'op' must be associative
+         * but need not be commutative, and the result only depends on the pool size.
+         *
+         * @param vec The elements.
+         * @param init The initial value.
+         * @param op The reduction, an associative binary operation.
+         * @param fn The transformation applied to each element first.
+         * @param pool The pool that runs the work.
+         * @return R The reduced value.
+         */
+        template < typename T, typename Alloc, typename Growth, typename R, typename Op, typename Fn >
+        R transform_reduce( const vector<T, Alloc, Growth> & vec, R init, Op op, Fn fn, thread_pool & pool = default_pool() ){
+            const T * data = vec.data();
+            return ReduceChunks( pool, data, vec.size(), init, op, [&]( std::size_t i ){ return fn( data[i] ); } );
+        }
+
+        /**
+         * @brief Combines fn(a[i], b[i]) for every pair of elements, and 'init', with 'op', in parallel.
+         * A dot product is transform_reduce( a, b, 0.0, std::plus<double>(), std::multiplies<double>() ).
+         *
+         * @param a The first elements.
+         * @param b The second elements. It must have as many elements as 'a'.
+         * @param init The initial value.
+         * @param op The reduction, an associative binary operation.
+         * @param fn The transformation applied to each pair first.
+         * @param pool The pool that runs the work.
+         * @return R The reduced value.
+         */
+        template < typename T, typename A1, typename G1, typename U, typename A2, typename G2, typename R, typename Op, typename Fn >
+        R transform_reduce( const vector<T, A1, G1> & a, const vector<U, A2, G2> & b, R init, Op op, Fn fn, thread_pool & pool = default_pool() ){
+            if( a.size() != b.size() ){
+                throw std::length_error( "[par::transform_reduce()]: os vectors têm tamanhos diferentes." );
+            }
+            const T * x = a.data();
+            const U * y = b.data();
+            return ReduceChunks( pool, x, a.size(), init, op, [&]( std::size_t i ){ return fn( x[i], y[i] ); } );
+        }
+
+        /**
+         * @brief Combines the elements of 'vec', and 'init', with 'op', in parallel.
+         *
+         * @param vec The elements.
+         * @param init The initial value.
+         * @param op The reduction, an associative binary operation. By default the elements are summed.
+         * @param pool The pool that runs the work.
+         * @return R The reduced value.
+         */
+        template < typename T, typename Alloc, typename Growth, typename R, typename Op = std::plus<R> >
+        R reduce( const vector<T, Alloc, Growth> & vec, R init, Op op = Op(), thread_pool & pool = default_pool() ){
+            const T * data = vec.data();
+            return ReduceChunks( pool, data, vec.size(), init, op, [&]( std::size_t i ) -> const T & { return data[i]; } );
+        }
+
+        /**
+         * @brief Stores in out[i] the combination with 'op' of in[0] ... in[i], in parallel.
+         * Each chunk is scanned on its own, the chunk totals are scanned, and then every chunk but
+         * the first is offset by the total of the ones before it. 'in' and 'out' may be the same vector.
+         *
+         * @param in The source elements.
+         * @param out The destination. It must have as many elements as 'in'.
+         * @param op The combination, an associative binary operation. By default the elements are summed.
+         * @param pool The pool that runs the work.
+         */
+        template < typename T, typename A1, typename G1, typename A2, typename G2, typename Op = std::plus<T> >
+        void inclusive_scan( const vector<T, A1, G1> & in, vector<T, A2, G2> & out, Op op = Op(), thread_pool & pool = default_pool() ){
+            if( out.size() != in.size() ){
+                throw std::length_error( "[par::inclusive_scan()]: os vectors de entrada e de saída têm tamanhos diferentes." );
+            }
+            const T * src = in.data();
+            T * dest = out.data();
+            std::size_t n = in.size();
+            if( n == 0 ){
+                return;
+            }
+            // Chunks hold at least min_chunk_bytes, so none of them is empty.
+            std::size_t chunks = ChunkCount<T>( n, pool );
+            vector< ChunkSlot<T> > totals( chunks, ChunkSlot<T>{ src[0], {} } );
+            ForChunks( pool, dest, n, chunks, [&]( std::size_t first, std::size_t last, std::size_t c ){
+                T acc = src[first];
+                dest[first] = acc;
+                for( std::size_t i{first + 1} ; i < last ; ++i ){
+                    acc = op( acc, src[i] );
+                    dest[i] = acc;
+                }
+                totals[c].value = acc;
+            } );
+            if( chunks == 1 ){
+                return;
+            }
+            // totals[c] becomes the combination of chunks 0 ... c-1, which chunk c must be offset by.
+            T running = totals[0].value;
+            for( std::size_t c{1} ; c < chunks ; ++c ){
+                T own = totals[c].value;
+                totals[c].value = running;
+                running = op( running, own );
+            }
+            ForChunks( pool, dest, n, chunks, [&]( std::size_t first, std::size_t last, std::size_t c ){
+                if( c == 0 ){
+                    return;
+                }
+                const T offset = totals[c].value;
+                for( std::size_t i{first} ; i < last ; ++i ){
+                    dest[i] = op( offset, dest[i] );
+                }
+            } );
+        }
+
+        /**
+         * @brief Return how many elements of the first run go into the first 'd' elements of
+         * the stable merge of a[0, na) and b[0, nb). Ties come from 'a'.
+         *
+         * @param a The first sorted run.
+         * @param na Its length.
+         * @param b The second sorted run.
+         * @param nb Its length.
+         * @param d A position in the merged output, in [0, na + nb].
+         * @param comp The ordering of both runs.
+         * @return std::size_t The number of elements taken from 'a'.
+         */
+        template < typename T, typename Comp >
+        std::size_t MergeSplit( const T * a, std::size_t na, const T * b, std::size_t nb, std::size_t d, Comp & comp ){
+            std::size_t lo = d > nb ? d - nb : 0;
+            std::size_t hi = d < na ? d : na;
+            while( lo < hi ){
+                std::size_t mid = lo + ( hi - lo ) / 2;
+                if( comp( b[d - mid - 1], a[mid] ) ){
+                    hi = mid;
+                }else{
+                    lo = mid + 1;
+                }
+            }
+            return lo;
+        }
+
+        /**
+         * @brief Merges the sorted runs [a, aEnd) and [b, bEnd) into 'out', moving the elements. Ties come from 'a'.
+         * When 'raw' is set 'out' is uninitialized and the elements are move-constructed there,
+         * and destroyed again if anything throws.
+         *
+         * @param out Where the merged run goes.
+         * @param comp The ordering of both runs.
+         * @param raw Whether 'out' holds no objects yet.
+         */
+        template < typename T, typename Comp >
+        void MoveMerge( T * a, T * aEnd, T * b, T * bEnd, T * out, Comp & comp, bool raw ){
+            if( !raw ){
+                std::merge( std::make_move_iterator( a ), std::make_move_iterator( aEnd ),
+                            std::make_move_iterator( b ), std::make_move_iterator( bEnd ), out, comp );
+                return;
+            }
+            T * next = out;
+            try{
+                for( ; a != aEnd && b != bEnd ; ++next ){
+                    T * from = comp( *b, *a ) ? b++ : a++;
+                    ::new( static_cast<void *>( next ) ) T( std::move( *from ) );
+                }
+                next = std::uninitialized_copy( std::make_move_iterator( a ), std::make_move_iterator( aEnd ), next );
+                std::uninitialized_copy( std::make_move_iterator( b ), std::make_move_iterator( bEnd ), next );
+            }catch(...){
+                while( next != out ){
+                    ( --next )->~T();
+                }
+                throw;
+            }
+        }
+
+        /// Raw memory for n elements, which destroys the ranges recorded in it as built.
+        template < typename T >
+        struct ScratchBuffer
+        {
+            T * data;                       //!< The memory.
+            vector<std::size_t> first;      //!< Start of the range built by each task.
+            vector<std::size_t> last;       //!< End of the range built by each task; empty until it finished.
+
+            ScratchBuffer( std::size_t n, std::size_t tasks )
+                : data{ static_cast<T *>( ::operator new( n * sizeof( T ) ) ) }, first( tasks, 0 ), last( tasks, 0 )
+            { /* empty */ }
+
+            ScratchBuffer( const ScratchBuffer & ) = delete;
+            ScratchBuffer & operator=( const ScratchBuffer & ) = delete;
+
+            ~ScratchBuffer( void ){
+                for( std::size_t t{0} ; t < first.size() ; ++t ){
+                    for( std::size_t i{first[t]} ; i < last[t] ; ++i ){
+                        data[i].~T();
+                    }
+                }
+                ::operator delete( data );
+            }
+        };
+
+        /**
+         * @brief Sorts data[0, n) with a parallel merge sort on 'pool'.
+         *
+         * The range is cut into a power of two of cache-aligned runs, sorted
+         * one per task with std::sort or std::stable_sort. Then every round
+         * merges pairs of runs, ping-ponging between 'data' and one scratch
+         * buffer allocated up front. Each merge is itself cut into pieces at
+         * output positions found by MergeSplit(), so the last rounds, with
+         * few and long runs, still keep every thread busy. Tasks are claimed
+         * one at a time from the pool, so threads that finish early take the
+         * work the others have not started. When the number of rounds is odd
+         * the runs are sorted in the scratch buffer, so the last round lands
+         * back in 'data'.
+         *
+         * The scratch buffer starts out as raw memory, so T needs no default
+         * constructor. Whichever step writes to it first, the sort of the runs
+         * or the first round of merges, move-constructs the elements there.
+         *
+         * @param pool The pool that runs the work.
+         * @param data The elements.
+         * @param n Number of elements.
+         * @param comp The ordering. It must be safe to call concurrently.
+         * @param stable Whether equivalent elements keep their order.
+         */
+        template < typename T, typename Comp >
+        void MergeSort( thread_pool & pool, T * data, std::size_t n, Comp & comp, bool stable ){
+            std::size_t chunks = ChunkCount<T>( n, pool );
+            std::size_t runs{1};
+            while( runs * 2 <= chunks ){
+                runs *= 2;
+            }
+            if( runs == 1 ){
+                if( stable ){
+                    std::stable_sort( data, data + n, comp );
+                }else{
+                    std::sort( data, data + n, comp );
+                }
+                return;
+            }
+            std::size_t rounds{0};
+            for( std::size_t r{runs} ; r > 1 ; r /= 2 ){
+                ++rounds;
+            }
+
+            vector<std::size_t> bounds( runs + 1 );
+            for( std::size_t c{0} ; c <= runs ; ++c ){
+                bounds[c] = ChunkStart( data, n, runs, c );
+            }
+            std::size_t target = pool.size() * chunks_per_thread;
+            std::size_t firstPieces = target > runs / 2 ? ( target + runs / 2 - 1 ) / ( runs / 2 ) : 1;
+            // One buffer for every round. Each task that builds elements in it records
+            // their range, so they are destroyed even if another task throws.
+            ScratchBuffer<T> scratch( n, rounds % 2 == 1 ? runs : runs / 2 * firstPieces );
+            T * src = rounds % 2 == 1 ? scratch.data : data;
+            T * dest = src == data ? scratch.data : data;
+
+            pool.run( runs, [&]( std::size_t c ){
+                T * first = src + bounds[c];
+                T * last = src + bounds[c + 1];
+                if( src != data ){
+                    std::uninitialized_copy( std::make_move_iterator( data + bounds[c] ),
+                                             std::make_move_iterator( data + bounds[c + 1] ), first );
+                    scratch.first[c] = bounds[c];
+                    scratch.last[c] = bounds[c + 1];
+                }
+                if( stable ){
+                    std::stable_sort( first, last, comp );
+                }else{
+                    std::sort( first, last, comp );
+                }
+            } );
+
+            for( std::size_t width{1} ; width < runs ; width *= 2 ){
+                std::size_t pairs = runs / ( 2 * width );
+                std::size_t pieces = target > pairs ? ( target + pairs - 1 ) / pairs : 1;
+                pool.run( pairs * pieces, [&]( std::size_t t ){
+                    std::size_t pair = t / pieces;
+                    std::size_t piece = t % pieces;
+                    std::size_t begin = bounds[2 * pair * width];
+                    std::size_t middle = bounds[( 2 * pair + 1 ) * width];
+                    std::size_t end = bounds[( 2 * pair + 2 ) * width];
+                    const T * a = src + begin;
+                    const T * b = src + middle;
+                    std::size_t na = middle - begin;
+                    std::size_t nb = end - middle;
+                    std::size_t d0 = ( na + nb ) * piece / pieces;
+                    std::size_t d1 = ( na + nb ) * ( piece + 1 ) / pieces;
+                    std::size_t i0 = MergeSplit( a, na, b, nb, d0, comp );
+                    std::size_t i1 = MergeSplit( a, na, b, nb, d1, comp );
+                    T * a0 = src + begin;
+                    T * b0 = src + middle;
+                    // Only the first round can find the scratch buffer still raw.
+                    bool raw = width == 1 && dest == scratch.data;
+                    MoveMerge( a0 + i0, a0 + i1, b0 + ( d0 - i0 ), b0 + ( d1 - i1 ), dest + begin + d0, comp, raw );
+                    if( raw ){
+                        scratch.first[t] = begin + d0;
+                        scratch.last[t] = begin + d1;
+                    }
+                } );
+                std::swap( src, dest );
+            }
+        }
+
+        /**
+         * @brief Sorts 'vec' with 'comp', in parallel. Equivalent elements may be reordered.
+         *
+         * @param vec The elements.
+         * @param comp The ordering. It must be safe to call concurrently.
+         * @param pool The pool that runs the work.
+         */
+        template < typename T, typename Alloc, typename Growth, typename Comp = std::less<T> >
+        void sort( vector<T, Alloc, Growth> & vec, Comp comp = Comp(), thread_pool & pool = default_pool() ){
+            MergeSort( pool, vec.data(), vec.size(), comp, false );
+        }
+
+        /**
+         * @brief Sorts 'vec' with 'comp', in parallel, keeping equivalent elements in their order.
+         *
+         * @param vec The elements.
+         * @param comp The ordering. It must be safe to call concurrently.
+         * @param pool The pool that runs the work.
+         */
+        template < typename T, typename Alloc, typename Growth, typename Comp = std::less<T> >
+        void stable_sort( vector<T, Alloc, Growth> & vec, Comp comp = Comp(), thread_pool & pool = default_pool() ){
+            MergeSort( pool, vec.data(), vec.size(), comp, true );
+        }
+    } // namespace par.
+
+    template < >
+    struct is_chunk_policy< par::first_touch > : std::true_type {};
+} // namespace sc.
+#endif
@@ -0,0 +1,233 @@
+#ifndef _RADIX_SORT_H_
+#define _RADIX_SORT_H_
+
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint32_t, std::uint64_t
+#include <cstring>      // std::memcpy
+#include <algorithm>    // std::sort, std::copy, std::move
+#include <new>          // ::operator new, ::operator delete
+#include <stdexcept>    // std::length_error
+#include <type_traits>  // std::is_integral, std::is_signed, std::is_floating_point
+
+#include "vector.h"
+
+/// Sequence container namespace.
+namespace sc {
+    /// Maps keys of type T to unsigned integers that sort in the same order.
+    /*!
+     * Unsigned integers are their own key. Signed integers get their sign
+     * bit flipped, so negatives come first. Floating point numbers get
+     * their sign bit set when positive and every bit flipped when
+     * negative, which orders them as numbers: -inf < ... < -0.0 < +0.0 <
+     * ... < +inf, with NaNs past the infinities of their sign.
+     *
+     * \tparam T The key type: an integer, float or double.
+     */
+    template < typename T, typename = void >
+    struct radix_traits;
+
+    template < typename T >
+    struct radix_traits< T, typename std::enable_if< std::is_integral<T>::value >::type >
+    {
+        using key_type = typename std::make_unsigned<T>::type;  //!< The unsigned key.
+        static const key_type sign = std::is_signed<T>::value ? key_type( key_type( 1 ) << ( sizeof( T ) * 8 - 1 ) ) : 0;
+
+        static key_type encode( T value ){ return static_cast<key_type>( value ) ^ sign; }
+    };
+
+    template < typename T >
+    struct radix_traits< T, typename std::enable_if< std::is_floating_point<T>::value >::type >
+    {
+        static_assert( sizeof( T ) == 4 || sizeof( T ) == 8, "sc::radix_sort handles 32 and 64-bit floating point" );
+        using key_type = typename std::conditional< sizeof( T ) == 4, std::uint32_t, std::uint64_t >::type; //!< The unsigned key.
+        static const key_type sign = key_type( key_type( 1 ) << ( sizeof( T ) * 8 - 1 ) );
+
+        static key_type encode( T value ){
+            key_type bits;
+            std::memcpy( &bits, &value, sizeof( bits ) );
+            // All ones for negatives, just the sign bit for positives.
+            key_type mask = key_type( -key_type( bits >> ( sizeof( T ) * 8 - 1 ) ) ) | sign;
+            return bits ^ mask;
+        }
+    };
+
+    /// Digit width of the radix sort of keys 'KeyBytes' bytes long.
+    /*!
+     * 32-bit keys take three passes of 11 bits. 64-bit keys take eight
+     * passes of 8 bits: 11 bits would save two passes, but six 2048-entry
+     * histograms no longer fit in L1, and 2048 scatter streams overrun the
+     * write-combining buffers and the TLB.
+     */
+    template < std::size_t KeyBytes >
+    struct RadixDigits
+    {
+        static const std::size_t bits = KeyBytes == 4 ? 11 : 8;                         //!< Bits per digit.
+        static const std::size_t buckets = std::size_t( 1 ) << bits;                    //!< Values a digit takes.
+        static const std::size_t passes = ( KeyBytes * 8 + bits - 1 ) / bits;           //!< Digits per key.
+    };
+
+    /// Below this many elements radix sort loses to std::sort.
+    const std::size_t radix_sort_threshold = 2048;
+
+    /// Destroys the first 'built' values of the scratch buffers of RadixSort() and frees both.
+    template < typename T, typename V >
+    void DestroyScratch( T * keys, V * values, std::size_t built ){
+        for( std::size_t i{0} ; i < built ; ++i ){
+            values[i].~V();
+        }
+        ::operator delete( values );
+        ::operator delete( keys );
+    }
+
+    /**
+     * @brief LSD radix sort of keys[0, n), carrying values[0, n) along when WithValues is set.
+     *
+     * One read of the keys fills the histograms of every digit. A digit
+     * whose histogram has a single bucket is the same in every key, and its
+     * pass is skipped. The passes ping-pong between the data and one
+     * scratch buffer; if they end in the scratch buffer, it is copied back.
+     * The scratch buffer is raw memory: the first pass that runs
+     * move-constructs the values into it, so V needs no default constructor.
+     *
+     * @param keys The keys.
+     * @param values The values, or nullptr without them.
+     * @param n Number of elements.
+     */
+    template < bool WithValues, typename T, typename V >
+    void RadixSort( T * keys, V * values, std::size_t n ){
+        using traits = radix_traits<T>;
+        using key_type = typename traits::key_type;
+        using digits = RadixDigits< sizeof( key_type ) >;
+        const key_type mask = key_type( digits::buckets - 1 );
+
+        vector<std::size_t> counts( digits::passes * digits::buckets );
+        for( std::size_t i{0} ; i < n ; ++i ){
+            key_type k = traits::encode( keys[i] );
+            for( std::size_t p{0} ; p < digits::passes ; ++p ){
+                ++counts[p * digits::buckets + ( ( k >> ( p * digits::bits ) ) & mask )];
+            }
+        }
+
+        // The keys are arithmetic, so raw memory holds them as is.
+        T * keyScratch = static_cast<T *>( ::operator new( n * sizeof( T ) ) );
+        V * valueScratch = nullptr;
+        bool built{false};  // Whether valueScratch holds n values.
+        try{
+            if( WithValues ){
+                valueScratch = static_cast<V *>( ::operator new( n * sizeof( V ) ) );
+            }
+            T * src = keys;
+            T * dest = keyScratch;
+            V * vsrc = values;
+            V * vdest = valueScratch;
+            key_type first = traits::encode( keys[0] );
+            std::size_t offsets[digits::buckets];
+            for( std::size_t p{0} ; p < digits::passes ; ++p ){
+                std::size_t shift = p * digits::bits;
+                std::size_t * count = &counts[p * digits::buckets];
+                if( count[( first >> shift ) & mask] == n ){
+                    continue;
+                }
+                std::size_t sum{0};
+                for( std::size_t d{0} ; d < digits::buckets ; ++d ){
+                    offsets[d] = sum;
+                    sum += count[d];
+                }
+                std::size_t i{0};
+                try{
+                    for( ; i < n ; ++i ){
+                        std::size_t pos = offsets[( traits::encode( src[i] ) >> shift ) & mask]++;
+                        dest[pos] = src[i];
+                        if( WithValues ){
+                            if( built ){
+                                vdest[pos] = std::move( vsrc[i] );
+                            }else{
+                                ::new( static_cast<void *>( vdest + pos ) ) V( std::move( vsrc[i] ) );
+                            }
+                        }
+                    }
+                }catch(...){
+                    if( WithValues && !built ){
+                        // The values built so far went where the first 'i' keys did: replay them.
+                        sum = 0;
+                        for( std::size_t d{0} ; d < digits::buckets ; ++d ){
+                            offsets[d] = sum;
+                            sum += count[d];
+                        }
+                        for( std::size_t j{0} ; j < i ; ++j ){
+                            vdest[offsets[( traits::encode( src[j] ) >> shift ) & mask]++].~V();
+                        }
+                    }
+                    throw;
+                }
+                built = WithValues;
+                std::swap( src, dest );
+                std::swap( vsrc, vdest );
+            }
+            if( src != keys ){
+                std::copy( src, src + n, keys );
+                if( WithValues ){
+                    std::move( vsrc, vsrc + n, values );
+                }
+            }
+        }catch(...){
+            DestroyScratch( keyScratch, valueScratch, built ? n : 0 );
+            throw;
+        }
+        DestroyScratch( keyScratch, valueScratch, built ? n : 0 );
+    }
+
+    /**
+     * @brief Sorts 'vec' in ascending order with an LSD radix sort.
+     *
+     * Runs in O(n) passes over the data: three for 32-bit keys, at most
+     * eight for 64-bit ones, minus the digits that are the same in every
+     * element. Short vectors go to std::sort.
+     *
+     * @param vec The elements: integers, float or double.
+     */
+    template < typename T, typename Alloc, typename Growth >
+    void radix_sort( vector<T, Alloc, Growth> & vec ){
+        if( vec.size() < radix_sort_threshold ){
+            std::sort( vec.data(), vec.data() + vec.size(), []( T a, T b ){
+                return radix_traits<T>::encode( a ) < radix_traits<T>::encode( b );
+            } );
+            return;
+        }
+        RadixSort<false>( vec.data(), static_cast<char *>( nullptr ), vec.size() );
+    }
+
+    /**
+     * @brief Sorts 'keys' in ascending order, applying the same permutation to 'values'.
+     * Equal keys keep the order they had.
+     *
+     * @param keys The keys: integers, float or double.
+     * @param values The values. It must have as many elements as 'keys'.
+     */
+    template < typename T, typename A1, typename G1, typename V, typename A2, typename G2 >
+    void radix_sort_by_key( vector<T, A1, G1> & keys, vector<V, A2, G2> & values ){
+        if( keys.size() != values.size() ){
+            throw std::length_error( "[radix_sort_by_key()]: os vectors de chaves e de valores têm tamanhos diferentes." );
+        }
+        if( keys.size() < 64 ){
+            // Stable insertion sort, carrying the values along. It is quadratic, so it
+            // stops well short of radix_sort_threshold.
+            T * k = keys.data();
+            V * v = values.data();
+            for( std::size_t i{1} ; i < keys.size() ; ++i ){
+                T key = k[i];
+                V value = std::move( v[i] );
+                std::size_t j{i};
+                for( ; j > 0 && radix_traits<T>::encode( key ) < radix_traits<T>::encode( k[j - 1] ) ; --j ){
+                    k[j] = k[j - 1];
+                    v[j] = std::move( v[j - 1] );
+                }
+                k[j] = key;
+                v[j] = std::move( value );
+            }
+            return;
+        }
+        RadixSort<true>( keys.data(), values.data(), keys.size() );
+    }
+} // namespace sc.
+#endif
@@ -0,0 +1,246 @@
+#ifndef _RCU_VECTOR_H_
+#define _RCU_VECTOR_H_
+
+#include <atomic>       // std::atomic
+#include <cstddef>      // std::size_t
+#include <memory>       // std::allocator
+#include <mutex>        // std::mutex, std::lock_guard
+#include <stdexcept>    // std::out_of_range, std::length_error
+#include <thread>       // std::this_thread::yield
+#include <utility>      // std::move, std::swap
+
+#include "vector.h"
+
+/// Sequence container namespace.
+namespace sc {
+    /// A vector for many readers and an occasional writer, updated read-copy-update style.
+    /*!
+     * The contents are an immutable sc::vector, the current version.
+     * read() returns a snapshot: a handle that keeps one version alive and
+     * reads it as a plain array, with no atomic or lock per element. Taking
+     * and dropping a snapshot never blocks.
+     *
+     * update() copies the current version, applies a batch of changes to
+     * the copy and publishes it with one atomic store; readers switch to it
+     * on their next read(), while the snapshots already taken keep the old
+     * one. Writers are serialized by a mutex that readers never touch.
+     *
+     * A reader pins a version by counting itself in, loading the current
+     * pointer and bumping that version's reader count. The count-in goes to
+     * one of two counters picked by the parity of an epoch that every
+     * update() advances, so a writer retiring a version only waits for the
+     * readers caught inside those few instructions on the old parity, and
+     * new readers can not keep it waiting. A reader that finds the epoch
+     * moved while it counted itself in starts over, which only happens
+     * while a writer publishes.
+     *
+     * Retired versions are freed by the writer, on the next update() or
+     * reclaim() after their last snapshot is gone, so a reader never pays
+     * for a deallocation. Snapshots must not outlive the rcu_vector.
+     *
+     * \tparam T The type of the elements.
+     * \tparam Alloc Allocator of each version's vector.
+     */
+    template < typename T, typename Alloc = std::allocator<T> >
+    class rcu_vector
+    {
+        //=== Aliases
+        public:
+            using size_type = std::size_t;                  //!< The size type.
+            using value_type = T;                           //!< The value type.
+            using vector_type = vector<T, Alloc>;           //!< The vector holding each version.
+            using const_reference = const T &;              //!< Const reference to a value stored in the container.
+            using const_iterator = typename vector_type::const_iterator; //!< Iterator over a snapshot.
+
+        private:
+            /// One published version of the contents.
+            struct Version
+            {
+                explicit Version( vector_type && d ) : data( std::move( d ) ) { /* empty */ }
+
+                vector_type data;                       //!< The elements. Never changed once published.
+                std::atomic<size_type> readers{0};      //!< Snapshots holding this version.
+            };
+
+        public:
+            /// A read-only handle to one version of the contents.
+            class snapshot
+            {
+                public:
+                    snapshot( void ) = default;
+
+                    snapshot( const snapshot & other ) : m_version{other.m_version}{
+                        if( m_version != nullptr ){
+                            m_version->readers.fetch_add( 1, std::memory_order_relaxed );
+                        }
+                    }
+
+                    snapshot( snapshot && other ) noexcept : m_version{other.m_version}{
+                        other.m_version = nullptr;
+                    }
+
+                    snapshot & operator=( snapshot other ) noexcept{
+                        std::swap( m_version, other.m_version );
+                        return *this;
+                    }
+
+                    ~snapshot( void ){
+                        if( m_version != nullptr ){
+                            // Release, so the writer that frees the version sees every read done through it.
+                            m_version->readers.fetch_sub( 1, std::memory_order_release );
+                        }
+                    }
+
+                    /// The vector of this version.
+                    const vector_type & get( void ) const{ return m_version->data; }
+                    const vector_type & operator*( void ) const{ return m_version->data; }
+                    const vector_type * operator->( void ) const{ return &m_version->data; }
+
+                    const_iterator begin( void ) const{ return get().begin(); }
+                    const_iterator end( void ) const{ return get().end(); }
+                    size_type size( void ) const{ return get().size(); }
+                    bool empty( void ) const{ return get().empty(); }
+                    const T * data( void ) const{ return get().data(); }
+                    const_reference operator[]( size_type pos ) const{ return get()[pos]; }
+                    const_reference at( size_type pos ) const{ return get().at( pos ); }
+
+                private:
+                    friend class rcu_vector;
+                    explicit snapshot( Version * version ) : m_version{version}{ /* empty */ }
+
+                    Version * m_version = nullptr;      //!< The version held, with its reader count bumped.
+            };
+
+        public:
+            //=== [I] SPECIAL MEMBERS
+
+            /**
+             * @brief Construct a new rcu_vector object whose first version is 'init'.
+             *
+             * @param init The initial contents.
+             */
+            explicit rcu_vector( vector_type init = vector_type() )
+                : m_current{new Version( std::move( init ) )}
+            { /* empty */ }
+
+            rcu_vector( const rcu_vector & ) = delete;
+            rcu_vector & operator=( const rcu_vector & ) = delete;
+
+            /**
+             * @brief Destroy the rcu_vector object and every version. No snapshot may be left.
+             *
+             */
+            ~rcu_vector( void ){
+                delete m_current.load( std::memory_order_relaxed );
+                for( Version * v : m_retired ){
+                    delete v;
+                }
+            }
+
+            //=== [II] READERS
+
+            /**
+             * @brief Takes a snapshot of the current version. Lock-free, and it never waits for a writer.
+             *
+             * @return snapshot The snapshot.
+             */
+            snapshot read( void ) const{
+                size_type epoch = m_epoch.load( std::memory_order_seq_cst );
+                std::atomic<size_type> * window = &m_window[epoch & 1];
+                window->fetch_add( 1, std::memory_order_seq_cst );
+                // A writer may have moved on while we counted ourselves in, and the next one
+                // would not look at this window. Then start over on the new parity.
+                for( size_type now ; ( now = m_epoch.load( std::memory_order_seq_cst ) ) != epoch ; epoch = now ){
+                    window->fetch_sub( 1, std::memory_order_relaxed );
+                    window = &m_window[now & 1];
+                    window->fetch_add( 1, std::memory_order_seq_cst );
+                }
+                Version * version = m_current.load( std::memory_order_seq_cst );
+                version->readers.fetch_add( 1, std::memory_order_relaxed );
+                window->fetch_sub( 1, std::memory_order_release );
+                return snapshot( version );
+            }
+
+            //=== [III] WRITERS
+
+            /**
+             * @brief Publishes a copy of the current version changed by 'fn'.
+             *
+             * 'fn' gets the copy as a vector_type& and may change it in any way;
+             * readers see none of it until fn returns. If fn throws, nothing is
+             * published.
+             *
+             * @param fn The batch of changes.
+             */
+            template < typename Fn >
+            void update( Fn fn ){
+                std::lock_guard<std::mutex> lock{ m_write_mutex };
+                vector_type next( m_current.load( std::memory_order_relaxed )->data );
+                fn( next );
+                Publish( std::move( next ) );
+            }
+
+            /**
+             * @brief Publishes 'next' as the new version, without copying the current one.
+             *
+             * @param next The new contents.
+             */
+            void assign( vector_type next ){
+                std::lock_guard<std::mutex> lock{ m_write_mutex };
+                Publish( std::move( next ) );
+            }
+
+            /// Frees the retired versions that no snapshot holds any more.
+            void reclaim( void ){
+                std::lock_guard<std::mutex> lock{ m_write_mutex };
+                Reclaim();
+            }
+
+            /// Return how many retired versions are still waiting for their snapshots to go away.
+            size_type retired( void ) const{
+                std::lock_guard<std::mutex> lock{ m_write_mutex };
+                return m_retired.size();
+            }
+
+        private:
+            /// Swaps in 'next' and retires the old version. Holds m_write_mutex.
+            void Publish( vector_type && next ){
+                // Make room first: once 'fresh' is out, there is no taking it back.
+                m_retired.reserve( m_retired.size() + 1 );
+                Version * fresh = new Version( std::move( next ) );
+                Version * old = m_current.exchange( fresh, std::memory_order_seq_cst );
+                // Readers that come in from now on use the other window and will load 'fresh'.
+                // The ones counted in the old window may have loaded 'old' without counting
+                // themselves on it yet; once they are gone, old->readers is exact.
+                size_type parity = m_epoch.fetch_add( 1, std::memory_order_seq_cst ) & 1;
+                while( m_window[parity].load( std::memory_order_seq_cst ) != 0 ){
+                    std::this_thread::yield();
+                }
+                m_retired.push_back( old );
+                Reclaim();
+            }
+
+            /// Frees the retired versions without readers. Holds m_write_mutex.
+            void Reclaim( void ){
+                size_type kept{0};
+                for( size_type i{0} ; i < m_retired.size() ; ++i ){
+                    Version * v = m_retired[i];
+                    if( v->readers.load( std::memory_order_acquire ) == 0 ){
+                        delete v;
+                    }else{
+                        m_retired[kept++] = v;
+                    }
+                }
+                while( m_retired.size() > kept ){
+                    m_retired.pop_back();
+                }
+            }
+
+            std::atomic<Version *> m_current;                   //!< The version new snapshots get.
+            mutable std::atomic<size_type> m_window[2] = {};    //!< Readers between loading m_current and counting themselves on it, by epoch parity.
+            std::atomic<size_type> m_epoch{0};                  //!< Advanced by every publication.
+            vector<Version *> m_retired;                        //!< Replaced versions not freed yet.
+            mutable std::mutex m_write_mutex;                   //!< Serializes the writers.
+    };
+} // namespace sc.
+#endif
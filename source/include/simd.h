@@ -0,0 +1,474 @@
+#ifndef _SIMD_H_
+#define _SIMD_H_
+
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint64_t, std::uintptr_t
+#include <type_traits>  // std::integral_constant
+#include <cstring>      // std::memcmp, std::memcpy, std::memset
+
+#if defined(__AVX2__) && defined(__BMI2__)
+#include <immintrin.h>  // _mm256_permutevar8x32_epi32, _pdep_u64, _pext_u64
+#define SC_SIMD_AVX2 1
+#endif
+#if defined(__AVX__)
+#include <immintrin.h>  // _mm256_cmp_ps, _mm256_cmp_pd
+#define SC_SIMD_AVX 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>  // _mm_cmpneq_ps, _mm_cmpneq_pd
+#define SC_SIMD_SSE2 1
+#endif
+
+/// Sequence container namespace.
+namespace sc {
+    /// Data-parallel kernels used by the containers on arithmetic element types.
+    /*!
+     * Each kernel has a portable scalar version, written without branches in
+     * the inner loop, and a vectorized one that is compiled in when the target
+     * supports it (e.g. -mavx2 -mbmi2, or -march=native). Both give the same
+     * results.
+     */
+    namespace simd {
+        /// Scalar tail of compact(): copies every element forward and advances only past the kept ones.
+        template < typename T, typename Pred >
+        std::size_t CompactScalar( T * data, std::size_t i, std::size_t out, std::size_t n, Pred & pred ){
+            for( ; i < n ; ++i ){
+                T value = data[i];
+                data[out] = value;
+                out += !pred( value );
+            }
+            return out;
+        }
+
+#ifdef SC_SIMD_AVX2
+        /// Moves the 32-bit lanes of 'v' selected by the bits of 'keep' to the front, in order.
+        inline __m256i LeftPack( __m256i v, unsigned keep ){
+            // Spread each bit to a byte, gather the indices of the kept lanes, widen them to lane indices.
+            std::uint64_t bytes = _pdep_u64( keep, 0x0101010101010101ull ) * 0xFF;
+            std::uint64_t wanted = _pext_u64( 0x0706050403020100ull, bytes );
+            __m256i shuffle = _mm256_cvtepu8_epi32( _mm_cvtsi64_si128( static_cast<long long>( wanted ) ) );
+            return _mm256_permutevar8x32_epi32( v, shuffle );
+        }
+
+        /// AVX2 body of compact() for 4-byte elements: eight per step.
+        template < typename T, typename Pred >
+        std::size_t CompactVector( T * data, std::size_t n, Pred & pred, std::integral_constant< std::size_t, 4 > ){
+            std::size_t i{0}, out{0};
+            for( ; i + 8 <= n ; i += 8 ){
+                unsigned keep{0};
+                for( unsigned j{0} ; j < 8 ; ++j ){
+                    keep |= unsigned( !pred( data[i + j] ) ) << j;
+                }
+                __m256i v = _mm256_loadu_si256( reinterpret_cast<const __m256i *>( data + i ) );
+                _mm256_storeu_si256( reinterpret_cast<__m256i *>( data + out ), LeftPack( v, keep ) );
+                out += __builtin_popcount( keep );
+            }
+            return CompactScalar( data, i, out, n, pred );
+        }
+
+        /// AVX2 body of compact() for 8-byte elements: four per step, each one a pair of 32-bit lanes.
+        template < typename T, typename Pred >
+        std::size_t CompactVector( T * data, std::size_t n, Pred & pred, std::integral_constant< std::size_t, 8 > ){
+            std::size_t i{0}, out{0};
+            for( ; i + 4 <= n ; i += 4 ){
+                unsigned keep{0};
+                for( unsigned j{0} ; j < 4 ; ++j ){
+                    keep |= unsigned( !pred( data[i + j] ) ) << j;
+                }
+                __m256i v = _mm256_loadu_si256( reinterpret_cast<const __m256i *>( data + i ) );
+                unsigned lanes = static_cast<unsigned>( _pdep_u32( keep, 0x55 ) * 3 );
+                _mm256_storeu_si256( reinterpret_cast<__m256i *>( data + out ), LeftPack( v, lanes ) );
+                out += __builtin_popcount( keep );
+            }
+            return CompactScalar( data, i, out, n, pred );
+        }
+#endif
+
+        /// Other element sizes have no vector body.
+        template < typename T, typename Pred, std::size_t S >
+        std::size_t CompactVector( T * data, std::size_t n, Pred & pred, std::integral_constant< std::size_t, S > ){
+            return CompactScalar( data, 0, 0, n, pred );
+        }
+
+        /**
+         * @brief Stream compaction: removes the elements of [data, data+n) for which 'pred' holds,
+         * packing the others at the front in their original order.
+         * 'pred' is called exactly once per element, in order; which elements go is only known
+         * from its results, so the data movement is what gets vectorized.
+         *
+         * @tparam T An arithmetic type.
+         * @tparam Pred Unary predicate on T.
+         * @param data The elements.
+         * @param n Number of elements.
+         * @param pred Tells which elements to remove.
+         * @return std::size_t Number of elements kept.
+         */
+        template < typename T, typename Pred >
+        std::size_t compact( T * data, std::size_t n, Pred pred ){
+            return CompactVector( data, n, pred, std::integral_constant< std::size_t, sizeof( T ) >{} );
+        }
+
+        /**
+         * @brief Finds the first position where 'a' and 'b' are not equal, as by !(a[i] == b[i]).
+         * A NaN is unequal to everything, itself included.
+         *
+         * @tparam T Element type.
+         * @param a First array.
+         * @param b Second array.
+         * @param n Number of elements in each.
+         * @return std::size_t The first such position, or 'n' if there is none.
+         */
+        template < typename T >
+        std::size_t first_unequal( const T * a, const T * b, std::size_t n ){
+            std::size_t i{0};
+            while( i < n && a[i] == b[i] ){
+                ++i;
+            }
+            return i;
+        }
+
+        /**
+         * @brief Finds the first position where one of 'a' and 'b' is less than the other, which is
+         * where a lexicographic comparison with operator< is decided. Positions holding a NaN are
+         * skipped, as std::lexicographical_compare does, since NaN is neither less nor greater.
+         *
+         * @tparam T Element type.
+         * @param a First array.
+         * @param b Second array.
+         * @param n Number of elements in each.
+         * @return std::size_t The first such position, or 'n' if there is none.
+         */
+        template < typename T >
+        std::size_t first_ordered_unequal( const T * a, const T * b, std::size_t n ){
+            std::size_t i{0};
+            while( i < n && !( a[i] < b[i] ) && !( b[i] < a[i] ) ){
+                ++i;
+            }
+            return i;
+        }
+
+        /**
+         * @brief Finds the first position where the bytes of 'a' and 'b' differ, comparing whole
+         * blocks with memcmp and only then looking for the element inside the block.
+         *
+         * @tparam T Element type.
+         * @param a First array.
+         * @param b Second array.
+         * @param n Number of elements in each.
+         * @return std::size_t The first such position, or 'n' if there is none.
+         */
+        template < typename T >
+        std::size_t first_unequal_bytes( const T * a, const T * b, std::size_t n ){
+            const std::size_t block = sizeof( T ) >= 256 ? 1 : 256 / sizeof( T );
+            std::size_t i{0};
+            for( ; i + block <= n ; i += block ){
+                if( std::memcmp( a + i, b + i, block * sizeof( T ) ) != 0 ){
+                    break;
+                }
+            }
+            for( ; i < n ; ++i ){
+                if( std::memcmp( a + i, b + i, sizeof( T ) ) != 0 ){
+                    return i;
+                }
+            }
+            return n;
+        }
+
+#if defined(SC_SIMD_AVX) || defined(SC_SIMD_SSE2)
+        /// Packed comparisons of floats, one bit per lane in the returned mask.
+        struct FloatLanes
+        {
+            typedef float scalar;   //!< The element type.
+#ifdef SC_SIMD_AVX
+            static const std::size_t width = 8; //!< Elements per register.
+            static int Unequal( const float * a, const float * b ){
+                return _mm256_movemask_ps( _mm256_cmp_ps( _mm256_loadu_ps( a ), _mm256_loadu_ps( b ), _CMP_NEQ_UQ ) );
+            }
+            static int OrderedUnequal( const float * a, const float * b ){
+                return _mm256_movemask_ps( _mm256_cmp_ps( _mm256_loadu_ps( a ), _mm256_loadu_ps( b ), _CMP_NEQ_OQ ) );
+            }
+#else
+            static const std::size_t width = 4; //!< Elements per register.
+            static int Unequal( const float * a, const float * b ){
+                return _mm_movemask_ps( _mm_cmpneq_ps( _mm_loadu_ps( a ), _mm_loadu_ps( b ) ) );
+            }
+            static int OrderedUnequal( const float * a, const float * b ){
+                __m128 x = _mm_loadu_ps( a ), y = _mm_loadu_ps( b );
+                return _mm_movemask_ps( _mm_or_ps( _mm_cmplt_ps( x, y ), _mm_cmpgt_ps( x, y ) ) );
+            }
+#endif
+        };
+
+        /// Packed comparisons of doubles, one bit per lane in the returned mask.
+        struct DoubleLanes
+        {
+            typedef double scalar;  //!< The element type.
+#ifdef SC_SIMD_AVX
+            static const std::size_t width = 4; //!< Elements per register.
+            static int Unequal( const double * a, const double * b ){
+                return _mm256_movemask_pd( _mm256_cmp_pd( _mm256_loadu_pd( a ), _mm256_loadu_pd( b ), _CMP_NEQ_UQ ) );
+            }
+            static int OrderedUnequal( const double * a, const double * b ){
+                return _mm256_movemask_pd( _mm256_cmp_pd( _mm256_loadu_pd( a ), _mm256_loadu_pd( b ), _CMP_NEQ_OQ ) );
+            }
+#else
+            static const std::size_t width = 2; //!< Elements per register.
+            static int Unequal( const double * a, const double * b ){
+                return _mm_movemask_pd( _mm_cmpneq_pd( _mm_loadu_pd( a ), _mm_loadu_pd( b ) ) );
+            }
+            static int OrderedUnequal( const double * a, const double * b ){
+                __m128d x = _mm_loadu_pd( a ), y = _mm_loadu_pd( b );
+                return _mm_movemask_pd( _mm_or_pd( _mm_cmplt_pd( x, y ), _mm_cmpgt_pd( x, y ) ) );
+            }
+#endif
+        };
+
+        /// Vector body of first_unequal() for floating point lanes.
+        template < typename Lanes >
+        std::size_t FirstUnequalVector( const typename Lanes::scalar * a, const typename Lanes::scalar * b, std::size_t n ){
+            std::size_t i{0};
+            for( ; i + Lanes::width <= n ; i += Lanes::width ){
+                int mask = Lanes::Unequal( a + i, b + i );
+                if( mask != 0 ){
+                    return i + __builtin_ctz( mask );
+                }
+            }
+            return i + first_unequal< typename Lanes::scalar >( a + i, b + i, n - i );
+        }
+
+        /// Vector body of first_ordered_unequal() for floating point lanes.
+        template < typename Lanes >
+        std::size_t FirstOrderedUnequalVector( const typename Lanes::scalar * a, const typename Lanes::scalar * b, std::size_t n ){
+            std::size_t i{0};
+            for( ; i + Lanes::width <= n ; i += Lanes::width ){
+                int mask = Lanes::OrderedUnequal( a + i, b + i );
+                if( mask != 0 ){
+                    return i + __builtin_ctz( mask );
+                }
+            }
+            return i + first_ordered_unequal< typename Lanes::scalar >( a + i, b + i, n - i );
+        }
+
+        /// first_unequal() for floats, a register at a time.
+        inline std::size_t first_unequal( const float * a, const float * b, std::size_t n ){
+            return FirstUnequalVector< FloatLanes >( a, b, n );
+        }
+
+        /// first_unequal() for doubles, a register at a time.
+        inline std::size_t first_unequal( const double * a, const double * b, std::size_t n ){
+            return FirstUnequalVector< DoubleLanes >( a, b, n );
+        }
+
+        /// first_ordered_unequal() for floats, a register at a time.
+        inline std::size_t first_ordered_unequal( const float * a, const float * b, std::size_t n ){
+            return FirstOrderedUnequalVector< FloatLanes >( a, b, n );
+        }
+
+        /// first_ordered_unequal() for doubles, a register at a time.
+        inline std::size_t first_ordered_unequal( const double * a, const double * b, std::size_t n ){
+            return FirstOrderedUnequalVector< DoubleLanes >( a, b, n );
+        }
+#endif
+
+        /// Tells whether all the bytes of 'value' are the same, so that memset can write it.
+        template < typename T >
+        bool IsBytePattern( const T & value ){
+            unsigned char bytes[sizeof( T )];
+            std::memcpy( bytes, &value, sizeof( T ) );
+            for( std::size_t i{1} ; i < sizeof( T ) ; ++i ){
+                if( bytes[i] != bytes[0] ){
+                    return false;
+                }
+            }
+            return true;
+        }
+
+#if defined(SC_SIMD_AVX) || defined(SC_SIMD_SSE2)
+#ifdef SC_SIMD_AVX
+        typedef __m256i FillRegister;   //!< Widest integer register available.
+        inline FillRegister LoadFill( const unsigned char * p ){ return _mm256_loadu_si256( reinterpret_cast<const __m256i *>( p ) ); }
+        inline void StoreFill( void * p, FillRegister r ){ _mm256_storeu_si256( static_cast<__m256i *>( p ), r ); }
+        inline void StreamFill( void * p, FillRegister r ){ _mm256_stream_si256( static_cast<__m256i *>( p ), r ); }
+#else
+        typedef __m128i FillRegister;   //!< Widest integer register available.
+        inline FillRegister LoadFill( const unsigned char * p ){ return _mm_loadu_si128( reinterpret_cast<const __m128i *>( p ) ); }
+        inline void StoreFill( void * p, FillRegister r ){ _mm_storeu_si128( static_cast<__m128i *>( p ), r ); }
+        inline void StreamFill( void * p, FillRegister r ){ _mm_stream_si128( static_cast<__m128i *>( p ), r ); }
+#endif
+        /// Buffers at least this large are filled with non-temporal stores, which skip the cache.
+        const std::size_t stream_threshold = std::size_t( 4 ) << 20;
+
+        /// Vector body of fill(): broadcasts 'value' to a register and stores it a register at a time.
+        template < typename T >
+        void FillVector( T * dest, std::size_t n, const T & value ){
+            const std::size_t width = sizeof( FillRegister );
+            if( width % sizeof( T ) != 0 ){
+                for( std::size_t i{0} ; i < n ; ++i ){
+                    dest[i] = value;
+                }
+                return;
+            }
+            alignas( 32 ) unsigned char pattern[width];
+            for( std::size_t i{0} ; i < width ; i += sizeof( T ) ){
+                std::memcpy( pattern + i, &value, sizeof( T ) );
+            }
+            FillRegister r = LoadFill( pattern );
+            const std::size_t per = width / sizeof( T );
+            std::size_t i{0};
+            if( n * sizeof( T ) >= stream_threshold ){
+                // Reach a register boundary, stream the bulk, then finish with plain stores.
+                while( i < n && reinterpret_cast<std::uintptr_t>( dest + i ) % width != 0 ){
+                    dest[i++] = value;
+                }
+                if( reinterpret_cast<std::uintptr_t>( dest + i ) % width == 0 ){
+                    for( ; i + per <= n ; i += per ){
+                        StreamFill( dest + i, r );
+                    }
+                    _mm_sfence();
+                }
+            }
+            for( ; i + per <= n ; i += per ){
+                StoreFill( dest + i, r );
+            }
+            // Fewer than 'per' slots are left; the pattern has that many.
+            std::memcpy( static_cast<void *>( dest + i ), pattern, ( n - i ) * sizeof( T ) );
+        }
+#else
+        /// Without vector registers, fill() is a plain loop.
+        template < typename T >
+        void FillVector( T * dest, std::size_t n, const T & value ){
+            for( std::size_t i{0} ; i < n ; ++i ){
+                dest[i] = value;
+            }
+        }
+#endif
+
+        /**
+         * @brief Writes 'value' to every slot of [dest, dest+n). Values whose bytes are all equal
+         * (zero, -1, any char) go through memset; the others are broadcast to a vector register
+         * and stored a register at a time, with non-temporal stores for very large buffers.
+         *
+         * @tparam T An arithmetic type.
+         * @param dest The slots, live or raw.
+         * @param n Number of slots.
+         * @param value The value to write.
+         */
+        template < typename T >
+        void fill( T * dest, std::size_t n, T value ){
+            if( n == 0 ){
+                return;
+            }
+            if( IsBytePattern( value ) ){
+                unsigned char byte;
+                std::memcpy( &byte, &value, 1 );
+                std::memset( static_cast<void *>( dest ), byte, n * sizeof( T ) );
+                return;
+            }
+            FillVector( dest, n, value );
+        }
+
+        /// Number of bits set in 'word'.
+        inline std::size_t Popcount( std::uint64_t word ){
+#if defined(__GNUC__)
+            return __builtin_popcountll( word );
+#else
+            word = word - ( ( word >> 1 ) & 0x5555555555555555ULL );
+            word = ( word & 0x3333333333333333ULL ) + ( ( word >> 2 ) & 0x3333333333333333ULL );
+            word = ( word + ( word >> 4 ) ) & 0x0f0f0f0f0f0f0f0fULL;
+            return ( word * 0x0101010101010101ULL ) >> 56;
+#endif
+        }
+
+        /**
+         * @brief Counts the bits set in the 'n' words starting at 'words'. With AVX2 the bytes
+         * are counted four bits at a time with a shuffle lookup and summed with psadbw.
+         *
+         * @param words The bitmap.
+         * @param n Number of words.
+         * @return std::size_t The number of bits set.
+         */
+        inline std::size_t popcount_words( const std::uint64_t * words, std::size_t n ){
+            std::size_t i{0};
+            std::size_t total{0};
+#ifdef SC_SIMD_AVX2
+            const __m256i table = _mm256_setr_epi8( 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                                    0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 );
+            const __m256i low = _mm256_set1_epi8( 0x0f );
+            __m256i acc = _mm256_setzero_si256();
+            for( ; i + 4 <= n ; i += 4 ){
+                __m256i v = _mm256_loadu_si256( reinterpret_cast<const __m256i *>( words + i ) );
+                __m256i lo = _mm256_shuffle_epi8( table, _mm256_and_si256( v, low ) );
+                __m256i hi = _mm256_shuffle_epi8( table, _mm256_and_si256( _mm256_srli_epi16( v, 4 ), low ) );
+                acc = _mm256_add_epi64( acc, _mm256_sad_epu8( _mm256_add_epi8( lo, hi ), _mm256_setzero_si256() ) );
+            }
+            alignas( 32 ) std::uint64_t lanes[4];
+            _mm256_store_si256( reinterpret_cast<__m256i *>( lanes ), acc );
+            total = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+            for( ; i < n ; ++i ){
+                total += Popcount( words[i] );
+            }
+            return total;
+        }
+
+        /// dest &= src, one word (or register) at a time.
+        struct and_words_op {
+            static std::uint64_t scalar( std::uint64_t a, std::uint64_t b ){ return a & b; }
+#ifdef SC_SIMD_AVX
+            static __m256 wide( __m256 a, __m256 b ){ return _mm256_and_ps( a, b ); }
+#elif defined(SC_SIMD_SSE2)
+            static __m128i wide( __m128i a, __m128i b ){ return _mm_and_si128( a, b ); }
+#endif
+        };
+
+        /// dest |= src, one word (or register) at a time.
+        struct or_words_op {
+            static std::uint64_t scalar( std::uint64_t a, std::uint64_t b ){ return a | b; }
+#ifdef SC_SIMD_AVX
+            static __m256 wide( __m256 a, __m256 b ){ return _mm256_or_ps( a, b ); }
+#elif defined(SC_SIMD_SSE2)
+            static __m128i wide( __m128i a, __m128i b ){ return _mm_or_si128( a, b ); }
+#endif
+        };
+
+        /// dest ^= src, one word (or register) at a time.
+        struct xor_words_op {
+            static std::uint64_t scalar( std::uint64_t a, std::uint64_t b ){ return a ^ b; }
+#ifdef SC_SIMD_AVX
+            static __m256 wide( __m256 a, __m256 b ){ return _mm256_xor_ps( a, b ); }
+#elif defined(SC_SIMD_SSE2)
+            static __m128i wide( __m128i a, __m128i b ){ return _mm_xor_si128( a, b ); }
+#endif
+        };
+
+        /**
+         * @brief Combines the 'n' words at 'src' into the ones at 'dest' with Op, a register at a time.
+         * The float forms of the AVX bitwise instructions are used so that AVX2 is not required;
+         * they only move bits around.
+         *
+         * @param dest The words updated.
+         * @param src The other operand.
+         * @param n Number of words.
+         */
+        template < typename Op >
+        void bitwise_words( std::uint64_t * dest, const std::uint64_t * src, std::size_t n ){
+            std::size_t i{0};
+#ifdef SC_SIMD_AVX
+            for( ; i + 4 <= n ; i += 4 ){
+                __m256 a = _mm256_loadu_ps( reinterpret_cast<const float *>( dest + i ) );
+                __m256 b = _mm256_loadu_ps( reinterpret_cast<const float *>( src + i ) );
+                _mm256_storeu_ps( reinterpret_cast<float *>( dest + i ), Op::wide( a, b ) );
+            }
+#elif defined(SC_SIMD_SSE2)
+            for( ; i + 2 <= n ; i += 2 ){
+                __m128i a = _mm_loadu_si128( reinterpret_cast<const __m128i *>( dest + i ) );
+                __m128i b = _mm_loadu_si128( reinterpret_cast<const __m128i *>( src + i ) );
+                _mm_storeu_si128( reinterpret_cast<__m128i *>( dest + i ), Op::wide( a, b ) );
+            }
+#endif
+            for( ; i < n ; ++i ){
+                dest[i] = Op::scalar( dest[i], src[i] );
+            }
+        }
+    } // namespace simd.
+} // namespace sc.
+#endif
@@ -0,0 +1,346 @@
+#ifndef _SMALL_VECTOR_H_
+#define _SMALL_VECTOR_H_
+
+#include <cstddef>      // std::size_t
+#include <new>          // ::operator new, ::operator delete
+#include <initializer_list> // std::initializer_list
+#include <utility>      // std::move
+#include <type_traits>  // std::is_nothrow_move_constructible, std::enable_if, std::is_integral
+
+#include "vector.h"
+
+/// Sequence container namespace.
+namespace sc {
+    /// Raw, suitably aligned room for N objects of type T, plus a flag telling whether it is handed out.
+    template < typename T, std::size_t N >
+    struct inline_buffer
+    {
+        alignas(T) unsigned char bytes[N * sizeof(T)]; //!< The inline storage.
+        bool in_use = false;                            //!< Whether a container currently owns the bytes.
+    };
+
+    /// Allocator that serves requests of up to N objects from an inline_buffer and the rest from the heap.
+    /*!
+     * The buffer belongs to a single container, so two inline allocators only
+     * compare equal when they share the same buffer. They are never
+     * propagated, which makes a container keep its own buffer on assignment.
+     *
+     * \tparam T The type of the elements.
+     * \tparam N The number of elements that fit inline.
+     */
+    template < typename T, std::size_t N >
+    class inline_allocator
+    {
+        public:
+            using value_type = T;   //!< The value type.
+
+            /// Rebinding to another type is only meaningful for the heap part, so the buffer is dropped.
+            template < typename U >
+            struct rebind { using other = inline_allocator< U, N >; };
+
+            /**
+             * @brief Construct a new inline_allocator object that hands out 'buffer' when it can.
+             *
+             * @param buffer The inline buffer. It must outlive the allocator.
+             */
+            explicit inline_allocator( inline_buffer<T, N> * buffer = nullptr ) noexcept
+                : m_buffer{buffer}
+            { /* empty */ }
+
+            /**
+             * @brief Construct a new heap-only inline_allocator object from one of another type.
+             *
+             */
+            template < typename U >
+            explicit inline_allocator( const inline_allocator<U, N> & ) noexcept
+                : m_buffer{nullptr}
+            { /* empty */ }
+
+            /**
+             * @brief Allocates memory for 'n' objects of type T, from the inline buffer if it is free and large enough.
+             *
+             * @param n Number of objects.
+             * @return T* The uninitialized block.
+             */
+            T * allocate( std::size_t n ){
+                if( m_buffer != nullptr && n <= N && !m_buffer->in_use ){
+                    m_buffer->in_use = true;
+                    return reinterpret_cast<T *>( m_buffer->bytes );
+                }
+                return static_cast<T *>( ::operator new( n * sizeof( T ) ) );
+            }
+
+            /**
+             * @brief Releases a block obtained from allocate().
+             *
+             * @param p The block.
+             */
+            void deallocate( T * p, std::size_t ) noexcept{
+                if( is_inline( p ) ){
+                    m_buffer->in_use = false;
+                    return;
+                }
+                ::operator delete( p );
+            }
+
+            /**
+             * @brief Check whether 'p' is the start of this allocator's inline buffer.
+             *
+             * @param p A pointer.
+             * @return true If it is the inline buffer.
+             * @return false Otherwise.
+             */
+            bool is_inline( const T * p ) const noexcept{
+                return m_buffer != nullptr && p == reinterpret_cast<const T *>( m_buffer->bytes );
+            }
+
+            /**
+             * @brief Return the buffer behind this allocator.
+             *
+             * @return inline_buffer<T, N>*
+             */
+            inline_buffer<T, N> * buffer( void ) const noexcept{
+                return m_buffer;
+            }
+
+            /**
+             * @brief The buffer belongs to the container being copied, so a copy only gets the heap part.
+             * This is what a plain sc::vector copied out of a small_vector ends up with.
+             *
+             * @return inline_allocator A heap-only allocator.
+             */
+            inline_allocator select_on_container_copy_construction( void ) const noexcept{
+                return inline_allocator{};
+            }
+
+        private:
+            inline_buffer<T, N> * m_buffer; //!< The inline storage, or nullptr for heap only.
+    };
+
+    template < typename T, std::size_t N >
+    bool operator==( const inline_allocator<T, N> & lhs, const inline_allocator<T, N> & rhs ){
+        return lhs.buffer() == rhs.buffer();
+    }
+
+    template < typename T, std::size_t N >
+    bool operator!=( const inline_allocator<T, N> & lhs, const inline_allocator<T, N> & rhs ){
+        return !( lhs == rhs );
+    }
+
+    /// A vector that keeps up to N elements inside the object itself.
+    /*!
+     * sc::small_vector has the interface of sc::vector, and it starts out with
+     * capacity N backed by storage embedded in the object, so the first N
+     * insertions never touch the heap. Beyond N it spills to a heap block and
+     * grows geometrically, as sc::vector does; shrink_to_fit() moves the
+     * elements back inline once they fit again.
+     *
+     * Inline storage cannot change hands, so copying, moving and swapping
+     * inline small vectors move or copy the elements themselves. A small
+     * vector that spilled to the heap hands its block over on move, as
+     * sc::vector does.
+     *
+     * The constructors take an allocator like those of sc::vector, so that
+     * generic code can pass one along, but it is ignored: a small vector
+     * always allocates through its own inline buffer.
+     *
+     * \tparam T The type of the elements.
+     * \tparam N The number of elements that fit inline.
+     */
+    template < typename T, std::size_t N >
+    class small_vector : private inline_buffer<T, N>, public vector< T, inline_allocator<T, N> >
+    {
+        static_assert( N > 0, "sc::small_vector needs room for at least one inline element" );
+
+        //=== Aliases
+        public:
+            using base_type = vector< T, inline_allocator<T, N> >; //!< The underlying vector.
+            using size_type = typename base_type::size_type;        //!< The size type.
+            using value_type = T;                                    //!< The value type.
+            using allocator_type = inline_allocator<T, N>;           //!< The allocator type.
+
+        public:
+            //=== [I] SPECIAL MEMBERS
+
+            /**
+             * @brief Construct a new small_vector object with 'count' value-initialized elements.
+             *
+             * @param count Initial size, by default is 0.
+             */
+            explicit small_vector( size_type count = 0, const allocator_type & = allocator_type() )
+                : base_type( inline_allocator<T, N>{ this } )
+            {
+                this->reserve( count > N ? count : N );
+                for( size_type i{0} ; i < count ; ++i ){
+                    this->push_back( T() );
+                }
+            }
+
+            /**
+             * @brief Construct a new small_vector object with 'count' copies of 'value'.
+             *
+             * @param count Initial size.
+             * @param value Value of every element.
+             */
+            small_vector( size_type count, const T & value, const allocator_type & = allocator_type() )
+                : base_type( inline_allocator<T, N>{ this } )
+            {
+                this->reserve( count > N ? count : N );
+                for( size_type i{0} ; i < count ; ++i ){
+                    this->push_back( value );
+                }
+            }
+
+            /**
+             * @brief Construct a new empty small_vector object.
+             *
+             */
+            explicit small_vector( const allocator_type & )
+                : small_vector()
+            { /* empty */ }
+
+            /**
+             * @brief Construct a new small_vector object with a copy of each of the elements in 'init', in the same order.
+             *
+             * @param init An initializer_list object.
+             */
+            small_vector( std::initializer_list<T> init, const allocator_type & = allocator_type() )
+                : base_type( inline_allocator<T, N>{ this } )
+            {
+                this->reserve( N );
+                base_type::operator=( init );
+            }
+
+            /**
+             * @brief Construct a new small_vector object with the contents of the range [first, last).
+             *
+             * @tparam InputItr Input iterator type
+             * @param first Input iterator to the initial position in a range.
+             * @param last Input iterator to the final position in a range.
+             */
+            template < typename InputItr,
+                       typename = typename std::enable_if< !std::is_integral<InputItr>::value >::type >
+            small_vector( InputItr first, InputItr last, const allocator_type & = allocator_type() )
+                : base_type( inline_allocator<T, N>{ this } )
+            {
+                this->reserve( N );
+                for( ; first != last ; ++first ){
+                    this->push_back( *first );
+                }
+            }
+
+            /**
+             * @brief Construct a new small_vector object with a copy of each of the elements in 'other'.
+             *
+             * @param other Another small_vector object of the same type.
+             */
+            small_vector( const small_vector & other )
+                : base_type( inline_allocator<T, N>{ this } )
+            {
+                this->reserve( N );
+                base_type::operator=( other );
+            }
+
+            /**
+             * @brief Construct a new small_vector object by moving the elements of 'other', which is left empty.
+             * A heap block is taken over as is; inline elements are moved one by one.
+             *
+             * @param other Another small_vector object of the same type.
+             */
+            small_vector( small_vector && other ) noexcept( std::is_nothrow_move_constructible<T>::value )
+                : base_type( inline_allocator<T, N>{ this } )
+            {
+                if( !other.is_inline() ){
+                    TakeHeapBlock( other );
+                    return;
+                }
+                this->reserve( N );
+                base_type::operator=( std::move( other ) );
+            }
+
+            /**
+             * @brief Copies all the elements from 'rhs' into the small_vector.
+             *
+             * @param rhs A small_vector object of the same type.
+             * @return small_vector& always returns *this enabling things like a = b = c.
+             */
+            small_vector & operator=( const small_vector & rhs ){
+                base_type::operator=( rhs );
+                return *this;
+            }
+
+            /**
+             * @brief Moves all the elements from 'rhs' into the small_vector, leaving 'rhs' empty.
+             *
+             * @param rhs A small_vector object of the same type.
+             * @return small_vector& always returns *this enabling things like a = b = c.
+             */
+            small_vector & operator=( small_vector && rhs ) noexcept( std::is_nothrow_move_constructible<T>::value
+                                                                      && std::is_nothrow_move_assignable<T>::value ){
+                if( this != &rhs && !rhs.is_inline() ){
+                    TakeHeapBlock( rhs );
+                    return *this;
+                }
+                base_type::operator=( std::move( rhs ) );
+                return *this;
+            }
+
+            /**
+             * @brief Copies all the elements from 'init' into the small_vector.
+             *
+             * @param init An initializer_list object.
+             * @return small_vector& always returns *this enabling things like a = b = c.
+             */
+            small_vector & operator=( std::initializer_list<T> init ){
+                base_type::operator=( init );
+                return *this;
+            }
+
+            /**
+             * @brief Check whether the elements currently live in the inline storage.
+             *
+             * @return true If no heap block is in use.
+             * @return false Otherwise.
+             */
+            bool is_inline( void ) const{
+                return this->get_allocator().is_inline( this->data() - this->front_capacity() );
+            }
+
+            /**
+             * @brief Return the number of elements that fit without a heap allocation.
+             *
+             * @return size_type
+             */
+            static constexpr size_type inline_capacity( void ){
+                return N;
+            }
+
+        private:
+            /**
+             * @brief Takes over the heap block of 'other', which gets its own inline buffer back, empty.
+             * Any inline allocator can release a heap block, so the allocators stay where they are.
+             *
+             * @param other A small_vector that is not inline.
+             */
+            void TakeHeapBlock( small_vector & other ) noexcept{
+                this->StealStorage( other );
+                if( this->capacity() == 0 ){
+                    // 'other' had no block at all (an empty vector that was stolen from).
+                    this->reserve( N );
+                }
+                // The inline buffer of 'other' is free, so this cannot allocate from the heap.
+                other.reserve( N );
+            }
+
+        public:
+            friend void swap( small_vector & first_, small_vector & second_ )
+            {
+                // The inline buffers cannot change hands, so swap through a temporary.
+                small_vector tmp{ std::move( first_ ) };
+                first_ = std::move( second_ );
+                second_ = std::move( tmp );
+            }
+
+    };
+} // namespace sc.
+#endif
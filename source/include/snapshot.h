@@ -0,0 +1,471 @@
+#ifndef _SNAPSHOT_H_
+#define _SNAPSHOT_H_
+
+#include <cerrno>       // errno
+#include <cstddef>      // std::size_t, std::ptrdiff_t
+#include <cstdint>      // std::uint32_t, std::uint64_t
+#include <cstdio>       // std::rename, std::remove
+#include <cstdlib>      // mkstemp
+#include <cstring>      // std::memcpy, std::memcmp
+#include <stdexcept>    // std::out_of_range, std::length_error, std::runtime_error
+#include <string>       // std::string
+#include <system_error> // std::system_error, std::generic_category
+#include <type_traits>  // std::is_trivially_copyable
+#include <utility>      // std::swap
+
+#include <fcntl.h>      // open
+#include <sys/mman.h>   // mmap, munmap, madvise
+#include <sys/stat.h>   // fstat
+#include <sys/uio.h>    // writev
+#include <unistd.h>     // close, read, fsync, fchmod
+
+#include "vector.h"
+
+/// Sequence container namespace.
+namespace sc {
+    /// The header at the start of every snapshot file.
+    /*!
+     * A snapshot is this header, zero padding up to data_offset, and then
+     * count * element_size raw bytes. data_offset is a multiple of both
+     * the element alignment and of snapshot_alignment, so a mapped file can
+     * be read in place. The fields are in the byte order of the machine
+     * that wrote the file; byte_order tells which one it was.
+     */
+    struct snapshot_header
+    {
+        char magic[8];                  //!< "SCVECTOR", without terminator.
+        std::uint32_t version;          //!< Format version, snapshot_version.
+        std::uint32_t byte_order;       //!< snapshot_byte_order as written by the machine that saved the file.
+        std::uint64_t element_size;     //!< sizeof(T).
+        std::uint64_t element_align;    //!< alignof(T).
+        std::uint64_t count;            //!< Number of elements.
+        std::uint64_t data_offset;      //!< Where the elements start, from the start of the file.
+        std::uint64_t checksum;         //!< snapshot_checksum() of the elements.
+        std::uint64_t reserved;         //!< Zero.
+    };
+
+    static_assert( sizeof( snapshot_header ) == 64, "sc::snapshot_header must stay 64 bytes" );
+
+    const std::uint32_t snapshot_version = 1;               //!< Format version written by save().
+    const std::uint32_t snapshot_byte_order = 0x01020304;   //!< Reads back differently on a machine of the other endianness.
+    const std::size_t snapshot_alignment = 64;              //!< Minimum alignment of the elements in the file.
+
+    /**
+     * @brief A 64-bit checksum of 'bytes' bytes at 'data'.
+     *
+     * Four independent multiply-xor lanes over 8-byte words, so it runs at
+     * memory speed instead of one dependent multiply per byte.
+     *
+     * @param data The bytes.
+     * @param bytes How many.
+     * @return std::uint64_t The checksum.
+     */
+    inline std::uint64_t snapshot_checksum( const void * data, std::size_t bytes ){
+        const std::uint64_t prime = 0x100000001b3ULL;
+        const unsigned char * p = static_cast<const unsigned char *>( data );
+        std::uint64_t lanes[4] = { 0xcbf29ce484222325ULL, 0x84222325cbf29ce4ULL,
+                                   0x9ce484222325cbf2ULL, 0x2325cbf29ce48422ULL };
+        std::size_t i{0};
+        for( ; i + 32 <= bytes ; i += 32 ){
+            for( std::size_t l{0} ; l < 4 ; ++l ){
+                std::uint64_t w;
+                std::memcpy( &w, p + i + 8 * l, 8 );
+                lanes[l] = ( lanes[l] ^ w ) * prime;
+            }
+        }
+        std::uint64_t h = bytes;
+        for( std::size_t l{0} ; l < 4 ; ++l ){
+            h = ( h ^ lanes[l] ) * prime;
+            h ^= h >> 29;
+        }
+        for( ; i < bytes ; ++i ){
+            h = ( h ^ p[i] ) * prime;
+        }
+        return h;
+    }
+
+    template < typename T >
+    class snapshot_view;
+
+    template < typename T >
+    snapshot_view<T> load_view( const std::string & path, bool verify = false );
+
+    /// Read-only view of the elements of a snapshot file, mapped in place.
+    /*!
+     * Returned by load_view(). Nothing is read until an element is touched;
+     * the view owns the mapping and unmaps it when destroyed.
+     *
+     * \tparam T The type of the elements.
+     */
+    template < typename T >
+    class snapshot_view
+    {
+        //=== Aliases
+        public:
+            using size_type = std::size_t;              //!< The size type.
+            using difference_type = std::ptrdiff_t;     //!< The difference type.
+            using value_type = T;                       //!< The value type.
+            using const_pointer = const T *;            //!< Pointer to a const value in the view.
+            using const_reference = const T &;          //!< Const reference to a value in the view.
+            using const_iterator = const T *;           //!< The iterator: the elements are one array.
+            using iterator = const_iterator;            //!< Same as const_iterator, the view is read only.
+
+        public:
+            snapshot_view( void ) = default;
+            snapshot_view( const snapshot_view & ) = delete;
+            snapshot_view & operator=( const snapshot_view & ) = delete;
+
+            /**
+             * @brief Construct a new snapshot_view object that takes over the mapping of 'other', which is left empty.
+             *
+             * @param other Another snapshot_view object of the same type.
+             */
+            snapshot_view( snapshot_view && other ) noexcept{
+                swap( *this, other );
+            }
+
+            /**
+             * @brief Releases this view's mapping and takes over the one of 'rhs', which is left empty.
+             *
+             * @param rhs A snapshot_view object of the same type.
+             * @return snapshot_view& always returns *this enabling things like a = b = c.
+             */
+            snapshot_view & operator=( snapshot_view && rhs ) noexcept{
+                if( this != &rhs ){
+                    Unmap();
+                    swap( *this, rhs );
+                }
+                return *this;
+            }
+
+            ~snapshot_view( void ){ Unmap(); }
+
+            const_iterator begin( void ) const{ return m_data; }
+            const_iterator end( void ) const{ return m_data + m_size; }
+            const_iterator cbegin( void ) const{ return begin(); }
+            const_iterator cend( void ) const{ return end(); }
+
+            /// Return the number of elements.
+            size_type size( void ) const{ return m_size; }
+            /// Check whether there are no elements.
+            bool empty( void ) const{ return m_size == 0; }
+            const_pointer data( void ) const{ return m_data; }
+
+            const_reference operator[]( size_type pos ) const{ return m_data[pos]; }
+
+            /**
+             * @brief Return the element at 'pos', with bounds checking.
+             *
+             * @param pos Position of the element.
+             * @return const_reference
+             */
+            const_reference at( size_type pos ) const{
+                if( pos >= m_size ){
+                    throw std::out_of_range{"Posição Acessada Fora do Range"};
+                }
+                return m_data[pos];
+            }
+
+            const_reference front( void ) const{
+                if( empty() ){
+                    throw std::length_error ("[snapshot_view::front()]: vector vazio.");
+                }
+                return m_data[0];
+            }
+            const_reference back( void ) const{
+                if( empty() ){
+                    throw std::length_error ("[snapshot_view::back()]: vector vazio.");
+                }
+                return m_data[m_size - 1];
+            }
+
+            /// Reads every element and checks them against the checksum in the header.
+            bool verify( void ) const{
+                return snapshot_checksum( m_data, m_size * sizeof( T ) ) == m_checksum;
+            }
+
+            friend void swap( snapshot_view & first_, snapshot_view & second_ ) noexcept{
+                using std::swap;
+                swap( first_.m_map, second_.m_map );
+                swap( first_.m_map_bytes, second_.m_map_bytes );
+                swap( first_.m_data, second_.m_data );
+                swap( first_.m_size, second_.m_size );
+                swap( first_.m_checksum, second_.m_checksum );
+            }
+
+        private:
+            template < typename U >
+            friend snapshot_view<U> load_view( const std::string & path, bool verify );
+
+            void Unmap( void ){
+                if( m_map != nullptr ){
+                    ::munmap( m_map, m_map_bytes );
+                }
+                m_map = nullptr;
+                m_map_bytes = 0;
+                m_data = nullptr;
+                m_size = 0;
+            }
+
+            void * m_map = nullptr;             //!< The whole file, mapped.
+            std::size_t m_map_bytes = 0;        //!< Length of the mapping.
+            const T * m_data = nullptr;         //!< The elements, inside the mapping.
+            size_type m_size = 0;               //!< Number of elements.
+            std::uint64_t m_checksum = 0;       //!< Checksum from the header.
+    };
+
+    /// Where the elements of a snapshot of T start.
+    template < typename T >
+    std::size_t SnapshotDataOffset( void ){
+        std::size_t align = alignof( T ) > snapshot_alignment ? alignof( T ) : snapshot_alignment;
+        return ( sizeof( snapshot_header ) + align - 1 ) / align * align;
+    }
+
+    /// Throws unless 'header' describes a snapshot of T in a file of 'fileBytes' bytes.
+    template < typename T >
+    void CheckSnapshotHeader( const snapshot_header & header, std::size_t fileBytes, const std::string & path ){
+        std::string where = "[sc::snapshot]: " + path;
+        if( std::memcmp( header.magic, "SCVECTOR", 8 ) != 0 ){
+            throw std::runtime_error( where + " não é um snapshot." );
+        }
+        if( header.byte_order != snapshot_byte_order ){
+            throw std::runtime_error( where + " foi gravado numa máquina de outra ordem de bytes." );
+        }
+        if( header.version != snapshot_version ){
+            throw std::runtime_error( where + " tem uma versão desconhecida." );
+        }
+        if( header.element_size != sizeof( T ) || header.element_align != alignof( T ) ){
+            throw std::runtime_error( where + " guarda elementos de outro tipo." );
+        }
+        if( header.data_offset % alignof( T ) != 0 || header.data_offset < sizeof( snapshot_header )
+            || header.data_offset > fileBytes || ( fileBytes - header.data_offset ) / sizeof( T ) < header.count ){
+            throw std::runtime_error( where + " está truncado." );
+        }
+    }
+
+    /// Opens 'path' for reading and returns its descriptor and length.
+    inline int OpenSnapshot( const std::string & path, std::size_t & fileBytes ){
+        int fd = ::open( path.c_str(), O_RDONLY | O_CLOEXEC );
+        if( fd < 0 ){
+            throw std::system_error( errno, std::generic_category(), "[sc::snapshot]: não consegui abrir " + path );
+        }
+        struct stat info;
+        if( ::fstat( fd, &info ) != 0 ){
+            int error = errno;
+            ::close( fd );
+            throw std::system_error( error, std::generic_category(), "[sc::snapshot]: fstat falhou" );
+        }
+        fileBytes = static_cast<std::size_t>( info.st_size );
+        if( fileBytes < sizeof( snapshot_header ) ){
+            ::close( fd );
+            throw std::runtime_error( "[sc::snapshot]: " + path + " não é um snapshot." );
+        }
+        return fd;
+    }
+
+    /// Reads exactly 'bytes' bytes, retrying short reads.
+    inline bool ReadAll( int fd, void * dest, std::size_t bytes ){
+        char * p = static_cast<char *>( dest );
+        while( bytes > 0 ){
+            ssize_t got = ::read( fd, p, bytes );
+            if( got < 0 && errno == EINTR ){
+                continue;
+            }
+            if( got <= 0 ){
+                return false;
+            }
+            p += got;
+            bytes -= static_cast<std::size_t>( got );
+        }
+        return true;
+    }
+
+    /// Creates a file with a fresh name next to 'path' and returns its descriptor; 'tmp' gets the name.
+    inline int CreateSnapshotTemp( const std::string & path, std::string & tmp ){
+        tmp = path + ".XXXXXX";
+        int fd = ::mkstemp( &tmp[0] );
+        if( fd < 0 ){
+            throw std::system_error( errno, std::generic_category(), "[sc::save()]: não consegui criar um arquivo temporário para " + path );
+        }
+        // mkstemp() creates the file private to the owner; a snapshot is readable like any other file.
+        if( ::fcntl( fd, F_SETFD, FD_CLOEXEC ) != 0 || ::fchmod( fd, 0644 ) != 0 ){
+            int error = errno;
+            ::close( fd );
+            std::remove( tmp.c_str() );
+            throw std::system_error( error, std::generic_category(), "[sc::save()]: não consegui preparar " + tmp );
+        }
+        return fd;
+    }
+
+    /// Flushes the directory that holds 'path', so that a rename into it survives a crash. Returns errno or 0.
+    inline int SyncSnapshotDirectory( const std::string & path ){
+        std::string::size_type slash = path.rfind( '/' );
+        std::string dir = slash == std::string::npos ? std::string( "." ) : path.substr( 0, slash == 0 ? 1 : slash );
+        int fd = ::open( dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC );
+        if( fd < 0 ){
+            return errno;
+        }
+        int error = ::fsync( fd ) != 0 ? errno : 0;
+        ::close( fd );
+        return error;
+    }
+
+    /**
+     * @brief Writes the elements of 'vec' to a snapshot file at 'path'.
+     *
+     * The header, the padding and the elements go out in a single writev()
+     * call (repeated only if the kernel writes less). The file is written
+     * under a unique temporary name in the same directory and renamed over
+     * 'path' once complete, so readers never see half a snapshot and two
+     * concurrent saves do not write into the same file. The directory is
+     * synced after the rename, so the new name survives a crash too.
+     *
+     * @param vec The vector.
+     * @param path Path of the file.
+     */
+    template < typename T, typename Alloc, typename Growth >
+    void save( const vector<T, Alloc, Growth> & vec, const std::string & path ){
+        static_assert( std::is_trivially_copyable<T>::value, "sc::save needs a trivially copyable type" );
+
+        std::size_t bytes = vec.size() * sizeof( T );
+        snapshot_header header;
+        std::memset( &header, 0, sizeof( header ) );
+        std::memcpy( header.magic, "SCVECTOR", 8 );
+        header.version = snapshot_version;
+        header.byte_order = snapshot_byte_order;
+        header.element_size = sizeof( T );
+        header.element_align = alignof( T );
+        header.count = vec.size();
+        header.data_offset = SnapshotDataOffset<T>();
+        header.checksum = snapshot_checksum( vec.data(), bytes );
+
+        vector<char> head( header.data_offset, char( 0 ) );
+        std::memcpy( head.data(), &header, sizeof( header ) );
+
+        std::string tmp;
+        int fd = CreateSnapshotTemp( path, tmp );
+        struct iovec parts[2];
+        parts[0].iov_base = head.data();
+        parts[0].iov_len = head.size();
+        parts[1].iov_base = const_cast<T *>( vec.data() );
+        parts[1].iov_len = bytes;
+        int first{0};
+        int error{0};
+        while( first < 2 ){
+            ssize_t wrote = ::writev( fd, parts + first, 2 - first );
+            if( wrote < 0 ){
+                if( errno == EINTR ){
+                    continue;
+                }
+                error = errno;
+                break;
+            }
+            std::size_t left = static_cast<std::size_t>( wrote );
+            while( first < 2 && left >= parts[first].iov_len ){
+                left -= parts[first].iov_len;
+                ++first;
+            }
+            if( first < 2 ){
+                parts[first].iov_base = static_cast<char *>( parts[first].iov_base ) + left;
+                parts[first].iov_len -= left;
+            }
+        }
+        if( error == 0 && ::fsync( fd ) != 0 ){
+            error = errno;
+        }
+        if( ::close( fd ) != 0 && error == 0 ){
+            error = errno;
+        }
+        if( error == 0 && std::rename( tmp.c_str(), path.c_str() ) != 0 ){
+            error = errno;
+        }
+        if( error != 0 ){
+            std::remove( tmp.c_str() );
+            throw std::system_error( error, std::generic_category(), "[sc::save()]: não consegui gravar " + path );
+        }
+        error = SyncSnapshotDirectory( path );
+        if( error != 0 ){
+            throw std::system_error( error, std::generic_category(), "[sc::save()]: fsync do diretório de " + path + " falhou" );
+        }
+    }
+
+    /**
+     * @brief Maps the snapshot at 'path' and returns a read-only view of its elements, without copying them.
+     *
+     * The header is always checked. The checksum needs every page read, so
+     * it is only checked when 'verify' is set; snapshot_view::verify() can
+     * check it later.
+     *
+     * @param path Path of the file.
+     * @param verify Whether to check the elements against the checksum now.
+     * @return snapshot_view<T> The view.
+     */
+    template < typename T >
+    snapshot_view<T> load_view( const std::string & path, bool verify ){
+        static_assert( std::is_trivially_copyable<T>::value, "sc::load_view needs a trivially copyable type" );
+
+        std::size_t fileBytes{0};
+        int fd = OpenSnapshot( path, fileBytes );
+        void * map = ::mmap( nullptr, fileBytes, PROT_READ, MAP_SHARED, fd, 0 );
+        int error = map == MAP_FAILED ? errno : 0;
+        ::close( fd );
+        if( error != 0 ){
+            throw std::system_error( error, std::generic_category(), "[sc::load_view()]: mmap falhou" );
+        }
+
+        snapshot_view<T> view;
+        view.m_map = map;
+        view.m_map_bytes = fileBytes;
+        snapshot_header header;
+        std::memcpy( &header, map, sizeof( header ) );
+        CheckSnapshotHeader<T>( header, fileBytes, path );
+        view.m_data = reinterpret_cast<const T *>( static_cast<const char *>( map ) + header.data_offset );
+        view.m_size = static_cast<std::size_t>( header.count );
+        view.m_checksum = header.checksum;
+        if( verify && !view.verify() ){
+            throw std::runtime_error( "[sc::load_view()]: o checksum de " + path + " não confere." );
+        }
+        return view;
+    }
+
+    /**
+     * @brief Reads the snapshot at 'path' into a new vector, checking the checksum.
+     *
+     * @param path Path of the file.
+     * @return vector<T> The elements.
+     */
+    template < typename T >
+    vector<T> load( const std::string & path ){
+        static_assert( std::is_trivially_copyable<T>::value, "sc::load needs a trivially copyable type" );
+
+        std::size_t fileBytes{0};
+        int fd = OpenSnapshot( path, fileBytes );
+        snapshot_header header;
+        try{
+            if( !ReadAll( fd, &header, sizeof( header ) ) ){
+                throw std::runtime_error( "[sc::load()]: não consegui ler " + path );
+            }
+            CheckSnapshotHeader<T>( header, fileBytes, path );
+        }catch(...){
+            ::close( fd );
+            throw;
+        }
+        vector<T> result;
+        try{
+            result = vector<T>( static_cast<std::size_t>( header.count ) );
+            if( ::lseek( fd, static_cast<off_t>( header.data_offset ), SEEK_SET ) < 0
+                || !ReadAll( fd, result.data(), result.size() * sizeof( T ) ) ){
+                throw std::runtime_error( "[sc::load()]: não consegui ler " + path );
+            }
+        }catch(...){
+            ::close( fd );
+            throw;
+        }
+        ::close( fd );
+        if( snapshot_checksum( result.data(), result.size() * sizeof( T ) ) != header.checksum ){
+            throw std::runtime_error( "[sc::load()]: o checksum de " + path + " não confere." );
+        }
+        return result;
+    }
+} // namespace sc.
+#endif
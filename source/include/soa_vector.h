@@ -0,0 +1,581 @@
+#ifndef _SOA_VECTOR_H_
+#define _SOA_VECTOR_H_
+
+#include <cstddef>      // std::size_t, std::ptrdiff_t
+#include <cstdint>      // std::uintptr_t
+#include <cstring>      // std::memcpy
+#include <iterator>     // std::random_access_iterator_tag
+#include <new>          // ::operator new, ::operator delete
+#include <stdexcept>    // std::out_of_range, std::length_error
+#include <tuple>        // std::tuple, std::tuple_element, std::get
+#include <type_traits>  // std::integral_constant, std::conditional
+#include <utility>      // std::move, std::move_if_noexcept, std::forward, std::swap
+
+#include "growth.h"
+#include "vector.h"
+
+/// Sequence container namespace.
+namespace sc {
+    /// A compile-time list of indices, used to walk the columns of a soa_vector.
+    template < std::size_t... I >
+    struct IndexList {};
+
+    /// Builds IndexList< 0, 1, ..., N-1 >.
+    template < std::size_t N, std::size_t... I >
+    struct MakeIndexList : MakeIndexList< N - 1, N - 1, I... > {};
+
+    template < std::size_t... I >
+    struct MakeIndexList< 0, I... > { using type = IndexList< I... >; };
+
+    /// A compile-time list of flags, used to check a property of every column.
+    template < bool... B >
+    struct FlagList {};
+
+    /// True when every flag in B is true.
+    template < bool... B >
+    struct AllOf : std::is_same< FlagList< true, B... >, FlagList< B..., true > > {};
+
+    /// A contiguous column of a soa_vector: a pointer and a length, usable in range-for loops.
+    template < typename T >
+    class soa_column
+    {
+        public:
+            using value_type = typename std::remove_cv<T>::type;    //!< The value type.
+            using size_type = std::size_t;                          //!< The size type.
+
+            soa_column( T * data, size_type size ) : m_data{data}, m_size{size} { /* empty */ }
+
+            T * data( void ) const{ return m_data; }
+            size_type size( void ) const{ return m_size; }
+            bool empty( void ) const{ return m_size == 0; }
+            T * begin( void ) const{ return m_data; }
+            T * end( void ) const{ return m_data + m_size; }
+            T & operator[]( size_type i ) const{ return m_data[i]; }
+
+        private:
+            T * m_data;         //!< The first element of the column.
+            size_type m_size;   //!< The number of elements.
+    };
+
+    /// Random access iterator over the rows of a soa_vector; dereferencing yields a tuple of references.
+    template < typename Container, typename Row >
+    class soa_iterator
+    {
+        public:
+            using iterator_category = std::random_access_iterator_tag; //!< Iterator category.
+            using value_type = typename Container::value_type;          //!< A row, by value.
+            using difference_type = std::ptrdiff_t;                     //!< Difference type used to calculated distance between iterators.
+            using pointer = void;                                       //!< Rows have no address.
+            using reference = Row;                                      //!< A tuple of references to the fields.
+
+            soa_iterator( void ) = default;
+            soa_iterator( Container * owner, std::size_t index ) : m_owner{owner}, m_index{index} { /* empty */ }
+
+            /// Converts an iterator into a const iterator.
+            template < typename C, typename R,
+                       typename = typename std::enable_if< std::is_convertible< C *, Container * >::value >::type >
+            soa_iterator( const soa_iterator<C, R> & other ) : m_owner{other.m_owner}, m_index{other.m_index} { /* empty */ }
+
+            reference operator*( void ) const{ return ( *m_owner )[m_index]; }
+            reference operator[]( difference_type n ) const{ return ( *m_owner )[m_index + n]; }
+
+            soa_iterator & operator++( void ){ ++m_index; return *this; }
+            soa_iterator operator++( int ){ soa_iterator tmp{*this}; ++m_index; return tmp; }
+            soa_iterator & operator--( void ){ --m_index; return *this; }
+            soa_iterator operator--( int ){ soa_iterator tmp{*this}; --m_index; return tmp; }
+            soa_iterator & operator+=( difference_type n ){ m_index += n; return *this; }
+            soa_iterator & operator-=( difference_type n ){ m_index -= n; return *this; }
+
+            friend soa_iterator operator+( soa_iterator it, difference_type n ){ return it += n; }
+            friend soa_iterator operator+( difference_type n, soa_iterator it ){ return it += n; }
+            friend soa_iterator operator-( soa_iterator it, difference_type n ){ return it -= n; }
+            friend difference_type operator-( const soa_iterator & lhs, const soa_iterator & rhs ){
+                return difference_type( lhs.m_index ) - difference_type( rhs.m_index );
+            }
+
+            friend bool operator==( const soa_iterator & lhs, const soa_iterator & rhs ){ return lhs.m_index == rhs.m_index; }
+            friend bool operator!=( const soa_iterator & lhs, const soa_iterator & rhs ){ return lhs.m_index != rhs.m_index; }
+            friend bool operator<( const soa_iterator & lhs, const soa_iterator & rhs ){ return lhs.m_index < rhs.m_index; }
+            friend bool operator>( const soa_iterator & lhs, const soa_iterator & rhs ){ return lhs.m_index > rhs.m_index; }
+            friend bool operator<=( const soa_iterator & lhs, const soa_iterator & rhs ){ return lhs.m_index <= rhs.m_index; }
+            friend bool operator>=( const soa_iterator & lhs, const soa_iterator & rhs ){ return lhs.m_index >= rhs.m_index; }
+
+        private:
+            template < typename C, typename R >
+            friend class soa_iterator;
+
+            Container * m_owner = nullptr;  //!< The container iterated over.
+            std::size_t m_index = 0;        //!< The row.
+    };
+
+    /// A sequence of rows stored as a structure of arrays: one contiguous column per field.
+    /*!
+     * soa_vector< float, float, int > holds rows of three fields, but keeps
+     * all the first fields together, then all the second ones, and so on. A
+     * loop that reads two fields streams through two dense columns instead of
+     * dragging whole records through the cache, and each column can be
+     * handed to SIMD code through data<I>() or column<I>().
+     *
+     * All columns share the size and the capacity, and live in a single
+     * allocation, each starting on a 64-byte boundary. They grow together,
+     * doubling the capacity like sc::vector; trivially relocatable columns
+     * are moved with memcpy.
+     *
+     * Rows are reached as tuples of references, through operator[] and the
+     * row iterator; std::get<I>( row ) is the field I of that row.
+     *
+     * \tparam Ts The types of the fields, one per column.
+     */
+    template < typename... Ts >
+    class soa_vector
+    {
+        static_assert( sizeof...( Ts ) > 0, "sc::soa_vector needs at least one column" );
+
+        using indices = typename MakeIndexList< sizeof...( Ts ) >::type;
+
+        /// Whether every column can be relocated without a step that may throw.
+        using nothrow_relocation = AllOf< ( is_trivially_relocatable<Ts>::value || std::is_nothrow_move_constructible<Ts>::value )... >;
+
+        //=== Aliases
+        public:
+            using size_type = std::size_t;                      //!< The size type.
+            using difference_type = std::ptrdiff_t;             //!< The difference type.
+            using value_type = std::tuple< Ts... >;             //!< A row, by value.
+            using reference = std::tuple< Ts &... >;            //!< References to the fields of a row.
+            using const_reference = std::tuple< const Ts &... >; //!< Const references to the fields of a row.
+            using iterator = soa_iterator< soa_vector, reference >;                   //!< The row iterator.
+            using const_iterator = soa_iterator< const soa_vector, const_reference >; //!< The const row iterator.
+
+            /// The type of the fields in column I.
+            template < std::size_t I >
+            using column_type = typename std::tuple_element< I, value_type >::type;
+
+            static const std::size_t column_alignment = 64;     //!< Every column starts on a multiple of this, in bytes.
+
+        public:
+            //=== [I] SPECIAL MEMBERS
+
+            /**
+             * @brief Construct a new empty soa_vector object.
+             *
+             */
+            soa_vector( void ) = default;
+
+            /**
+             * @brief Construct a new soa_vector object with 'count' value-initialized rows.
+             *
+             * @param count Initial size.
+             */
+            explicit soa_vector( size_type count ){
+                reserve( count );
+                for( size_type i{0} ; i < count ; ++i ){
+                    emplace_back( Ts()... );
+                }
+            }
+
+            /**
+             * @brief Construct a new soa_vector object with a copy of each of the rows in 'other'.
+             *
+             * @param other Another soa_vector object of the same type.
+             */
+            soa_vector( const soa_vector & other ){
+                reserve( other.size() );
+                try{
+                    for( size_type i{0} ; i < other.size() ; ++i ){
+                        CopyRow( other, i, indices{} );
+                    }
+                }catch(...){
+                    clear();
+                    Release();
+                    throw;
+                }
+            }
+
+            /**
+             * @brief Construct a new soa_vector object that takes over the block of 'other', which is left empty.
+             *
+             * @param other Another soa_vector object of the same type.
+             */
+            soa_vector( soa_vector && other ) noexcept
+                : m_block{other.m_block}, m_columns{other.m_columns}, m_size{other.m_size}, m_capacity{other.m_capacity}
+            {
+                other.m_block = nullptr;
+                other.m_columns = std::tuple< Ts*... >{};
+                other.m_size = 0;
+                other.m_capacity = 0;
+            }
+
+            /**
+             * @brief Destroy the soa_vector object.
+             *
+             */
+            ~soa_vector( void ){
+                clear();
+                Release();
+            }
+
+            /**
+             * @brief Copies all the rows from 'rhs'.
+             *
+             * @param rhs A soa_vector object of the same type.
+             * @return soa_vector& always returns *this enabling things like a = b = c.
+             */
+            soa_vector & operator=( const soa_vector & rhs ){
+                if( this != &rhs ){
+                    soa_vector tmp{ rhs };
+                    swap( *this, tmp );
+                }
+                return *this;
+            }
+
+            /**
+             * @brief Takes over the block of 'rhs', leaving it empty.
+             *
+             * @param rhs A soa_vector object of the same type.
+             * @return soa_vector& always returns *this enabling things like a = b = c.
+             */
+            soa_vector & operator=( soa_vector && rhs ) noexcept{
+                if( this != &rhs ){
+                    clear();
+                    Release();
+                    swap( *this, rhs );
+                }
+                return *this;
+            }
+
+            //=== [II] ITERATORS
+
+            iterator begin( void ){ return iterator( this, 0 ); }
+            iterator end( void ){ return iterator( this, m_size ); }
+            const_iterator begin( void ) const{ return const_iterator( this, 0 ); }
+            const_iterator end( void ) const{ return const_iterator( this, m_size ); }
+            const_iterator cbegin( void ) const{ return begin(); }
+            const_iterator cend( void ) const{ return end(); }
+
+            //=== [III] CAPACITY
+
+            /// Return the number of rows.
+            size_type size( void ) const{ return m_size; }
+            /// Check whether there are no rows.
+            bool empty( void ) const{ return m_size == 0; }
+            /// Return how many rows fit before the columns grow.
+            size_type capacity( void ) const{ return m_capacity; }
+            /// Return the number of columns.
+            static constexpr size_type columns( void ){ return sizeof...( Ts ); }
+
+            /**
+             * @brief Makes room for at least 'n' rows, moving every column into one new block.
+             *
+             * @param n Number of rows.
+             */
+            void reserve( size_type n ){
+                if( n > m_capacity ){
+                    Relocate( n );
+                }
+            }
+
+            /// Releases the unused capacity.
+            void shrink_to_fit( void ){
+                if( m_size < m_capacity ){
+                    Relocate( m_size );
+                }
+            }
+
+            //=== [IV] MODIFIERS
+
+            /// Removes every row, keeping the capacity.
+            void clear( void ){
+                DestroyRows( 0, m_size, indices{} );
+                m_size = 0;
+            }
+
+            /**
+             * @brief Appends a row with a copy of each field.
+             *
+             * @param values One value per column.
+             */
+            void push_back( const Ts &... values ){
+                emplace_back( values... );
+            }
+
+            /**
+             * @brief Appends a row, moving each field in.
+             *
+             * @param values One value per column.
+             */
+            void push_back( Ts &&... values ){
+                emplace_back( std::move( values )... );
+            }
+
+            /**
+             * @brief Appends a row whose field I is built from args[I], in place.
+             * If one field throws, the ones already built are destroyed.
+             *
+             * @param args One constructor argument per column.
+             */
+            template < typename... Args >
+            void emplace_back( Args&&... args ){
+                static_assert( sizeof...( Args ) == sizeof...( Ts ), "sc::soa_vector::emplace_back() takes one argument per column" );
+                if( m_size == m_capacity ){
+                    // The arguments may be fields of this vector, so the row is built in the new block first.
+                    Relocate( double_growth::grow( m_capacity, m_size + 1, RowBytes() ), std::forward<Args>( args )... );
+                    return;
+                }
+                size_type built{0};
+                try{
+                    EmplaceFields( m_columns, m_size, built, indices{}, std::forward<Args>( args )... );
+                }catch(...){
+                    DestroyFields( m_columns, m_size, built, indices{} );
+                    throw;
+                }
+                ++m_size;
+            }
+
+            /// Removes the last row.
+            void pop_back( void ){
+                if( empty() ){
+                    throw std::length_error ("[soa_vector::pop_back()]: não posso remover um elemento de um vector vazio.");
+                }
+                --m_size;
+                DestroyRows( m_size, m_size + 1, indices{} );
+            }
+
+            //=== [V] ELEMENT ACCESS
+
+            /// Return references to the fields of row 'pos'.
+            reference operator[]( size_type pos ){ return Row<reference>( pos, indices{} ); }
+            /// Return const references to the fields of row 'pos'.
+            const_reference operator[]( size_type pos ) const{ return Row<const_reference>( pos, indices{} ); }
+
+            /**
+             * @brief Return references to the fields of row 'pos', with bounds checking.
+             *
+             * @param pos The row.
+             * @return reference
+             */
+            reference at( size_type pos ){
+                if( pos >= m_size ){
+                    throw std::out_of_range{"Posição Acessada Fora do Range"};
+                }
+                return ( *this )[pos];
+            }
+
+            /**
+             * @brief Return const references to the fields of row 'pos', with bounds checking.
+             *
+             * @param pos The row.
+             * @return const_reference
+             */
+            const_reference at( size_type pos ) const{
+                if( pos >= m_size ){
+                    throw std::out_of_range{"Posição Acessada Fora do Range"};
+                }
+                return ( *this )[pos];
+            }
+
+            /// Return field I of row 'pos'.
+            template < std::size_t I >
+            column_type<I> & get( size_type pos ){ return std::get<I>( m_columns )[pos]; }
+            /// Return field I of row 'pos'.
+            template < std::size_t I >
+            const column_type<I> & get( size_type pos ) const{ return std::get<I>( m_columns )[pos]; }
+
+            /// Return the first element of column I; the column is contiguous and 64-byte aligned.
+            template < std::size_t I >
+            column_type<I> * data( void ){ return std::get<I>( m_columns ); }
+            /// Return the first element of column I; the column is contiguous and 64-byte aligned.
+            template < std::size_t I >
+            const column_type<I> * data( void ) const{ return std::get<I>( m_columns ); }
+
+            /// Return column I as a range of size() elements.
+            template < std::size_t I >
+            soa_column< column_type<I> > column( void ){ return { data<I>(), m_size }; }
+            /// Return column I as a range of size() elements.
+            template < std::size_t I >
+            soa_column< const column_type<I> > column( void ) const{ return { data<I>(), m_size }; }
+
+            friend void swap( soa_vector & first_, soa_vector & second_ ) noexcept{
+                using std::swap;
+                swap( first_.m_block, second_.m_block );
+                swap( first_.m_columns, second_.m_columns );
+                swap( first_.m_size, second_.m_size );
+                swap( first_.m_capacity, second_.m_capacity );
+            }
+
+        private:
+            /// Expands to nothing; lets a pack expansion run an expression per column, in order.
+            using Swallow = int[];
+
+            /// Bytes taken by one row, over all columns.
+            static size_type RowBytes( void ){
+                size_type total{0};
+                (void)Swallow{ 0, ( total += sizeof( Ts ), 0 )... };
+                return total;
+            }
+
+            /// Rounds 'bytes' up to a multiple of column_alignment.
+            static size_type AlignUp( size_type bytes ){
+                return ( bytes + column_alignment - 1 ) & ~( column_alignment - 1 );
+            }
+
+            template < typename R, std::size_t... I >
+            R Row( size_type pos, IndexList< I... > ) const{
+                return R( std::get<I>( m_columns )[pos]... );
+            }
+
+            template < std::size_t... I >
+            void CopyRow( const soa_vector & other, size_type pos, IndexList< I... > ){
+                emplace_back( std::get<I>( other.m_columns )[pos]... );
+            }
+
+            /// Builds field I of row 'pos' of 'columns' from args[I], counting in 'built' the fields done.
+            template < std::size_t... I, typename... Args >
+            static void EmplaceFields( std::tuple< Ts*... > & columns, size_type pos, size_type & built, IndexList< I... >, Args&&... args ){
+                (void)Swallow{ 0, ( ::new ( static_cast<void *>( std::get<I>( columns ) + pos ) ) Ts( std::forward<Args>( args ) ), ++built, 0 )... };
+            }
+
+            /// Destroys the fields of row 'pos' of 'columns' in the first 'built' columns.
+            template < std::size_t... I >
+            static void DestroyFields( std::tuple< Ts*... > & columns, size_type pos, size_type built, IndexList< I... > ){
+                (void)Swallow{ 0, ( I < built ? std::get<I>( columns )[pos].~Ts() : void(), 0 )... };
+            }
+
+            /// Destroys rows [first, last) in every column.
+            template < std::size_t... I >
+            void DestroyRows( size_type first, size_type last, IndexList< I... > ){
+                (void)Swallow{ 0, ( DestroyColumn( std::get<I>( m_columns ), first, last ), 0 )... };
+            }
+
+            template < typename T >
+            static void DestroyColumn( T * column, size_type first, size_type last ){
+                for( size_type i{first} ; i < last ; ++i ){
+                    column[i].~T();
+                }
+            }
+
+            /**
+             * @brief Moves every column into one new block for 'newCapacity' rows. Given 'args', the
+             * row at size() is first built from them in the new block, so they may refer to fields
+             * of this vector. If anything throws, the new block is dropped and the vector is left as
+             * it was. For that to hold, when any column cannot be moved without throwing, every column
+             * that is not trivially relocatable is copied: a column already moved could not be given back.
+             *
+             * @param newCapacity The new capacity, more than size() when a row is added.
+             * @param args Nothing, or one constructor argument per column for the new row.
+             */
+            template < typename... Args >
+            void Relocate( size_type newCapacity, Args&&... args ){
+                unsigned char * block = nullptr;
+                std::tuple< Ts*... > columns{};
+                if( newCapacity > 0 ){
+                    size_type bytes{0};
+                    (void)Swallow{ 0, ( bytes += AlignUp( newCapacity * sizeof( Ts ) ), 0 )... };
+                    block = static_cast<unsigned char *>( ::operator new( bytes + column_alignment ) );
+                    Carve( block, newCapacity, columns, indices{} );
+                }
+                const bool addRow = sizeof...( Args ) > 0;
+                size_type built{0};
+                size_type moved{0};
+                try{
+                    BuildRow( columns, built, std::integral_constant< bool, sizeof...( Args ) == sizeof...( Ts ) >{}, std::forward<Args>( args )... );
+                    MoveColumns( columns, moved, indices{} );
+                }catch(...){
+                    DestroyFields( columns, m_size, built, indices{} );
+                    DestroyMoved( columns, moved, indices{} );
+                    ::operator delete( block );
+                    throw;
+                }
+                DestroySources( indices{} );
+                ::operator delete( m_block );
+                m_block = block;
+                m_columns = columns;
+                m_capacity = newCapacity;
+                m_size += addRow ? 1 : 0;
+            }
+
+            /// Builds the row at size() in 'columns'.
+            template < typename... Args >
+            void BuildRow( std::tuple< Ts*... > & columns, size_type & built, std::true_type, Args&&... args ){
+                EmplaceFields( columns, m_size, built, indices{}, std::forward<Args>( args )... );
+            }
+
+            /// No row to build.
+            void BuildRow( std::tuple< Ts*... > &, size_type &, std::false_type ){ /* empty */ }
+
+            /// Points each column of 'columns' at its 64-byte aligned slice of 'block'.
+            template < std::size_t... I >
+            static void Carve( unsigned char * block, size_type capacity, std::tuple< Ts*... > & columns, IndexList< I... > ){
+                std::uintptr_t at = ( reinterpret_cast<std::uintptr_t>( block ) + column_alignment - 1 ) & ~std::uintptr_t( column_alignment - 1 );
+                (void)Swallow{ 0, ( std::get<I>( columns ) = reinterpret_cast<Ts *>( at ), at += AlignUp( capacity * sizeof( Ts ) ), 0 )... };
+            }
+
+            template < std::size_t... I >
+            void MoveColumns( std::tuple< Ts*... > & columns, size_type & moved, IndexList< I... > ){
+                (void)Swallow{ 0, ( MoveColumn( std::get<I>( m_columns ), std::get<I>( columns ), is_trivially_relocatable<Ts>{} ), ++moved, 0 )... };
+            }
+
+            /// Destroys the copies made by the first 'moved' column moves; memcpy'd columns still belong to the old block.
+            template < std::size_t... I >
+            void DestroyMoved( std::tuple< Ts*... > & columns, size_type moved, IndexList< I... > ){
+                (void)Swallow{ 0, ( I < moved && !is_trivially_relocatable<Ts>::value ? DestroyColumn( std::get<I>( columns ), 0, m_size ) : void(), 0 )... };
+            }
+
+            /// Ends the old columns after a move: moved-from fields are destroyed, relocated ones are just forgotten.
+            template < std::size_t... I >
+            void DestroySources( IndexList< I... > ){
+                (void)Swallow{ 0, ( !is_trivially_relocatable<Ts>::value ? DestroyColumn( std::get<I>( m_columns ), 0, m_size ) : void(), 0 )... };
+            }
+
+            /// Relocates a column of trivially relocatable fields with one memcpy.
+            template < typename T >
+            void MoveColumn( T * from, T * to, std::true_type ){
+                if( m_size > 0 ){
+                    std::memcpy( static_cast<void *>( to ), static_cast<const void *>( from ), m_size * sizeof( T ) );
+                }
+            }
+
+            /// Moves (or copies, if some column's move may throw) a column field by field.
+            template < typename T >
+            void MoveColumn( T * from, T * to, std::false_type ){
+                size_type i{0};
+                try{
+                    for( ; i < m_size ; ++i ){
+                        ::new ( static_cast<void *>( to + i ) ) T( RelocationSource( from[i], nothrow_relocation{} ) );
+                    }
+                }catch(...){
+                    DestroyColumn( to, 0, i );
+                    throw;
+                }
+            }
+
+            /// Every column moves without throwing: fields are moved.
+            template < typename T >
+            static T && RelocationSource( T & field, std::true_type ){
+                return std::move( field );
+            }
+
+            /// Some column may throw: fields are copied, unless their type is move-only.
+            template < typename T,
+                       typename R = typename std::conditional< std::is_copy_constructible<T>::value, const T &, T && >::type >
+            static R RelocationSource( T & field, std::false_type ){
+                return static_cast<R>( field );
+            }
+
+            /// Releases the block. The rows must already be destroyed, or relocated.
+            void Release( void ){
+                ::operator delete( m_block );
+                m_block = nullptr;
+                m_columns = std::tuple< Ts*... >{};
+                m_capacity = 0;
+            }
+
+            unsigned char * m_block = nullptr;  //!< The single allocation holding every column.
+            std::tuple< Ts*... > m_columns{};   //!< The first element of each column.
+            size_type m_size = 0;               //!< The number of rows.
+            size_type m_capacity = 0;           //!< The number of rows every column has room for.
+    };
+
+    template < typename... Ts >
+    const std::size_t soa_vector< Ts... >::column_alignment;
+} // namespace sc.
+#endif
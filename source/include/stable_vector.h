@@ -0,0 +1,538 @@
+#ifndef _STABLE_VECTOR_H_
+#define _STABLE_VECTOR_H_
+
+#include <cstddef>      // std::size_t, std::ptrdiff_t
+#include <algorithm>    // std::equal, std::lexicographical_compare
+#include <initializer_list> // std::initializer_list
+#include <iterator>     // std::random_access_iterator_tag, std::distance
+#include <memory>       // std::allocator, std::allocator_traits
+#include <stdexcept>    // std::out_of_range, std::length_error
+#include <type_traits>  // std::conditional, std::enable_if, std::is_integral
+#include <utility>      // std::move, std::forward, std::swap
+
+/// Sequence container namespace.
+namespace sc {
+    /// Index of the highest bit set in 'x', which must not be zero.
+    inline std::size_t HighestSetBit( std::size_t x ){
+#if defined(__GNUC__)
+        return sizeof( unsigned long long ) * 8 - 1 - __builtin_clzll( x );
+#else
+        std::size_t i{0};
+        while( x >>= 1 ){
+            ++i;
+        }
+        return i;
+#endif
+    }
+
+    /// Random access iterator over a stable_vector, walking one segment at a time.
+    /*!
+     * It remembers where the current segment ends, so stepping through a
+     * segment is a pointer increment; only crossing into the next segment, or
+     * jumping, goes back to the block table.
+     */
+    template < typename Container, bool IsConst >
+    class stable_iterator
+    {
+        public:
+            using iterator_category = std::random_access_iterator_tag; //!< Iterator category.
+            using value_type = typename Container::value_type;          //!< Value type the iterator points to.
+            using difference_type = std::ptrdiff_t;                     //!< Difference type used to calculated distance between iterators.
+            using pointer = typename std::conditional< IsConst, const value_type *, value_type * >::type;   //!< Pointer to the value type.
+            using reference = typename std::conditional< IsConst, const value_type &, value_type & >::type; //!< Reference to the value type.
+            using owner_pointer = typename std::conditional< IsConst, const Container *, Container * >::type; //!< Pointer to the container.
+
+            stable_iterator( void ) = default;
+
+            /**
+             * @brief Construct a new stable_iterator object pointing to element 'index' of 'owner'.
+             *
+             * @param owner The container.
+             * @param index The element, or size() for the end.
+             */
+            stable_iterator( owner_pointer owner, std::size_t index )
+                : m_owner{owner}, m_index{index}
+            {
+                Locate();
+            }
+
+            /// Converts an iterator into a const iterator.
+            template < bool C, typename = typename std::enable_if< IsConst && !C >::type >
+            stable_iterator( const stable_iterator<Container, C> & other )
+                : m_owner{other.m_owner}, m_index{other.m_index}, m_ptr{other.m_ptr}, m_segment_end{other.m_segment_end}
+            { /* empty */ }
+
+            reference operator*( void ) const{ return *m_ptr; }
+            pointer operator->( void ) const{ return m_ptr; }
+            reference operator[]( difference_type n ) const{ return ( *m_owner )[m_index + n]; }
+
+            stable_iterator & operator++( void ){
+                ++m_index;
+                if( ++m_ptr == m_segment_end ){
+                    Locate();
+                }
+                return *this;
+            }
+            stable_iterator operator++( int ){ stable_iterator tmp{*this}; ++*this; return tmp; }
+            stable_iterator & operator--( void ){ --m_index; Locate(); return *this; }
+            stable_iterator operator--( int ){ stable_iterator tmp{*this}; --*this; return tmp; }
+            stable_iterator & operator+=( difference_type n ){ m_index += n; Locate(); return *this; }
+            stable_iterator & operator-=( difference_type n ){ m_index -= n; Locate(); return *this; }
+
+            friend stable_iterator operator+( stable_iterator it, difference_type n ){ return it += n; }
+            friend stable_iterator operator+( difference_type n, stable_iterator it ){ return it += n; }
+            friend stable_iterator operator-( stable_iterator it, difference_type n ){ return it -= n; }
+            friend difference_type operator-( const stable_iterator & lhs, const stable_iterator & rhs ){
+                return difference_type( lhs.m_index ) - difference_type( rhs.m_index );
+            }
+
+            friend bool operator==( const stable_iterator & lhs, const stable_iterator & rhs ){ return lhs.m_index == rhs.m_index; }
+            friend bool operator!=( const stable_iterator & lhs, const stable_iterator & rhs ){ return lhs.m_index != rhs.m_index; }
+            friend bool operator<( const stable_iterator & lhs, const stable_iterator & rhs ){ return lhs.m_index < rhs.m_index; }
+            friend bool operator>( const stable_iterator & lhs, const stable_iterator & rhs ){ return lhs.m_index > rhs.m_index; }
+            friend bool operator<=( const stable_iterator & lhs, const stable_iterator & rhs ){ return lhs.m_index <= rhs.m_index; }
+            friend bool operator>=( const stable_iterator & lhs, const stable_iterator & rhs ){ return lhs.m_index >= rhs.m_index; }
+
+        private:
+            /// Finds the element and the end of its segment through the block table.
+            void Locate( void ){
+                if( m_owner == nullptr || m_index >= m_owner->capacity() ){
+                    m_ptr = nullptr;
+                    m_segment_end = nullptr;
+                    return;
+                }
+                std::size_t segment = Container::SegmentOf( m_index );
+                pointer first = m_owner->segment_data( segment );
+                m_ptr = first + ( m_index - Container::SegmentStart( segment ) );
+                m_segment_end = first + Container::SegmentSize( segment );
+            }
+
+            template < typename C, bool B >
+            friend class stable_iterator;
+
+            owner_pointer m_owner = nullptr;    //!< The container.
+            std::size_t m_index = 0;            //!< The element.
+            pointer m_ptr = nullptr;            //!< The element's address, when it has storage.
+            pointer m_segment_end = nullptr;    //!< Past the end of the element's segment.
+    };
+
+    /// A vector made of geometrically growing segments that never moves its elements.
+    /*!
+     * Segment k holds FirstSegment << k elements, so the capacity doubles with
+     * every new segment as with sc::vector, but growing just allocates the
+     * next segment: no element is ever copied or moved, and pointers and
+     * references to elements stay valid until the element is removed.
+     *
+     * Indexing is O(1): the segment of element i is the position of the
+     * highest bit of i / FirstSegment + 1, and a fixed table holds the
+     * address of each segment. segment_count(), segment_data() and
+     * segment_size() expose the segments to loops that want plain arrays.
+     *
+     * Only the back end changes, through push_back(), emplace_back() and
+     * pop_back(); inserting or erasing in the middle would have to shift
+     * elements, which is what this container exists to avoid.
+     *
+     * \tparam T The type of the elements.
+     * \tparam Alloc Allocator of the segments.
+     * \tparam FirstSegment Number of elements in the first segment, a power of two.
+     */
+    template < typename T, typename Alloc = std::allocator<T>, std::size_t FirstSegment = 16 >
+    class stable_vector
+    {
+        static_assert( FirstSegment > 0 && ( FirstSegment & ( FirstSegment - 1 ) ) == 0,
+                       "sc::stable_vector needs a power of two first segment" );
+
+        using alloc_traits = std::allocator_traits<Alloc>;
+
+        //=== Aliases
+        public:
+            using size_type = std::size_t;                  //!< The size type.
+            using difference_type = std::ptrdiff_t;         //!< The difference type.
+            using value_type = T;                           //!< The value type.
+            using allocator_type = Alloc;                   //!< The allocator type.
+            using pointer = T *;                            //!< Pointer to a value stored in the container.
+            using const_pointer = const T *;                //!< Pointer to a const value stored in the container.
+            using reference = T &;                          //!< Reference to a value stored in the container.
+            using const_reference = const T &;              //!< Const reference to a value stored in the container.
+            using iterator = stable_iterator< stable_vector, false >;      //!< The iterator.
+            using const_iterator = stable_iterator< stable_vector, true >; //!< The const iterator.
+
+            static const size_type max_segments = sizeof( size_type ) * 8; //!< Size of the block table.
+
+        public:
+            //=== [I] SPECIAL MEMBERS
+
+            /**
+             * @brief Construct a new empty stable_vector object.
+             *
+             * @param alloc Allocator used for all memory of this vector.
+             */
+            explicit stable_vector( const Alloc & alloc = Alloc() )
+                : m_alloc{alloc}
+            { /* empty */ }
+
+            /**
+             * @brief Construct a new stable_vector object with 'count' copies of 'value'.
+             *
+             * @param count Initial size.
+             * @param value Value copied into every element.
+             * @param alloc Allocator used for all memory of this vector.
+             */
+            stable_vector( size_type count, const_reference value, const Alloc & alloc = Alloc() )
+                : m_alloc{alloc}
+            {
+                Guard( [&]( ){
+                    reserve( count );
+                    for( size_type i{0} ; i < count ; ++i ){
+                        push_back( value );
+                    }
+                } );
+            }
+
+            /**
+             * @brief Construct a new stable_vector object with the contents of the range [first, last).
+             *
+             * @tparam InputItr Input iterator type
+             * @param first Input iterator to the initial position in a range.
+             * @param last Input iterator to the final position in a range.
+             * @param alloc Allocator used for all memory of this vector.
+             */
+            template < typename InputItr,
+                       typename = typename std::enable_if< !std::is_integral<InputItr>::value >::type >
+            stable_vector( InputItr first, InputItr last, const Alloc & alloc = Alloc() )
+                : m_alloc{alloc}
+            {
+                Guard( [&]( ){
+                    for( ; first != last ; ++first ){
+                        push_back( *first );
+                    }
+                } );
+            }
+
+            /**
+             * @brief Construct a new stable_vector object with a copy of each of the elements in 'init'.
+             *
+             * @param init An initializer_list object.
+             * @param alloc Allocator used for all memory of this vector.
+             */
+            stable_vector( std::initializer_list<T> init, const Alloc & alloc = Alloc() )
+                : stable_vector( init.begin(), init.end(), alloc )
+            { /* empty */ }
+
+            /**
+             * @brief Construct a new stable_vector object with a copy of each of the elements in 'other'.
+             *
+             * @param other Another stable_vector object of the same type.
+             */
+            stable_vector( const stable_vector & other )
+                : m_alloc{alloc_traits::select_on_container_copy_construction( other.m_alloc )}
+            {
+                Guard( [&]( ){
+                    reserve( other.size() );
+                    for( const auto & x : other ){
+                        push_back( x );
+                    }
+                } );
+            }
+
+            /**
+             * @brief Construct a new stable_vector object that takes over the segments of 'other', which is left empty.
+             *
+             * @param other Another stable_vector object of the same type.
+             */
+            stable_vector( stable_vector && other ) noexcept
+                : m_alloc{std::move( other.m_alloc )}
+            {
+                StealFrom( other );
+            }
+
+            /**
+             * @brief Destroy the stable_vector object.
+             *
+             */
+            ~stable_vector( void ){
+                clear();
+                ReleaseSegments( 0 );
+            }
+
+            /**
+             * @brief Copies all the elements from 'rhs'.
+             *
+             * @param rhs A stable_vector object of the same type.
+             * @return stable_vector& always returns *this enabling things like a = b = c.
+             */
+            stable_vector & operator=( const stable_vector & rhs ){
+                if( this != &rhs ){
+                    stable_vector tmp{ rhs };
+                    swap( *this, tmp );
+                }
+                return *this;
+            }
+
+            /**
+             * @brief Takes over the segments of 'rhs', leaving it empty.
+             *
+             * @param rhs A stable_vector object of the same type.
+             * @return stable_vector& always returns *this enabling things like a = b = c.
+             */
+            stable_vector & operator=( stable_vector && rhs ) noexcept{
+                if( this != &rhs ){
+                    clear();
+                    ReleaseSegments( 0 );
+                    m_alloc = std::move( rhs.m_alloc );
+                    StealFrom( rhs );
+                }
+                return *this;
+            }
+
+            //=== [II] ITERATORS
+
+            iterator begin( void ){ return iterator( this, 0 ); }
+            iterator end( void ){ return iterator( this, m_size ); }
+            const_iterator begin( void ) const{ return const_iterator( this, 0 ); }
+            const_iterator end( void ) const{ return const_iterator( this, m_size ); }
+            const_iterator cbegin( void ) const{ return begin(); }
+            const_iterator cend( void ) const{ return end(); }
+
+            //=== [III] CAPACITY
+
+            /// Return the number of elements.
+            size_type size( void ) const{ return m_size; }
+            /// Check whether there are no elements.
+            bool empty( void ) const{ return m_size == 0; }
+            /// Return how many elements fit in the segments already allocated.
+            size_type capacity( void ) const{ return SegmentStart( m_segments ); }
+
+            /**
+             * @brief Allocates segments until at least 'n' elements fit. Nothing is moved.
+             *
+             * @param n Number of elements.
+             */
+            void reserve( size_type n ){
+                while( capacity() < n ){
+                    AddSegment();
+                }
+            }
+
+            /// Releases the segments that hold no element.
+            void shrink_to_fit( void ){
+                size_type keep = m_size == 0 ? 0 : SegmentOf( m_size - 1 ) + 1;
+                ReleaseSegments( keep );
+            }
+
+            //=== [IV] MODIFIERS
+
+            /// Removes every element, keeping the segments.
+            void clear( void ){
+                while( m_size > 0 ){
+                    pop_back();
+                }
+            }
+
+            /// Appends a copy of 'value'.
+            void push_back( const_reference value ){ emplace_back( value ); }
+            /// Appends 'value', moving it.
+            void push_back( T && value ){ emplace_back( std::move( value ) ); }
+
+            /**
+             * @brief Appends an element built from 'args'. A new segment is allocated when the last
+             * one is full; the elements already stored stay where they are.
+             *
+             * @param args Arguments forwarded to the element's constructor.
+             * @return reference The new element.
+             */
+            template < typename... Args >
+            reference emplace_back( Args&&... args ){
+                if( m_size == capacity() ){
+                    AddSegment();
+                }
+                pointer slot = Address( m_size );
+                alloc_traits::construct( m_alloc, slot, std::forward<Args>( args )... );
+                ++m_size;
+                return *slot;
+            }
+
+            /// Removes the last element.
+            void pop_back( void ){
+                if( empty() ){
+                    throw std::length_error ("[stable_vector::pop_back()]: não posso remover um elemento de um vector vazio.");
+                }
+                --m_size;
+                alloc_traits::destroy( m_alloc, Address( m_size ) );
+            }
+
+            //=== [V] ELEMENT ACCESS
+
+            reference operator[]( size_type pos ){ return *Address( pos ); }
+            const_reference operator[]( size_type pos ) const{ return *Address( pos ); }
+
+            /**
+             * @brief Return the element at 'pos', with bounds checking.
+             *
+             * @param pos Position of the element.
+             * @return reference
+             */
+            reference at( size_type pos ){
+                if( pos >= m_size ){
+                    throw std::out_of_range{"Posição Acessada Fora do Range"};
+                }
+                return ( *this )[pos];
+            }
+
+            /**
+             * @brief Return the element at 'pos', with bounds checking.
+             *
+             * @param pos Position of the element.
+             * @return const_reference
+             */
+            const_reference at( size_type pos ) const{
+                if( pos >= m_size ){
+                    throw std::out_of_range{"Posição Acessada Fora do Range"};
+                }
+                return ( *this )[pos];
+            }
+
+            reference front( void ){
+                if( empty() ){
+                    throw std::length_error ("[stable_vector::front()]: vector vazio.");
+                }
+                return ( *this )[0];
+            }
+            const_reference front( void ) const{
+                if( empty() ){
+                    throw std::length_error ("[stable_vector::front()]: vector vazio.");
+                }
+                return ( *this )[0];
+            }
+            reference back( void ){
+                if( empty() ){
+                    throw std::length_error ("[stable_vector::back()]: vector vazio.");
+                }
+                return ( *this )[m_size - 1];
+            }
+            const_reference back( void ) const{
+                if( empty() ){
+                    throw std::length_error ("[stable_vector::back()]: vector vazio.");
+                }
+                return ( *this )[m_size - 1];
+            }
+
+            //=== [VI] SEGMENTS
+
+            /// Return the number of segments allocated.
+            size_type segment_count( void ) const{ return m_segments; }
+            /// Return the first element slot of segment 'k'.
+            pointer segment_data( size_type k ){ return m_table[k]; }
+            /// Return the first element slot of segment 'k'.
+            const_pointer segment_data( size_type k ) const{ return m_table[k]; }
+            /// Return how many of the elements live in segment 'k'.
+            size_type segment_size( size_type k ) const{
+                size_type start = SegmentStart( k );
+                if( m_size <= start ){
+                    return 0;
+                }
+                size_type n = m_size - start;
+                return n < SegmentSize( k ) ? n : SegmentSize( k );
+            }
+
+            /// Returns a copy of the allocator associated with the vector.
+            allocator_type get_allocator( void ) const{ return m_alloc; }
+
+            friend void swap( stable_vector & first_, stable_vector & second_ ) noexcept{
+                using std::swap;
+                swap( first_.m_alloc, second_.m_alloc );
+                swap( first_.m_table, second_.m_table );
+                swap( first_.m_segments, second_.m_segments );
+                swap( first_.m_size, second_.m_size );
+            }
+
+            /// Segment that holds element 'index'.
+            static size_type SegmentOf( size_type index ){
+                return HighestSetBit( index / FirstSegment + 1 );
+            }
+            /// Index of the first element of segment 'k'.
+            static size_type SegmentStart( size_type k ){
+                return FirstSegment * ( ( size_type( 1 ) << k ) - 1 );
+            }
+            /// Number of elements segment 'k' holds.
+            static size_type SegmentSize( size_type k ){
+                return FirstSegment << k;
+            }
+
+        private:
+            /// Address of the slot of element 'index', which must be below capacity().
+            pointer Address( size_type index ) const{
+                size_type k = SegmentOf( index );
+                return m_table[k] + ( index - SegmentStart( k ) );
+            }
+
+            /// Allocates the next segment, twice as large as the last one.
+            void AddSegment( void ){
+                if( m_segments == max_segments ){
+                    throw std::length_error ("[stable_vector]: o número máximo de segmentos foi atingido.");
+                }
+                m_table[m_segments] = alloc_traits::allocate( m_alloc, SegmentSize( m_segments ) );
+                ++m_segments;
+            }
+
+            /// Releases every segment from 'keep' on. They must hold no element.
+            void ReleaseSegments( size_type keep ){
+                while( m_segments > keep ){
+                    --m_segments;
+                    alloc_traits::deallocate( m_alloc, m_table[m_segments], SegmentSize( m_segments ) );
+                    m_table[m_segments] = nullptr;
+                }
+            }
+
+            /// Takes the segments of 'other', leaving it without any.
+            void StealFrom( stable_vector & other ){
+                for( size_type k{0} ; k < max_segments ; ++k ){
+                    m_table[k] = other.m_table[k];
+                    other.m_table[k] = nullptr;
+                }
+                m_segments = other.m_segments;
+                m_size = other.m_size;
+                other.m_segments = 0;
+                other.m_size = 0;
+            }
+
+            /// Runs a constructor body, releasing everything built so far if it throws.
+            template < typename Fn >
+            void Guard( Fn fn ){
+                try{
+                    fn();
+                }catch(...){
+                    clear();
+                    ReleaseSegments( 0 );
+                    throw;
+                }
+            }
+
+            pointer m_table[max_segments] = {}; //!< The block table: segment k holds FirstSegment << k elements.
+            size_type m_segments = 0;           //!< Number of segments allocated.
+            size_type m_size = 0;               //!< Number of elements.
+            Alloc m_alloc;                      //!< The allocator that owns the segments.
+    };
+
+    template < typename T, typename Alloc, std::size_t FirstSegment >
+    const std::size_t stable_vector< T, Alloc, FirstSegment >::max_segments;
+
+    /// Checks if the contents of lhs and rhs are equal.
+    template < typename T, typename A, std::size_t B >
+    bool operator==( const stable_vector<T, A, B> & lhs, const stable_vector<T, A, B> & rhs ){
+        return lhs.size() == rhs.size() && std::equal( lhs.begin(), lhs.end(), rhs.begin() );
+    }
+
+    /// Checks if the contents of lhs and rhs are different.
+    template < typename T, typename A, std::size_t B >
+    bool operator!=( const stable_vector<T, A, B> & lhs, const stable_vector<T, A, B> & rhs ){
+        return !( lhs == rhs );
+    }
+
+    /// Checks if the contents of lhs are lexicographically less than those of rhs.
+    template < typename T, typename A, std::size_t B >
+    bool operator<( const stable_vector<T, A, B> & lhs, const stable_vector<T, A, B> & rhs ){
+        return std::lexicographical_compare( lhs.begin(), lhs.end(), rhs.begin(), rhs.end() );
+    }
+} // namespace sc.
+#endif
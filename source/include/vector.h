@@ -3,38 +3,130 @@
 
 #include <exception>    // std::out_of_range
 #include <iostream>     // std::cout, std::endl
-#include <memory>       // std::unique_ptr
-#include <iterator>     // std::advance, std::begin(), std::end(), std::ostream_iterator
+#include <memory>       // std::unique_ptr, std::allocator, std::allocator_traits
+#include <iterator>     // std::advance, std::begin(), std::end(), std::ostream_iterator, std::reverse_iterator
 #include <algorithm>    // std::copy, std::equal, std::fill
 #include <initializer_list> // std::initializer_list
 #include <cassert>      // assert()
 #include <limits>       // std::numeric_limits<T>
 #include <cstddef>      // std::size_t
+#include <type_traits>  // std::enable_if, std::is_integral, std::is_arithmetic, std::remove_cv
+#include <utility>      // std::move, std::move_if_noexcept, std::forward
+#include <functional>   // std::ref
+#include <cstring>      // std::memcpy, std::memmove
+
+#include "growth.h"
+#include "simd.h"
+
+#if __cplusplus > 201703L
+#include <compare>      // std::compare_three_way_result_t
+#endif
 
 /// Sequence container namespace.
 namespace sc {
-    /// Implements tha infrastrcture to support a bidirectional iterator.
+    /// Tells whether objects of type T may be relocated with a plain memcpy/memmove.
+    /*!
+     * A relocation moves an object to a new address and ends the lifetime of the
+     * original. For trivially relocatable types this is the same as copying the
+     * bytes and forgetting the source, so no constructor or destructor runs.
+     * It holds for every trivially copyable type; specialize it as std::true_type
+     * for your own types that own no self-referencing state (e.g. pimpl handles,
+     * or types that hold a heap pointer).
+     *
+     * \tparam T The type of the elements.
+     */
+    template < typename T >
+    struct is_trivially_relocatable : std::integral_constant< bool, std::is_trivially_copyable<T>::value > {};
+
+    /// Tells whether two objects of type T are equal exactly when their bytes are.
+    /*!
+     * For such types comparisons between vectors run on whole blocks with
+     * memcmp. It holds for integers, enumerations and pointers; specialize it
+     * as std::true_type for your own types whose operator== compares every
+     * byte (no padding, no floating point members).
+     *
+     * \tparam T The type of the elements.
+     */
+    template < typename T >
+    struct is_bitwise_comparable : std::integral_constant< bool, std::is_integral<T>::value || std::is_enum<T>::value || std::is_pointer<T>::value > {};
+
+    /// Tells whether allocators of type Alloc can resize a block with a member reallocate(p, n, newN).
+    /*!
+     * Such allocators may extend a block in place (e.g. with realloc() or
+     * mremap()), carrying its bytes over as memcpy would. sc::vector uses it
+     * to grow buffers of trivially relocatable elements without copying them.
+     *
+     * \tparam Alloc The allocator type.
+     */
+    template < typename Alloc >
+    struct has_reallocate
+    {
+        private:
+            using pointer = typename std::allocator_traits< Alloc >::pointer;
+
+            template < typename A >
+            static auto Test( int ) -> decltype( std::declval<A &>().reallocate( std::declval<pointer>(), std::size_t(), std::size_t() ), std::true_type() );
+            template < typename A >
+            static std::false_type Test( ... );
+
+        public:
+            static constexpr bool value = decltype( Test< Alloc >( 0 ) )::value; //!< The answer.
+    };
+
+    /// Tells whether Policy splits the initialization of a vector's slots across threads.
+    /*!
+     * sc::vector has constructors and assign() overloads that take such a
+     * policy. It must have a const member for_chunks( data, n, fn ) that calls
+     * fn( first, last ) over disjoint ranges covering [0, n), possibly
+     * concurrently, and returns once all of them are done. parallel.h
+     * specializes it for par::first_touch.
+     *
+     * \tparam Policy The policy type.
+     */
+    template < typename Policy >
+    struct is_chunk_policy : std::false_type {};
+
+    /// Implements tha infrastrcture to support a random access iterator over contiguous storage.
+    /*!
+     * The iterator wraps a plain pointer, so every operation is O(1) and the
+     * standard algorithms take their random access paths (e.g. std::distance,
+     * std::lower_bound). Under C++20 it also declares itself a contiguous
+     * iterator. An iterator converts implicitly to the matching const one,
+     * and both can be compared with each other.
+     *
+     * \tparam T The type of the elements, const qualified for a const_iterator.
+     */
     template < class T >
-    class MyForwardIterator : public std::iterator<std::bidirectional_iterator_tag, T>
+    class MyForwardIterator
     {
         public:
             typedef MyForwardIterator self_type;   //!< Alias to iterator.
             // Below we have the iterator_traits common interface
             typedef std::ptrdiff_t difference_type; //!< Difference type used to calculated distance between iterators.
-            typedef T value_type;           //!< Value type the iterator points to.
+            typedef typename std::remove_cv<T>::type value_type; //!< Value type the iterator points to.
             typedef T* pointer;             //!< Pointer to the value type.
             typedef T& reference;           //!< Reference to the value type.
             typedef const T& const_reference;           //!< Reference to the value type.
-            typedef std::bidirectional_iterator_tag iterator_category; //!< Iterator category.
+            typedef std::random_access_iterator_tag iterator_category; //!< Iterator category.
+#if __cplusplus > 201703L
+            typedef std::contiguous_iterator_tag iterator_concept; //!< C++20 iterator concept.
+#endif
 
-            // TODO: create all methods here.
+            /**
+             * @brief Construct a new MyForwardIterator object that points nowhere.
+             * 
+             */
+            MyForwardIterator( void ){
+                m_ptr = nullptr;
+            }
 
             /**
-             * @brief Construct a new MyForwardIterator object with an assigned or default value. 
+             * @brief Construct a new MyForwardIterator object with an assigned value. 
+             * It is explicit, so that 'it - 0' cannot be read as the distance to a null iterator.
              * 
-             * @param ptr Initial Value for 'm_ptr' by default is nullptr
+             * @param ptr Initial Value for 'm_ptr'.
              */
-            MyForwardIterator(value_type * ptr = nullptr){
+            explicit MyForwardIterator(pointer ptr){
                 m_ptr = ptr;
             }
 
@@ -47,6 +139,17 @@ namespace sc {
                 m_ptr = itr.m_ptr;
             }
 
+            /**
+             * @brief Construct a const iterator from the non-const iterator to the same element.
+             * 
+             * @tparam U The non-const element type.
+             * @param itr a MyForwardIterator object over non-const elements.
+             */
+            template < class U, typename = typename std::enable_if< std::is_same< const U, T >::value && !std::is_const< U >::value >::type >
+            MyForwardIterator(const MyForwardIterator< U >& itr){
+                m_ptr = itr.m_ptr;
+            }
+
             /**
              * @brief Copy 'itr' to MyForwardIterator called,
              * 
@@ -100,6 +203,28 @@ namespace sc {
                 return retval;
             } // it--;
 
+            /**
+             * @brief Advances the iterator 'n' positions (backwards if 'n' is negative).
+             * 
+             * @param n The "jump" the iterator will take.
+             * @return MyForwardIterator& A reference to the iterator after the operation.
+             */
+            MyForwardIterator& operator+=(const difference_type n){
+                m_ptr += n;
+                return *this;
+            } // it += n;
+
+            /**
+             * @brief Recedes the iterator 'n' positions (forwards if 'n' is negative).
+             * 
+             * @param n The "jump" the iterator will take back.
+             * @return MyForwardIterator& A reference to the iterator after the operation.
+             */
+            MyForwardIterator& operator-=(const difference_type n){
+                m_ptr -= n;
+                return *this;
+            } // it -= n;
+
             /**
              * @brief Return a reference to the object located at the position pointed by the iterator.
              * 
@@ -109,26 +234,95 @@ namespace sc {
                 return *m_ptr;
             }
 
+            /**
+             * @brief Return a pointer to the object located at the position pointed by the iterator.
+             * 
+             * @return pointer Address of the element.
+             */
+            pointer operator->() const{
+                return m_ptr;
+            }
+
+            /**
+             * @brief Return a reference to the object 'n' positions away from the iterator.
+             * 
+             * @param n Offset from the iterator.
+             * @return reference The element at it + n.
+             */
+            reference operator[](const difference_type n) const{
+                return m_ptr[n];
+            }
+
             /**
              * @brief check if both MyForwardIterator are the same.
              * 
-             * @param other Other MyForwardIterator object that will be compared.
+             * @param lhs A MyForwardIterator object.
+             * @param rhs Other MyForwardIterator object that will be compared.
              * @return true If both iterators refer to the same location within the vector.
              * @return false Otherwise.
              */
-            bool operator==(const MyForwardIterator& other) const{
-                return m_ptr == other.m_ptr;
+            friend bool operator==(const MyForwardIterator& lhs, const MyForwardIterator& rhs){
+                return lhs.m_ptr == rhs.m_ptr;
             }
 
             /**
              * @brief check if both MyForwardIterator are different.
              * 
-             * @param other Other MyForwardIterator object that will be compared.
+             * @param lhs A MyForwardIterator object.
+             * @param rhs Other MyForwardIterator object that will be compared.
              * @return true If both iterators refer to a different location within the vector.
              * @return false Otherwise
              */
-            bool operator!=(const MyForwardIterator& other) const{
-                return !(*this==other);
+            friend bool operator!=(const MyForwardIterator& lhs, const MyForwardIterator& rhs){
+                return !(lhs==rhs);
+            }
+
+            /**
+             * @brief check if 'lhs' refers to an element before the one 'rhs' refers to.
+             * 
+             * @param lhs A MyForwardIterator object.
+             * @param rhs Other MyForwardIterator object that will be compared.
+             * @return true If lhs comes first.
+             * @return false Otherwise.
+             */
+            friend bool operator<(const MyForwardIterator& lhs, const MyForwardIterator& rhs){
+                return lhs.m_ptr < rhs.m_ptr;
+            }
+
+            /**
+             * @brief check if 'lhs' refers to an element after the one 'rhs' refers to.
+             * 
+             * @param lhs A MyForwardIterator object.
+             * @param rhs Other MyForwardIterator object that will be compared.
+             * @return true If lhs comes last.
+             * @return false Otherwise.
+             */
+            friend bool operator>(const MyForwardIterator& lhs, const MyForwardIterator& rhs){
+                return rhs < lhs;
+            }
+
+            /**
+             * @brief check if 'lhs' does not come after 'rhs'.
+             * 
+             * @param lhs A MyForwardIterator object.
+             * @param rhs Other MyForwardIterator object that will be compared.
+             * @return true If lhs comes first or both are the same.
+             * @return false Otherwise.
+             */
+            friend bool operator<=(const MyForwardIterator& lhs, const MyForwardIterator& rhs){
+                return !(rhs < lhs);
+            }
+
+            /**
+             * @brief check if 'lhs' does not come before 'rhs'.
+             * 
+             * @param lhs A MyForwardIterator object.
+             * @param rhs Other MyForwardIterator object that will be compared.
+             * @return true If lhs comes last or both are the same.
+             * @return false Otherwise.
+             */
+            friend bool operator>=(const MyForwardIterator& lhs, const MyForwardIterator& rhs){
+                return !(lhs < rhs);
             }
 
             /**
@@ -166,14 +360,17 @@ namespace sc {
             /**
              * @brief Return the difference between two iterators.
              * 
-             * @param other The other iterator that will be operated.
+             * @param lhs The iterator that will be operated.
+             * @param rhs The other iterator that will be operated.
              * @return difference_type The value of the difference between two iterators.
              */
-            difference_type operator-(const MyForwardIterator& other) const{
-                return std::distance(other.m_ptr,m_ptr);
+            friend difference_type operator-(const MyForwardIterator& lhs, const MyForwardIterator& rhs){
+                return lhs.m_ptr - rhs.m_ptr;
             }
 
         private:
+            template < class U > friend class MyForwardIterator;
+
             pointer m_ptr; //!< The raw pointer.
     };
 
@@ -187,51 +384,135 @@ namespace sc {
      * This means that a pointer to an element of a vector may be passed to
      * any function that expects a pointer to an element of an array.
      *
+     * Memory is obtained from an allocator, through std::allocator_traits, and
+     * the allocator is propagated on copy, move and swap as its traits request.
+     *
+     * How much the capacity grows when the vector fills up is decided by the
+     * Growth policy (see growth.h). When the allocator can resize blocks (see
+     * sc::has_reallocate) and the elements are trivially relocatable, growing
+     * resizes the block instead of copying the elements to a new one.
+     *
+     * The vector also works as a double-ended queue: push_front() and
+     * pop_front() keep spare slots before the first element (see
+     * front_capacity()), so both are amortized O(1) while the elements stay
+     * contiguous. Vectors only ever used from the back never have headroom.
+     *
      * \tparam T The type of the elements.
+     * \tparam Alloc The allocator type. Its pointer type must be a plain T*.
+     * \tparam Growth The growth policy, doubling by default.
      */
-    template < typename T >
+    template < typename T, typename Alloc = std::allocator<T>, typename Growth = double_growth >
     class vector
     {
         //=== Aliases
         public:
             using size_type = unsigned long; //!< The size type.
             using value_type = T;            //!< The value type.
+            using allocator_type = Alloc;    //!< The allocator type.
             using pointer = value_type*;     //!< Pointer to a value stored in the container.
             using reference = value_type&;   //!< Reference to a value stored in the container.
             using const_reference = const value_type&; //!< Const reference to a value stored in the container.
 
+            using difference_type = std::ptrdiff_t; //!< Difference between two positions.
+
             using iterator = MyForwardIterator< value_type >; //!< The iterator, instantiated from a template class.
             using const_iterator = MyForwardIterator< const value_type >; //!< The const_iterator, instantiated from a template class.
+            using reverse_iterator = std::reverse_iterator< iterator >; //!< Iterator that walks the vector backwards.
+            using const_reverse_iterator = std::reverse_iterator< const_iterator >; //!< Const iterator that walks the vector backwards.
+
+        private:
+            using alloc_traits = std::allocator_traits< Alloc >; //!< Uniform access to the allocator.
+            static_assert( std::is_same< typename alloc_traits::pointer, pointer >::value,
+                           "sc::vector requires an allocator whose pointer type is T*" );
+
+            /// Selects the memcpy/memmove code paths at compile time.
+            using relocatable = std::integral_constant< bool, is_trivially_relocatable<T>::value >;
+
+            /// Selects growing the block through the allocator's reallocate().
+            using reallocatable = std::integral_constant< bool, relocatable::value && has_reallocate<Alloc>::value >;
+
+            /// Whether the elements can slide within their block without a step that may throw. If not,
+            /// they are moved to a new block instead, which can be rolled back.
+            using shiftable = std::integral_constant< bool, relocatable::value || std::is_nothrow_move_constructible<T>::value >;
+
+            /// Selects the threaded copy and fill paths of the policy overloads, which can not roll back a throwing element.
+            using nothrow_copyable = std::integral_constant< bool, std::is_nothrow_copy_constructible<T>::value && std::is_nothrow_copy_assignable<T>::value >;
 
         public:
             //=== [I] SPECIAL MEMBERS (6 OF THEM)
 
             /**
-             * @brief Construct a new vector object with 'newCapacity' elements. Each element is a copy of newCapacity
+             * @brief Construct a new vector object with 'newCapacity' value-initialized elements.
+             * Arithmetic elements are zeroed in bulk.
              * 
              * @param newCapacity Initial vector capacity and size, by default is 0.
+             * @param alloc Allocator used for all memory of this vector.
              */
-            explicit vector( size_type newCapacity = 0){
+            explicit vector( size_type newCapacity = 0, const Alloc & alloc = Alloc())
+                : m_alloc{alloc}
+            {
                 Realloc(newCapacity);
-                for(size_t i{0};i<newCapacity;i++){
-                    push_back(newCapacity);
-                }
+                ValueInitialize(newCapacity, std::is_arithmetic<T>{});
             } //(2)
 
+            /**
+             * @brief Construct a new vector object with 'count' value-initialized elements, initialized
+             * in chunks by the threads of 'policy'. Each page of the block is first touched by the
+             * thread that initializes it, which on NUMA systems places it on that thread's node.
+             * Elements whose default constructor may throw are initialized on the calling thread.
+             *
+             * @param count Initial vector capacity and size.
+             * @param policy A policy such as par::first_touch.
+             * @param alloc Allocator used for all memory of this vector. Its construct() must be safe to call concurrently.
+             */
+            template < typename Policy,
+                       typename = typename std::enable_if< is_chunk_policy<Policy>::value >::type >
+            vector( size_type count, const Policy & policy, const Alloc & alloc = Alloc())
+                : m_alloc{alloc}
+            {
+                Realloc(count);
+                ValueInitialize(count, policy, std::is_arithmetic<T>{}, std::is_nothrow_default_constructible<T>{});
+            }
+
+            /**
+             * @brief Construct a new vector object with 'count' copies of 'value'.
+             * 
+             * @param count Initial vector capacity and size.
+             * @param value Value copied into every element.
+             * @param alloc Allocator used for all memory of this vector.
+             */
+            vector( size_type count, const_reference value, const Alloc & alloc = Alloc())
+                : m_alloc{alloc}
+            {
+                Fill(count, value, std::is_arithmetic<T>{});
+            }
+
             /**
              * @brief Destroy the vector object
              * 
              */
             virtual ~vector( void ){
-               delete [] m_storage;
+                Destroy(m_storage, m_storage + m_end);
+                ReleaseBlock();
             } //(6)
 
+            /**
+             * @brief Construct a new empty vector object that will allocate through 'alloc'.
+             * 
+             * @param alloc Allocator used for all memory of this vector.
+             */
+            explicit vector( const Alloc & alloc )
+                : m_alloc{alloc}
+            { /* empty */ }
+
             /**
              * @brief Construct a new vector object with a copy of each of the elements in 'other', in the same order.
              * 
              * @param other Another vector object of the same type.
              */
-            vector( const vector & other){
+            vector( const vector & other)
+                : m_alloc{alloc_traits::select_on_container_copy_construction(other.m_alloc)}
+            {
                 Realloc(other.m_capacity);
 
                 for(size_t i{0};i<other.size();i++){
@@ -239,19 +520,53 @@ namespace sc {
                 }
             } //(4)
 
+            /**
+             * @brief Construct a new vector object with a copy of each of the elements in 'other', copied
+             * in chunks by the threads of 'policy', so the copy runs at their combined memory bandwidth
+             * and each page is first touched by the thread that writes it. Elements whose copy may
+             * throw are copied on the calling thread.
+             *
+             * @param other Another vector object of the same type.
+             * @param policy A policy such as par::first_touch.
+             */
+            template < typename Policy,
+                       typename = typename std::enable_if< is_chunk_policy<Policy>::value >::type >
+            vector( const vector & other, const Policy & policy )
+                : m_alloc{alloc_traits::select_on_container_copy_construction(other.m_alloc)}
+            {
+                Realloc(other.m_capacity);
+                CopyOver(other.m_storage, other.m_end, policy, nothrow_copyable{});
+            }
+
             /**
              * @brief Construct a new vector object with a copy of each of the elements in 'init', in the same order. 
              * 
              * @param init An initializer_list object.
+             * @param alloc Allocator used for all memory of this vector.
              */
-            vector( std::initializer_list<T> init){
+            vector( std::initializer_list<T> init, const Alloc & alloc = Alloc())
+                : m_alloc{alloc}
+            {
                 Realloc(init.size());
                 for(auto i: init){
                     push_back(i);
                 }
             } //(5)
 
-            vector( vector && );
+            /**
+             * @brief Construct a new vector object that takes over the storage of 'other'.
+             * No element is copied or moved; 'other' is left empty.
+             * 
+             * @param other Another vector object of the same type.
+             */
+            vector( vector && other) noexcept
+                : m_end{other.m_end}, m_capacity{other.m_capacity}, m_front{other.m_front}, m_storage{other.m_storage}, m_alloc{std::move(other.m_alloc)}
+            {
+                other.m_end = 0;
+                other.m_front = 0;
+                other.m_capacity = 0;
+                other.m_storage = nullptr;
+            }
 
             /**
              * @brief Construct a new vector object with the contents of the range [first, last).
@@ -259,9 +574,13 @@ namespace sc {
              * @tparam InputItr Input iterator type
              * @param first Input iterator to the initial position in a range.
              * @param last Input iterator to the final position in a range.
+             * @param alloc Allocator used for all memory of this vector.
              */
-            template < typename InputItr >//(3)
-            vector( InputItr first, InputItr last){
+            template < typename InputItr,
+                       typename = typename std::enable_if< !std::is_integral<InputItr>::value >::type >//(3)
+            vector( InputItr first, InputItr last, const Alloc & alloc = Alloc())
+                : m_alloc{alloc}
+            {
                 Realloc(std::distance(first,last));
                 size_t sz = std::distance(first,last);
                 for(size_t i{0};i<sz;i++){
@@ -277,20 +596,34 @@ namespace sc {
              */
             vector & operator=( const vector & rhs){
                 if(this != &rhs){
-                    if(m_capacity != rhs.m_end){
-                        //delete[] m_storage;
-                        Realloc(rhs.m_capacity);
+                    if(alloc_traits::propagate_on_container_copy_assignment::value && m_alloc != rhs.m_alloc){
+                        // Our block must go back to the allocator that made it, before we adopt the new one.
+                        clear();
+                        AdoptBlock(nullptr, 0);
                     }
-                    //mudar para begin e end dps dos iteradores
-                    std::copy(rhs.m_storage, rhs.m_storage + rhs.m_end, m_storage);
+                    CopyAssignAlloc(rhs.m_alloc, typename alloc_traits::propagate_on_container_copy_assignment{});
+                    ClearForOverwrite(rhs.m_end);
+                    CopyOver(rhs.m_storage, rhs.m_end);
                 }
-                //swap();
-                m_capacity = rhs.m_end;
-                m_end = rhs.m_end;
                 return *this;
             } //(7)
 
-            vector & operator=(vector &&); 
+            /**
+             * @brief Releases the current contents and takes over the storage of 'rhs', which is left empty.
+             * When the allocator does not propagate and the two allocators differ, the storage cannot
+             * change hands, so the elements are moved one by one instead.
+             * 
+             * @param rhs A vector object of the same type.
+             * @return vector& always returns *this enabling things like a = b = c.
+             */
+            vector & operator=( vector && rhs)
+                noexcept( alloc_traits::propagate_on_container_move_assignment::value )
+            {
+                if(this != &rhs){
+                    MoveAssign(rhs, typename alloc_traits::propagate_on_container_move_assignment{});
+                }
+                return *this;
+            }
 
             /**
              * @brief Copies all the elements from 'init' into the vector.
@@ -299,17 +632,7 @@ namespace sc {
              * @return vector& always returns *this enabling things like a = b = c.
              */
             vector & operator=(std::initializer_list<T> init){
-                if(m_capacity != init.size()){
-                    //delete[] m_storage;
-                    Realloc(init.size());
-                }
-                //mudar para begin e end dps dos iteradores
-                clear();
-                for(auto i: init){
-                    push_back(i);
-                }
-                m_capacity = init.size();
-                m_end = init.size();
+                assign(init);
                 return *this;
             } //(8)
             
@@ -340,7 +663,7 @@ namespace sc {
              * @return const_iterator 
              */
             const_iterator cbegin( void ) const{
-                return m_storage;
+                return const_iterator{m_storage};
             }
 
             /**
@@ -349,7 +672,79 @@ namespace sc {
              * @return const_iterator 
              */
             const_iterator cend( void ) const{
-                return &m_storage[m_end];
+                return const_iterator{m_storage + m_end};
+            }
+
+            /**
+             * @brief  Returns a constant iterator pointing to the first item in the list.
+             * 
+             * @return const_iterator 
+             */
+            const_iterator begin( void ) const{
+                return cbegin();
+            }
+
+            /**
+             * @brief Returns a constant iterator pointing to the position just after the last element of the list.
+             * 
+             * @return const_iterator 
+             */
+            const_iterator end( void ) const{
+                return cend();
+            }
+
+            /**
+             * @brief Returns a reverse iterator pointing to the last item in the list.
+             * 
+             * @return reverse_iterator 
+             */
+            reverse_iterator rbegin( void ){
+                return reverse_iterator{end()};
+            }
+
+            /**
+             * @brief Returns a reverse iterator pointing to the position just before the first element of the list.
+             * 
+             * @return reverse_iterator 
+             */
+            reverse_iterator rend( void ){
+                return reverse_iterator{begin()};
+            }
+
+            /**
+             * @brief Returns a constant reverse iterator pointing to the last item in the list.
+             * 
+             * @return const_reverse_iterator 
+             */
+            const_reverse_iterator rbegin( void ) const{
+                return crbegin();
+            }
+
+            /**
+             * @brief Returns a constant reverse iterator pointing to the position just before the first element of the list.
+             * 
+             * @return const_reverse_iterator 
+             */
+            const_reverse_iterator rend( void ) const{
+                return crend();
+            }
+
+            /**
+             * @brief Returns a constant reverse iterator pointing to the last item in the list.
+             * 
+             * @return const_reverse_iterator 
+             */
+            const_reverse_iterator crbegin( void ) const{
+                return const_reverse_iterator{cend()};
+            }
+
+            /**
+             * @brief Returns a constant reverse iterator pointing to the position just before the first element of the list.
+             * 
+             * @return const_reverse_iterator 
+             */
+            const_reverse_iterator crend( void ) const{
+                return const_reverse_iterator{cbegin()};
             }
 
             // [III] Capacity
@@ -372,6 +767,15 @@ namespace sc {
                 return m_capacity;
             }
 
+            /**
+             * @brief Return the number of elements that can be added at the front without moving the others.
+             * 
+             * @return size_type 
+             */
+            size_type front_capacity( void ) const{
+                return m_front;
+            }
+
             /**
              * @brief Check if the vector is empty.
              * 
@@ -389,7 +793,9 @@ namespace sc {
              * 
              */
             void clear( void ){
+                Destroy(m_storage, m_storage + m_end);
                 m_end = 0;
+                Recenter();
             }
 
             /**
@@ -398,14 +804,29 @@ namespace sc {
              * @param value Value that will be placed at the beginning of the vector.
              */
             void push_front( const_reference value){
-                if(m_end >= m_capacity){
-                    Realloc(2*m_capacity);
-                }
-                for(size_t i{m_end};i>0;i--){
-                    m_storage[i] = m_storage[i-1];
-                }
-                m_storage[0] = value;
-                m_end += 1;
+                EmplaceFront(value);
+            }
+
+            /**
+             * @brief Moves a new element to the beginning of the vector, right before its current first element.
+             * 
+             * @param value Value that will be moved to the beginning of the vector.
+             */
+            void push_front( value_type && value){
+                EmplaceFront(std::move(value));
+            }
+
+            /**
+             * @brief Constructs a new element at the beginning of the vector, directly in its storage.
+             * 
+             * @tparam Args Types of the constructor arguments.
+             * @param args Arguments forwarded to the element's constructor.
+             * @return reference A reference to the new element.
+             */
+            template < typename... Args >
+            reference emplace_front( Args&&... args ){
+                EmplaceFront(std::forward<Args>(args)...);
+                return m_storage[0];
             }
             
             /**
@@ -414,15 +835,29 @@ namespace sc {
              * @param value Value that will be placed in the vector.
              */
             void push_back( const_reference value){
-                if(m_end >= m_capacity){
-                    if(m_capacity == 0){
-                        Realloc(1);
-                    }else{
-                        Realloc(2*m_capacity);
-                    }
-                }
-                m_storage[m_end] = value;
-                m_end++;
+                EmplaceAt(m_end, value);
+            }
+
+            /**
+             * @brief Moves a new element to the end of the vector, after its current last element.
+             * 
+             * @param value Value that will be moved into the vector.
+             */
+            void push_back( value_type && value){
+                EmplaceAt(m_end, std::move(value));
+            }
+
+            /**
+             * @brief Constructs a new element at the end of the vector, directly in its storage.
+             * 
+             * @tparam Args Types of the constructor arguments.
+             * @param args Arguments forwarded to the element's constructor.
+             * @return reference A reference to the new element.
+             */
+            template < typename... Args >
+            reference emplace_back( Args&&... args ){
+                EmplaceAt(m_end, std::forward<Args>(args)...);
+                return m_storage[m_end-1];
             }
             
             /**
@@ -432,6 +867,7 @@ namespace sc {
             void pop_back( void ){
                 if(m_end > 0){
                     m_end--;
+                    alloc_traits::destroy(m_alloc, m_storage + m_end);
                 }else{
                     throw std::length_error ("[vector::pop_back()]: não posso remover um elemento de um vector vazio.");
                 }
@@ -443,7 +879,15 @@ namespace sc {
              */
             void pop_front( void ){
                 if(m_end > 0){
-                    erase(begin());
+                    // The freed slot becomes front headroom; nothing shifts.
+                    alloc_traits::destroy(m_alloc, m_storage);
+                    ++m_storage;
+                    ++m_front;
+                    --m_capacity;
+                    --m_end;
+                    if(m_end == 0){
+                        Recenter();
+                    }
                 }
             }
 
@@ -455,27 +899,7 @@ namespace sc {
              * @return iterator An iterator that points to the first of the newly inserted elements.
              */
             iterator insert( iterator pos_ , const_reference value_ ){
-                size_t index = pos_ - begin();
-                if(m_end >= m_capacity){
-                    if(m_capacity == 0){ 
-                        if(pos_!=begin()){
-                            throw std::length_error ("[vector::insert()]: não posso inserir em um vector vazio sem ser no começo.");
-                        }else{
-                            Realloc(1);
-                        }
-                    }else{
-                        Realloc(2*m_capacity);
-                    }
-                }
-                for(size_t i{m_end-1}; i >= index ;i--){
-                    m_storage[i+1] = m_storage[i]; 
-                    if(i+1 == 0){
-                        break;
-                    }
-                }
-                m_storage[index] = value_;
-                m_end++;
-                return &m_storage[pos_ - m_storage];
+                return InsertAt(InsertIndex(pos_ - begin()), value_);
             }
 
             /**
@@ -486,87 +910,71 @@ namespace sc {
              * @return iterator An iterator that points to the first of the newly inserted elements.
              */
             iterator insert( const_iterator pos_ , const_reference value_ ){
-                size_t index = pos_ - begin();
-                if(m_end >= m_capacity){
-                    if(m_capacity == 0){ 
-                        if(pos_!=begin()){
-                            throw std::length_error ("[vector::insert()]: não posso inserir em um vector vazio sem ser no começo.");
-                        }else{
-                            Realloc(1);
-                        }
-                    }else{
-                        Realloc(2*m_capacity);
-                    }
-                }
-                for(size_t i{m_end-1}; i >= index ;i--){
-                    m_storage[i+1] = m_storage[i]; 
-                    if(i+1 == 0){
-                        break;
-                    }
-                }
-                m_storage[index] = value_;
-                m_end++;
-                return &m_storage[pos_ - m_storage];
+                return InsertAt(InsertIndex(pos_ - cbegin()), value_);
             }
 
             /**
-             * @brief Inserts elements from the range [first; last) before pos .
+             * @brief The vector is extended by moving a new element before the element at the specified position.
              * 
-             * @tparam InputItr Input iterator type
-             * @param pos_ Position in the vector where the new elements are inserted.
-             * @param first_ Input iterator to the initial position in a range.
-             * @param last_ Input iterator to the final position in a range.
-             * @return iterator An iterator that points to the first of the newly inserted elements.
+             * @param pos_ Position in the vector where the new element is inserted.
+             * @param value_ Value to be moved into the vector.
+             * @return iterator An iterator that points to the inserted element.
              */
-            template < typename InputItr >
-            iterator insert( iterator pos_ , InputItr first_, InputItr last_ ){
-                size_t position = pos_ - begin();
-                size_t tam = last_ - first_;
-                if(m_end >= m_capacity){
-                    if(m_capacity == 0){ 
-                        if(pos_!=begin()){
-                            throw std::length_error ("[vector::insert()]: não posso inserir em um vector vazio sem ser no começo.");
-                        }else{
-                            Realloc(1);
-                        }
-                    }else{
-                        Realloc(2*m_capacity);
-                    }
-                }
-
-                T* newBlock = new T[m_end + tam];
-                
-                //colocando todos antes da posição
-                int aux1{0};
-                int backupFim = 0;
-                for(size_t i{0}; i<position; i++){
-                    newBlock[aux1] = m_storage[i];
-                    aux1++;
-                    backupFim++;
-                }
+            iterator insert( iterator pos_ , value_type && value_ ){
+                return InsertAt(InsertIndex(pos_ - begin()), std::move(value_));
+            }
 
-                //colocando todos do meio
-                size_t trocas1 = 0;
-                size_t backup = aux1;
-                for(size_t i{(size_t)aux1};i<tam+backup;i++){
-                    newBlock[aux1] = *first_+trocas1;
-                    aux1++;
-                    trocas1++;
-                }
+            /**
+             * @brief The vector is extended by moving a new element before the element at the specified position.
+             * 
+             * @param pos_ Position in the vector where the new element is inserted.
+             * @param value_ Value to be moved into the vector.
+             * @return iterator An iterator that points to the inserted element.
+             */
+            iterator insert( const_iterator pos_ , value_type && value_ ){
+                return InsertAt(InsertIndex(pos_ - cbegin()), std::move(value_));
+            }
 
-                //colocando todos do final
-                for(size_t i{(size_t)aux1};i<m_end + tam;i++){
-                    newBlock[aux1] = m_storage[backupFim];
-                    aux1++;
-                    backupFim++;
-                }
+            /**
+             * @brief Constructs a new element before the element at the specified position, directly in the vector's storage
+             * when it goes at the end.
+             * 
+             * @tparam Args Types of the constructor arguments.
+             * @param pos_ Position in the vector where the new element is inserted.
+             * @param args Arguments forwarded to the element's constructor.
+             * @return iterator An iterator that points to the new element.
+             */
+            template < typename... Args >
+            iterator emplace( iterator pos_ , Args&&... args ){
+                return EmplaceAt(pos_ - begin(), std::forward<Args>(args)...);
+            }
 
-                delete[] m_storage;
-                m_storage = newBlock;
-                m_capacity = tam+m_end;
-                m_end = m_capacity;
+            /**
+             * @brief Constructs a new element before the element at the specified position, directly in the vector's storage
+             * when it goes at the end.
+             * 
+             * @tparam Args Types of the constructor arguments.
+             * @param pos_ Position in the vector where the new element is inserted.
+             * @param args Arguments forwarded to the element's constructor.
+             * @return iterator An iterator that points to the new element.
+             */
+            template < typename... Args >
+            iterator emplace( const_iterator pos_ , Args&&... args ){
+                return EmplaceAt(pos_ - cbegin(), std::forward<Args>(args)...);
+            }
 
-                return &m_storage[first_ - m_storage];
+            /**
+             * @brief Inserts elements from the range [first; last) before pos .
+             * 
+             * @tparam InputItr Input iterator type
+             * @param pos_ Position in the vector where the new elements are inserted.
+             * @param first_ Input iterator to the initial position in a range.
+             * @param last_ Input iterator to the final position in a range.
+             * @return iterator An iterator that points to the first of the newly inserted elements.
+             */
+            template < typename InputItr >
+            iterator insert( iterator pos_ , InputItr first_, InputItr last_ ){
+                return InsertRange(InsertIndex(pos_ - begin()), first_, last_, typename std::iterator_traits<InputItr>::iterator_category{});
             }
 
             /**
@@ -580,53 +988,7 @@ namespace sc {
              */
             template < typename InputItr >
             iterator insert( const_iterator pos_ , InputItr first_, InputItr last_ ){
-                size_t position = pos_ - begin();
-                size_t tam = last_ - first_;
-                if(m_end >= m_capacity){
-                    if(m_capacity == 0){ 
-                        if(pos_!=begin()){
-                            throw std::length_error ("[vector::insert()]: não posso inserir em um vector vazio sem ser no começo.");
-                        }else{
-                            Realloc(1);
-                        }
-                    }else{
-                        Realloc(2*m_capacity);
-                    }
-                }
-
-                T* newBlock = new T[m_end + tam];
-                
-                //colocando todos antes da posição
-                int aux1{0};
-                int backupFim = 0;
-                for(size_t i{0}; i<position; i++){
-                    newBlock[aux1] = m_storage[i];
-                    aux1++;
-                    backupFim++;
-                }
-
-                //colocando todos do meio
-                size_t trocas1 = 0;
-                size_t backup = aux1;
-                for(size_t i{aux1};i<tam+backup;i++){
-                    newBlock[aux1] = *first_+trocas1;
-                    aux1++;
-                    trocas1++;
-                }
-
-                //colocando todos do final
-                for(size_t i{aux1};i<m_end + tam;i++){
-                    newBlock[aux1] = m_storage[backupFim];
-                    aux1++;
-                    backupFim++;
-                }
-
-                delete[] m_storage;
-                m_storage = newBlock;
-                m_capacity = tam+m_end;
-                m_end = m_capacity;
-
-                return &m_storage[first_ - m_storage];
+                return InsertRange(InsertIndex(pos_ - cbegin()), first_, last_, typename std::iterator_traits<InputItr>::iterator_category{});
             }
             
             /**
@@ -637,52 +999,7 @@ namespace sc {
              * @return iterator An iterator that points to the first of the newly inserted elements.
              */
             iterator insert( iterator pos_, const std::initializer_list< value_type >& ilist_ ){
-                size_t position = pos_ - begin();
-                size_t tam = ilist_.size();
-                if(m_end >= m_capacity){
-                    if(m_capacity == 0){ 
-                        if(pos_!=begin()){
-                            throw std::length_error ("[vector::insert()]: não posso inserir em um vector vazio sem ser no começo.");
-                        }else{
-                            Realloc(1);
-                        }
-                    }else{
-                        Realloc(2*m_capacity);
-                    }
-                }
-                T* newBlock = new T[m_end + tam];
-                
-                //colocando todos antes da posição
-                int aux1{0};
-                int backupFim = 0;
-                for(size_t i{0}; i<position; i++){
-                    newBlock[aux1] = m_storage[i];
-                    aux1++;
-                    backupFim++;
-                }
-
-                //colocando todos do meio
-                size_t trocas1 = 0;
-                //size_t backup = aux1;
-                for(auto i: ilist_){
-                    newBlock[aux1] = i;
-                    aux1++;
-                    trocas1++;
-                }
-
-                //colocando todos do final
-                for(size_t i{(size_t)aux1};i<m_end + tam;i++){
-                    newBlock[aux1] = m_storage[backupFim];
-                    aux1++;
-                    backupFim++;
-                }
-
-                delete[] m_storage;
-                m_storage = newBlock;
-                m_capacity = m_end + tam;
-                m_end = m_capacity;
-
-                return &m_storage[pos_ - m_storage];
+                return InsertRange(InsertIndex(pos_ - begin()), ilist_.begin(), ilist_.end(), std::random_access_iterator_tag{});
             }
 
             /**
@@ -693,52 +1010,7 @@ namespace sc {
              * @return iterator An iterator that points to the first of the newly inserted elements.
              */
             iterator insert( const_iterator pos_, const std::initializer_list< value_type >& ilist_ ){
-                size_t position = pos_ - begin();
-                size_t tam = ilist_.size();
-                if(m_end >= m_capacity){
-                    if(m_capacity == 0){ 
-                        if(pos_!=begin()){
-                            throw std::length_error ("[vector::insert()]: não posso inserir em um vector vazio sem ser no começo.");
-                        }else{
-                            Realloc(1);
-                        }
-                    }else{
-                        Realloc(2*m_capacity);
-                    }
-                }
-                T* newBlock = new T[m_end + tam];
-                
-                //colocando todos antes da posição
-                int aux1{0};
-                int backupFim = 0;
-                for(size_t i{0}; i<position; i++){
-                    newBlock[aux1] = m_storage[i];
-                    aux1++;
-                    backupFim++;
-                }
-
-                //colocando todos do meio
-                size_t trocas1 = 0;
-                size_t backup = aux1;
-                for(auto i: ilist_){
-                    newBlock[aux1] = i;
-                    aux1++;
-                    trocas1++;
-                }
-
-                //colocando todos do final
-                for(size_t i{aux1};i<m_end + tam;i++){
-                    newBlock[aux1] = m_storage[backupFim];
-                    aux1++;
-                    backupFim++;
-                }
-
-                delete[] m_storage;
-                m_storage = newBlock;
-                m_capacity = m_end + tam;
-                m_end = m_capacity;
-
-                return &m_storage[pos_ - m_storage];
+                return InsertRange(InsertIndex(pos_ - cbegin()), ilist_.begin(), ilist_.end(), std::random_access_iterator_tag{});
             }
 
             /**
@@ -748,8 +1020,7 @@ namespace sc {
              */
             void reserve( size_type x){
                 if(x>m_capacity){
-                    m_capacity = x;
-                    Realloc(m_capacity);
+                    Realloc(x);
                 }
             }
 
@@ -758,24 +1029,57 @@ namespace sc {
              * 
              */
             void shrink_to_fit( void ){
-                m_capacity = m_end;
-                Realloc(m_capacity);
+                Realloc(m_end);
             }
 
             /**
              * @brief The new contents is 'count_' elements, each initialized to a copy of 'value_'.
+             * Arithmetic elements are written in bulk, with memset or vector stores.
              * 
+             * @param count_ Number of elements of the new contents.
+             * @param value_ Value copied into every element. It may be one of the elements.
              */
-            void assign( value_type /*size_type*/ count_, /*const_reference*/value_type value_ ){
-                if((long unsigned int)count_>m_capacity){
-                    Realloc(count_);
-                }
-                for(size_t i{0};i<(size_t)count_;i++){
-                    m_storage[i] = value_;
-                }
-                m_end = count_;
+            void assign( size_type count_, const_reference value_ ){
+                Fill(count_, value_, std::is_arithmetic<T>{});
             }   
 
+            /**
+             * @brief The new contents is 'count_' elements, each initialized to a copy of 'value_',
+             * written in chunks by the threads of 'policy'. Elements whose copy may throw are
+             * written on the calling thread.
+             *
+             * @param count_ Number of elements of the new contents.
+             * @param value_ Value copied into every element. It may be one of the elements.
+             * @param policy A policy such as par::first_touch.
+             */
+            template < typename Policy,
+                       typename = typename std::enable_if< is_chunk_policy<Policy>::value >::type >
+            void assign( size_type count_, const_reference value_, const Policy & policy ){
+                Fill(count_, value_, policy, std::is_arithmetic<T>{}, nothrow_copyable{});
+            }
+
+            /**
+             * @brief Copies all the elements from 'rhs' into the vector, like operator=, in chunks
+             * written by the threads of 'policy'. Elements whose copy may throw are copied on the
+             * calling thread.
+             *
+             * @param rhs A vector object of the same type.
+             * @param policy A policy such as par::first_touch.
+             */
+            template < typename Policy,
+                       typename = typename std::enable_if< is_chunk_policy<Policy>::value >::type >
+            void assign( const vector & rhs, const Policy & policy ){
+                if(this != &rhs){
+                    if(alloc_traits::propagate_on_container_copy_assignment::value && m_alloc != rhs.m_alloc){
+                        clear();
+                        AdoptBlock(nullptr, 0);
+                    }
+                    CopyAssignAlloc(rhs.m_alloc, typename alloc_traits::propagate_on_container_copy_assignment{});
+                    ClearForOverwrite(rhs.m_end);
+                    CopyOver(rhs.m_storage, rhs.m_end, policy, nothrow_copyable{});
+                }
+            }
+
             /**
              * @brief The new contents are copies of the values passed as initializer list, in the same order.
              * 
@@ -783,15 +1087,8 @@ namespace sc {
              */
             void assign( const std::initializer_list<T>& ilist ){
                 size_t sz = ilist.size();
-                if(sz>m_capacity){
-                    Realloc(sz);
-                }
-                int index = 0;
-                for (auto i : ilist){
-                    m_storage[index] = i;
-                    index++;
-                }
-                m_end = sz;
+                ClearForOverwrite(sz);
+                CopyOver(ilist.begin(), sz);
             }
 
             /**
@@ -801,23 +1098,26 @@ namespace sc {
              * @param first Input iterator to the initial position in a range.
              * @param last Input iterator to the final position in a range.
              */
-            template < typename InputItr >
+            template < typename InputItr,
+                       typename = typename std::enable_if< !std::is_integral<InputItr>::value >::type >
             void assign( InputItr first, InputItr last ){
-                size_t tam = last - first;
-                size_t inicio = first - begin();
-                size_t fim = last - begin();
-
-                T* newBlock = new T[tam];
-
-                int aux{0};
-                for(size_t i{inicio};i<fim;i++){
-                    newBlock[aux] = m_storage[i];
-                    aux++;
+                size_t tam = std::distance(first, last);
+
+                // The range may live inside this vector, so build the new contents aside first.
+                T* newBlock = Allocate(tam);
+                size_t built{0};
+                try{
+                    for(; first != last; ++first, ++built){
+                        Construct(newBlock + built, *first);
+                    }
+                }catch(...){
+                    Destroy(newBlock, newBlock + built);
+                    Deallocate(newBlock, tam);
+                    throw;
                 }
 
-                delete[] m_storage;
-                m_storage = newBlock;
-                m_capacity = tam;
+                Destroy(m_storage, m_storage + m_end);
+                AdoptBlock(newBlock, tam);
                 m_end = tam;
             }
 
@@ -829,16 +1129,10 @@ namespace sc {
              * @return iterator An iterator pointing to the new location of the element that followed the last element erased by the function call.
              */
             iterator erase( iterator first, iterator last ){
-                size_t index_pos = std::distance(first,last);
                 size_t inicio = first - begin();
-                size_t aux{0};
-                for(size_t i{inicio}; aux < index_pos ;aux++){
-                    for(size_t j{i};j<m_end;j++){
-                        m_storage[j] = m_storage[j+1];
-                    }
-                    m_end-=1;
-                }
-                return &m_storage[first - m_storage];
+                size_t fim = last - begin();
+                EraseRange(inicio, fim, relocatable{});
+                return begin() + inicio;
             }   
 
             /**
@@ -849,16 +1143,10 @@ namespace sc {
              * @return iterator An iterator pointing to the new location of the element that followed the last element erased by the function call.
              */
             iterator erase( const_iterator first, const_iterator last ){
-                size_t index_pos = std::distance(first,last);
                 size_t inicio = first - begin();
-                size_t aux{0};
-                for(size_t i{inicio}; aux < index_pos ;aux++){
-                    for(size_t j{i};j<m_end;j++){
-                        m_storage[j] = m_storage[j+1];
-                    }
-                    m_end-=1;
-                }
-                return &m_storage[first - m_storage];
+                size_t fim = last - begin();
+                EraseRange(inicio, fim, relocatable{});
+                return begin() + inicio;
             }
 
             /**
@@ -869,11 +1157,8 @@ namespace sc {
              */
             iterator erase( const_iterator pos ){
                 size_t index = pos - begin();
-                for(size_t i{index}; ;++i){
-                    m_storage[i] = m_storage[i+1];
-                }
-                m_end--;
-                return &m_storage[pos - m_storage];
+                EraseRange(index, index + 1, relocatable{});
+                return begin() + index;
             }   
 
             /**
@@ -884,11 +1169,35 @@ namespace sc {
              */
             iterator erase( iterator pos ){
                 size_t index = pos - begin();
-                for(size_t i{index}; i < m_end;++i){
-                    m_storage[i] = m_storage[i+1];
-                }
-                m_end--;
-                return &m_storage[pos - m_storage];
+                EraseRange(index, index + 1, relocatable{});
+                return begin() + index;
+            }
+
+            /**
+             * @brief Removes all the elements for which 'pred' returns true, in a single pass.
+             * The order of the remaining elements is preserved.
+             * 
+             * @tparam Pred Unary predicate type.
+             * @param pred Predicate called once for each element, in order.
+             * @return size_type The number of elements removed.
+             */
+            template < typename Pred >
+            size_type erase_if( Pred pred ){
+                return RemoveIf(pred, std::is_arithmetic<T>{});
+            }
+
+            /**
+             * @brief Keeps only the elements for which 'pred' returns true, in a single pass.
+             * The order of the remaining elements is preserved.
+             * 
+             * @tparam Pred Unary predicate type.
+             * @param pred Predicate called once for each element, in order.
+             * @return size_type The number of elements removed.
+             */
+            template < typename Pred >
+            size_type retain( Pred pred ){
+                auto drop = [&pred]( const_reference value ){ return !pred( value ); };
+                return RemoveIf(drop, std::is_arithmetic<T>{});
             }
 
             // [V] Element access
@@ -1005,42 +1314,73 @@ namespace sc {
             /**
              * @brief Returns a direct pointer to the memory array used internally by the vector to store its owned elements.
              * 
-             * @return const_reference A constant reference to the first element in the array used internally by the vector.
+             * @return const value_type* A pointer to the first element in the array used internally by the vector.
              */
-            const_reference data( void ) const{
+            const value_type * data( void ) const{
                 return m_storage;
             }
 
+            /**
+             * @brief Returns a copy of the allocator associated with the vector.
+             * 
+             * @return allocator_type The allocator.
+             */
+            allocator_type get_allocator( void ) const{
+                return m_alloc;
+            }
+
             // [VII] Friend functions.
-            friend std::ostream & operator<<( std::ostream & os_, const vector<T> & v_ )
+            friend std::ostream & operator<<( std::ostream & os_, const vector & v_ )
             {
                 // O que eu quero imprimir???
                 os_ << "{ ";
-                for( auto i{0u} ; i < v_.m_capacity ; ++i )
+                // Only [0, m_end) holds live objects; the spare capacity is raw memory.
+                for( auto i{0u} ; i < v_.m_end ; ++i )
                 {
-                    if ( i == v_.m_end ) os_ << "| ";
                     os_ << v_.m_storage[ i ] << " ";
                 }
+                os_ << "| ";
                 os_ << "}, m_end=" << v_.m_end << ", m_capacity=" << v_.m_capacity;
 
                 return os_;
             }
 
-            friend void swap( vector<T> & first_, vector<T> & second_ )
+            friend void swap( vector & first_, vector & second_ )
             {
                 // enable ADL
                 using std::swap;
 
+                // Without propagation, swapping storage is only valid between equal allocators.
+                assert( alloc_traits::propagate_on_container_swap::value || first_.m_alloc == second_.m_alloc );
+                SwapAlloc( first_.m_alloc, second_.m_alloc, typename alloc_traits::propagate_on_container_swap{} );
+
                 // Swap each member of the class.
                 swap( first_.m_end,      second_.m_end      );
                 swap( first_.m_capacity, second_.m_capacity );
+                swap( first_.m_front,    second_.m_front    );
                 swap( first_.m_storage,  second_.m_storage  );
             }
 
-            template <typename X>
-            friend bool operator==( const vector<X> & lhs, const vector<X>& rhs);
-            template <typename X>
-            friend bool operator!=( const vector<X> & lhs, const vector<X>& rhs);
+        protected:
+            /**
+             * @brief Releases this vector's block and takes over the block and elements of 'other',
+             * which is left with no storage. The allocators stay where they are, so the caller must
+             * know that ours can release the stolen block (sc::small_vector does, for heap blocks).
+             *
+             * @param other The vector whose storage is taken.
+             */
+            void StealStorage(vector & other) noexcept{
+                clear();
+                ReleaseBlock();
+                m_end = other.m_end;
+                m_capacity = other.m_capacity;
+                m_front = other.m_front;
+                m_storage = other.m_storage;
+                other.m_end = 0;
+                other.m_capacity = 0;
+                other.m_front = 0;
+                other.m_storage = nullptr;
+            }
 
         private:
 
@@ -1054,69 +1394,1108 @@ namespace sc {
                 return m_end == m_capacity;
             }
 
+            /// Swaps the allocators, when their traits ask for them to propagate.
+            static void SwapAlloc( Alloc & a, Alloc & b, std::true_type ){
+                using std::swap;
+                swap( a, b );
+            }
+            /// Leaves the allocators in place.
+            static void SwapAlloc( Alloc &, Alloc &, std::false_type ){ /* empty */ }
+
             /**
              * @brief Reallocates a vector using 'newCapacity' as its capacity.
              * 
              * @param newCapacity New vector capacity
              */
             void Realloc(size_type newCapacity){
-                T* newBlock = new T[newCapacity];
-
                 if(newCapacity < m_end){
+                    Destroy(m_storage + newCapacity, m_storage + m_end);
                     m_end = newCapacity;
                 }
+                ResizeBlock(newCapacity, reallocatable{});
+            }
 
-                for(size_t i{0}; i < m_end; i++){
-                    newBlock[i] = m_storage[i];
+            /**
+             * @brief Returns the capacity to grow to when at least 'required' elements must fit,
+             * as chosen by the growth policy.
+             *
+             * @param required Minimum capacity needed.
+             * @return size_type The new capacity.
+             */
+            size_type NextCapacity(size_type required) const{
+                return Growth::grow(m_capacity, required, sizeof(T));
+            }
+
+            /**
+             * @brief Resizes the block in place through the allocator, when possible.
+             * The live elements are carried over byte by byte, which is a valid relocation for them.
+             *
+             * @param newCapacity New vector capacity, not smaller than m_end.
+             */
+            void ResizeBlock(size_type newCapacity, std::true_type){
+                if(m_storage == nullptr || newCapacity == 0 || m_front != 0){
+                    ResizeBlock(newCapacity, std::false_type{});
+                    return;
                 }
-                
-                delete[] m_storage;
-                m_storage = newBlock;
+                m_storage = m_alloc.reallocate(m_storage, m_capacity, newCapacity);
                 m_capacity = newCapacity;
             }
+
+            /**
+             * @brief Moves the live elements to a new block of 'newCapacity' elements.
+             *
+             * @param newCapacity New vector capacity, not smaller than m_end.
+             */
+            void ResizeBlock(size_type newCapacity, std::false_type){
+                if(newCapacity == 0){
+                    // newCapacity >= m_end, so there is nothing to relocate: just drop the block.
+                    AdoptBlock(nullptr, 0);
+                    return;
+                }
+                // Only the live elements are relocated to the new block, the rest stays raw.
+                T* newBlock = Allocate(newCapacity);
+                try{
+                    UninitializedRelocate(m_storage, m_storage + m_end, newBlock);
+                }catch(...){
+                    Deallocate(newBlock, newCapacity);
+                    throw;
+                }
+
+                DestroyRelocated(m_storage, m_storage + m_end);
+                AdoptBlock(newBlock, newCapacity);
+            }
+
+            /**
+             * @brief Validates an insertion position given as an index.
+             *
+             * @param index Position where new elements will be placed.
+             * @return size_type The same index.
+             */
+            size_type InsertIndex(size_type index) const{
+                if(m_capacity == 0 && index != 0){
+                    throw std::length_error ("[vector::insert()]: não posso inserir em um vector vazio sem ser no começo.");
+                }
+                return index;
+            }
+
+            /**
+             * @brief Insertion engine for ranges that can be traversed more than once: the number of new
+             * elements is known up front, so the storage is grown at most once, and every new element is
+             * constructed directly in its final slot.
+             *
+             * @param index Position where the new elements will be placed.
+             * @param first Iterator to the first element to insert. It must not point into this vector.
+             * @param last Iterator past the last element to insert.
+             * @return iterator An iterator that points to the first of the new elements.
+             */
+            template < typename FwdItr >
+            iterator InsertRange(size_type index, FwdItr first, FwdItr last, std::forward_iterator_tag){
+                size_type count = static_cast<size_type>(std::distance(first, last));
+                if(count == 0){
+                    return begin() + index;
+                }
+                if(index == 0 && m_front >= count){
+                    // Room in the front headroom: nothing that is stored moves.
+                    ConstructRange(m_storage - count, first, count);
+                    m_storage -= count;
+                    m_front -= count;
+                    m_capacity += count;
+                }else if(m_capacity - m_end >= count && shiftable::value){
+                    OpenGap(index, count, relocatable{});
+                    try{
+                        ConstructRange(m_storage + index, first, count);
+                    }catch(...){
+                        CloseGap(index, count, relocatable{});
+                        throw;
+                    }
+                }else{
+                    // Elements whose move may throw are not shifted in place: they go to a new block,
+                    // as large as the current one if it had room.
+                    size_type newCapacity = m_capacity - m_end >= count ? m_capacity : NextCapacity(m_end + count);
+                    T* newBlock = Allocate(newCapacity);
+                    try{
+                        ConstructRange(newBlock + index, first, count);
+                    }catch(...){
+                        Deallocate(newBlock, newCapacity);
+                        throw;
+                    }
+                    try{
+                        UninitializedRelocate(m_storage, m_storage + index, newBlock);
+                        try{
+                            UninitializedRelocate(m_storage + index, m_storage + m_end, newBlock + index + count);
+                        }catch(...){
+                            Destroy(newBlock, newBlock + index);
+                            throw;
+                        }
+                    }catch(...){
+                        Destroy(newBlock + index, newBlock + index + count);
+                        Deallocate(newBlock, newCapacity);
+                        throw;
+                    }
+                    DestroyRelocated(m_storage, m_storage + m_end);
+                    AdoptBlock(newBlock, newCapacity);
+                }
+                m_end += count;
+                return begin() + index;
+            }
+
+            /**
+             * @brief Insertion engine for single-pass ranges, whose size is unknown: the elements are
+             * appended with geometric growth, then rotated into place.
+             *
+             * @param index Position where the new elements will be placed.
+             * @param first Iterator to the first element to insert.
+             * @param last Iterator past the last element to insert.
+             * @return iterator An iterator that points to the first of the new elements.
+             */
+            template < typename InputItr >
+            iterator InsertRange(size_type index, InputItr first, InputItr last, std::input_iterator_tag){
+                size_type oldEnd = m_end;
+                for(; first != last; ++first){
+                    EmplaceAt(m_end, *first);
+                }
+                std::rotate(m_storage + index, m_storage + oldEnd, m_storage + m_end);
+                return begin() + index;
+            }
+
+            /**
+             * @brief Constructs 'count' elements copied from 'first' into the raw slots starting at 'dest'.
+             * If one of them throws, the ones already built are destroyed.
+             */
+            template < typename FwdItr >
+            void ConstructRange(pointer dest, FwdItr first, size_type count){
+                size_type i{0};
+                try{
+                    for(; i < count; ++i, ++first){
+                        Construct(dest + i, *first);
+                    }
+                }catch(...){
+                    Destroy(dest, dest + i);
+                    throw;
+                }
+            }
+
+            /**
+             * @brief Constructs 'count' copies of 'value' into the raw slots starting at 'dest'.
+             * If one of them throws, the ones already built are destroyed.
+             */
+            void FillConstruct(pointer dest, size_type count, const_reference value){
+                size_type i{0};
+                try{
+                    for(; i < count; ++i){
+                        Construct(dest + i, value);
+                    }
+                }catch(...){
+                    Destroy(dest, dest + i);
+                    throw;
+                }
+            }
+
+            /// Makes the vector hold 'count' copies of 'value', arithmetic elements: every slot, live or raw, is simply overwritten.
+            void Fill(size_type count, value_type value, std::true_type){
+                if(count > m_capacity){
+                    pointer block = Allocate(count);
+                    AdoptBlock(block, count);
+                }
+                simd::fill(m_storage, count, value);
+                m_end = count;
+            }
+
+            /// Makes the vector hold 'count' copies of 'value': live slots are assigned, raw slots constructed, leftovers destroyed.
+            void Fill(size_type count, const_reference value, std::false_type){
+                if(count > m_capacity){
+                    // 'value' may be one of our elements, so the new block is filled before the old one goes.
+                    pointer block = Allocate(count);
+                    try{
+                        FillConstruct(block, count, value);
+                    }catch(...){
+                        Deallocate(block, count);
+                        throw;
+                    }
+                    Destroy(m_storage, m_storage + m_end);
+                    AdoptBlock(block, count);
+                    m_end = count;
+                    return;
+                }
+                size_type live = std::min(count, m_end);
+                std::fill(m_storage, m_storage + live, value);
+                FillConstruct(m_storage + live, count - live, value);
+                if(count < m_end){
+                    Destroy(m_storage + count, m_storage + m_end);
+                }
+                m_end = count;
+            }
+
+            /// Value-initializes the first 'count' raw slots, arithmetic elements: they are zeroed.
+            void ValueInitialize(size_type count, std::true_type){
+                simd::fill(m_storage, count, value_type());
+                m_end = count;
+            }
+
+            /// Value-initializes the first 'count' raw slots, one at a time.
+            void ValueInitialize(size_type count, std::false_type){
+                for(; m_end < count; m_end++){
+                    Construct(m_storage + m_end);
+                }
+            }
+
+            /// Value-initializes the first 'count' raw slots in chunks run by 'policy', arithmetic elements: they are zeroed.
+            template < typename Policy, typename NothrowDefault >
+            void ValueInitialize(size_type count, const Policy & policy, std::true_type, NothrowDefault){
+                pointer data = m_storage;
+                policy.for_chunks(data, count, [data](size_type first, size_type last){
+                    simd::fill(data + first, last - first, value_type());
+                });
+                m_end = count;
+            }
+
+            /// Value-initializes the first 'count' raw slots in chunks run by 'policy', one at a time.
+            template < typename Policy >
+            void ValueInitialize(size_type count, const Policy & policy, std::false_type, std::true_type){
+                pointer data = m_storage;
+                policy.for_chunks(data, count, [this, data](size_type first, size_type last){
+                    for(size_type i{first}; i < last; ++i){
+                        Construct(data + i);
+                    }
+                });
+                m_end = count;
+            }
+
+            /// A default constructor that may throw: value-initializes on the calling thread, which can roll back.
+            template < typename Policy >
+            void ValueInitialize(size_type count, const Policy &, std::false_type, std::false_type){
+                ValueInitialize(count, std::false_type{});
+            }
+
+            /// Fill() in chunks run by 'policy', arithmetic elements: every slot, live or raw, is simply overwritten.
+            template < typename Policy, typename NothrowCopy >
+            void Fill(size_type count, value_type value, const Policy & policy, std::true_type, NothrowCopy){
+                if(count > m_capacity){
+                    pointer block = Allocate(count);
+                    AdoptBlock(block, count);
+                }
+                pointer data = m_storage;
+                policy.for_chunks(data, count, [data, value](size_type first, size_type last){
+                    simd::fill(data + first, last - first, value);
+                });
+                m_end = count;
+            }
+
+            /// Fill() in chunks run by 'policy': each thread assigns the live slots of its chunk and constructs the raw ones.
+            template < typename Policy >
+            void Fill(size_type count, const_reference value, const Policy & policy, std::false_type, std::true_type){
+                // 'value' may be one of our elements, about to be overwritten by another thread.
+                const value_type copy(value);
+                if(count > m_capacity){
+                    pointer block = Allocate(count);
+                    clear();
+                    AdoptBlock(block, count);
+                }
+                OverwriteChunks(count, policy, [&copy](size_type) -> const_reference { return copy; });
+            }
+
+            /// A copy that may throw: fills on the calling thread, which can roll back.
+            template < typename Policy >
+            void Fill(size_type count, const_reference value, const Policy &, std::false_type, std::false_type){
+                Fill(count, value, std::false_type{});
+            }
+
+            /// CopyOver() in chunks run by 'policy'. Trivially copyable elements are copied with one memcpy per chunk.
+            template < typename Policy >
+            void CopyOver(const T * src, size_type count, const Policy & policy, std::true_type){
+                if(std::is_trivially_copyable<T>::value){
+                    pointer data = m_storage;
+                    policy.for_chunks(data, count, [data, src](size_type first, size_type last){
+                        std::memcpy(static_cast<void*>(data + first), static_cast<const void*>(src + first), (last - first) * sizeof(T));
+                    });
+                    m_end = count;
+                    return;
+                }
+                OverwriteChunks(count, policy, [src](size_type i) -> const_reference { return src[i]; });
+            }
+
+            /// A copy that may throw: copies on the calling thread.
+            template < typename Policy >
+            void CopyOver(const T * src, size_type count, const Policy &, std::false_type){
+                CopyOver(src, count);
+            }
+
+            /**
+             * @brief Makes the vector hold at(0) ... at(count - 1), in chunks run by 'policy': each thread
+             * assigns the live slots of its chunk and constructs the raw ones. The capacity must be at
+             * least 'count', and neither the copies nor the assignments may throw.
+             */
+            template < typename Policy, typename At >
+            void OverwriteChunks(size_type count, const Policy & policy, At at){
+                pointer data = m_storage;
+                size_type live = std::min(count, m_end);
+                policy.for_chunks(data, count, [this, data, live, &at](size_type first, size_type last){
+                    size_type i{first};
+                    for(; i < last && i < live; ++i){
+                        data[i] = at(i);
+                    }
+                    for(; i < last; ++i){
+                        Construct(data + i, at(i));
+                    }
+                });
+                if(count < m_end){
+                    Destroy(m_storage + count, m_storage + m_end);
+                }
+                m_end = count;
+            }
+
+            /// Shifts [index, m_end) 'count' slots right with one memmove, leaving raw slots behind.
+            void OpenGap(size_type index, size_type count, std::true_type){
+                std::memmove(static_cast<void*>(m_storage + index + count), static_cast<const void*>(m_storage + index), (m_end - index) * sizeof(T));
+            }
+
+            /// Shifts [index, m_end) 'count' slots right, from the last one back, each moving once into a raw slot.
+            /// Only used when the moves cannot throw (see 'shiftable'), so no element is ever lost halfway.
+            void OpenGap(size_type index, size_type count, std::false_type){
+                for(size_type i{m_end}; i > index; --i){
+                    Construct(m_storage + i - 1 + count, std::move(m_storage[i - 1]));
+                    alloc_traits::destroy(m_alloc, m_storage + i - 1);
+                }
+            }
+
+            /// Undoes OpenGap(), when the new elements could not be built.
+            void CloseGap(size_type index, size_type count, std::true_type){
+                std::memmove(static_cast<void*>(m_storage + index), static_cast<const void*>(m_storage + index + count), (m_end - index) * sizeof(T));
+            }
+
+            /// Undoes OpenGap(), when the new elements could not be built.
+            void CloseGap(size_type index, size_type count, std::false_type){
+                for(size_type i{index}; i < m_end; ++i){
+                    Construct(m_storage + i, std::move(m_storage[i + count]));
+                    alloc_traits::destroy(m_alloc, m_storage + i + count);
+                }
+            }
+
+            /**
+             * @brief Constructs a new element from 'args' at position 'index', growing the storage if it is full.
+             * When the element goes at the end it is built directly in its slot; in the middle it is built
+             * aside first, since 'args' may refer to elements that are about to shift.
+             *
+             * @param index Position where the new element will be placed.
+             * @param args Arguments forwarded to the element's constructor.
+             * @return iterator An iterator that points to the new element.
+             */
+            template < typename... Args >
+            iterator EmplaceAt(size_type index, Args&&... args){
+                if(m_end >= m_capacity){
+                    GrowAndEmplace(index, std::forward<Args>(args)...);
+                }else if(index == m_end){
+                    Construct(m_storage + m_end, std::forward<Args>(args)...);
+                }else{
+                    T tmp(std::forward<Args>(args)...);
+                    ShiftInsert(index, std::move(tmp), relocatable{});
+                }
+                m_end++;
+                return begin() + index;
+            }
+
+            /**
+             * @brief Inserts a copy of 'value' at position 'index', growing the storage if it is full.
+             * 'value' may refer to an element of this vector.
+             *
+             * @param index Position where the new element will be placed.
+             * @param value Value to be copied into the vector.
+             * @return iterator An iterator that points to the inserted element.
+             */
+            iterator InsertAt(size_type index, const_reference value){
+                if(m_end >= m_capacity){
+                    GrowAndEmplace(index, value);
+                }else{
+                    // If 'value' lives in the part being shifted, it will be found one slot ahead.
+                    const T* src = &value;
+                    if(src >= m_storage + index && src < m_storage + m_end){
+                        ++src;
+                    }
+                    ShiftInsert(index, *src, relocatable{});
+                }
+                m_end++;
+                return begin() + index;
+            }
+
+            /**
+             * @brief Moves 'value' into the vector at position 'index', growing the storage if it is full.
+             *
+             * @param index Position where the new element will be placed.
+             * @param value Value to be moved into the vector.
+             * @return iterator An iterator that points to the inserted element.
+             */
+            iterator InsertAt(size_type index, value_type && value){
+                if(m_end >= m_capacity){
+                    GrowAndEmplace(index, std::move(value));
+                }else{
+                    ShiftInsert(index, std::move(value), relocatable{});
+                }
+                m_end++;
+                return begin() + index;
+            }
+
+            /**
+             * @brief Grows the storage as the growth policy asks, leaving a slot at 'index' where
+             * a new element is constructed from 'args'. The caller updates m_end.
+             *
+             * @param index Position where the new element will be placed.
+             * @param args Arguments forwarded to the element's constructor.
+             */
+            template < typename... Args >
+            void GrowAndEmplace(size_type index, Args&&... args){
+                if(shiftable::value && m_front > 0 && m_front >= m_end){
+                    // At least half the block is headroom left by pop_front(): reuse it instead of growing.
+                    T tmp(std::forward<Args>(args)...);
+                    ShiftElements(-static_cast<std::ptrdiff_t>(m_front), relocatable{});
+                    ShiftInsert(index, std::move(tmp), relocatable{});
+                    return;
+                }
+                GrowAndEmplace(reallocatable{}, index, std::forward<Args>(args)...);
+            }
+
+            /**
+             * @brief Growth through the allocator's reallocate(). The new element is built aside first,
+             * since 'args' may point into the block that is about to move.
+             */
+            template < typename... Args >
+            void GrowAndEmplace(std::true_type, size_type index, Args&&... args){
+                T tmp(std::forward<Args>(args)...);
+                ResizeBlock(NextCapacity(m_end + 1), std::true_type{});
+                ShiftInsert(index, std::move(tmp), std::true_type{});
+            }
+
+            /**
+             * @brief Growth into a new block. The new element is built first, while 'args' are still
+             * valid, then the old ones are relocated around it, so each of them moves only once.
+             */
+            template < typename... Args >
+            void GrowAndEmplace(std::false_type, size_type index, Args&&... args){
+                size_type newCapacity = NextCapacity(m_end + 1);
+                T* newBlock = Allocate(newCapacity);
+                try{
+                    Construct(newBlock + index, std::forward<Args>(args)...);
+                }catch(...){
+                    Deallocate(newBlock, newCapacity);
+                    throw;
+                }
+                try{
+                    UninitializedRelocate(m_storage, m_storage + index, newBlock);
+                    try{
+                        UninitializedRelocate(m_storage + index, m_storage + m_end, newBlock + index + 1);
+                    }catch(...){
+                        Destroy(newBlock, newBlock + index);
+                        throw;
+                    }
+                }catch(...){
+                    alloc_traits::destroy(m_alloc, newBlock + index);
+                    Deallocate(newBlock, newCapacity);
+                    throw;
+                }
+                DestroyRelocated(m_storage, m_storage + m_end);
+                AdoptBlock(newBlock, newCapacity);
+            }
+
+            /**
+             * @brief Opens a slot at 'index' by shifting [index, m_end) one position right
+             * with a single memmove, then constructs 'value' into it.
+             */
+            template < typename Arg >
+            void ShiftInsert(size_type index, Arg&& value, std::true_type){
+                std::memmove(static_cast<void*>(m_storage + index + 1), static_cast<const void*>(m_storage + index), (m_end - index) * sizeof(T));
+                try{
+                    Construct(m_storage + index, std::forward<Arg>(value));
+                }catch(...){
+                    std::memmove(static_cast<void*>(m_storage + index), static_cast<const void*>(m_storage + index + 1), (m_end - index) * sizeof(T));
+                    throw;
+                }
+            }
+
+            /**
+             * @brief Opens a slot at 'index' by shifting [index, m_end) one position right
+             * element by element, then assigns 'value' to it.
+             */
+            template < typename Arg >
+            void ShiftInsert(size_type index, Arg&& value, std::false_type){
+                if(index == m_end){
+                    Construct(m_storage + m_end, std::forward<Arg>(value));
+                    return;
+                }
+                // The last slot is raw memory: construct it, then shift the rest by move assignment.
+                Construct(m_storage + m_end, std::move(m_storage[m_end-1]));
+                try{
+                    for(size_t i{m_end-1}; i > index ;i--){
+                        m_storage[i] = std::move(m_storage[i-1]);
+                    }
+                    m_storage[index] = std::forward<Arg>(value);
+                }catch(...){
+                    // The caller never counts the slot built past the end, so it must not outlive the throw.
+                    alloc_traits::destroy(m_alloc, m_storage + m_end);
+                    throw;
+                }
+            }
+
+            /**
+             * @brief Removes the elements in [first, last) and closes the gap with a single memmove.
+             */
+            void EraseRange(size_type first, size_type last, std::true_type){
+                Destroy(m_storage + first, m_storage + last);
+                std::memmove(static_cast<void*>(m_storage + first), static_cast<const void*>(m_storage + last), (m_end - last) * sizeof(T));
+                m_end -= last - first;
+            }
+
+            /**
+             * @brief Removes the elements in [first, last), shifting the tail left element by element.
+             */
+            void EraseRange(size_type first, size_type last, std::false_type){
+                // The tail moves once, by the whole gap; what is left past the new end is destroyed.
+                std::move(m_storage + last, m_storage + m_end, m_storage + first);
+                size_type newEnd = m_end - (last - first);
+                Destroy(m_storage + newEnd, m_storage + m_end);
+                m_end = newEnd;
+            }
+
+            /**
+             * @brief Removes the elements for which 'pred' holds with the SIMD stream compaction kernel.
+             * Arithmetic types need no destruction, so only the count changes afterwards.
+             */
+            template < typename Pred >
+            size_type RemoveIf(Pred & pred, std::true_type){
+                size_type kept = simd::compact(m_storage, m_end, std::ref(pred));
+                size_type removed = m_end - kept;
+                m_end = kept;
+                return removed;
+            }
+
+            /// Removes the elements for which 'pred' holds, for non-arithmetic types.
+            template < typename Pred >
+            size_type RemoveIf(Pred & pred, std::false_type){
+                return Compact(pred, relocatable{});
+            }
+
+            /**
+             * @brief One pass compaction for trivially relocatable types: removed elements are destroyed
+             * where they are and kept ones are relocated over the gaps with memcpy.
+             */
+            template < typename Pred >
+            size_type Compact(Pred & pred, std::true_type){
+                size_type out{0};
+                size_type i{0};
+                try{
+                    for(; i < m_end; ++i){
+                        if(pred(static_cast<const_reference>(m_storage[i]))){
+                            alloc_traits::destroy(m_alloc, m_storage + i);
+                        }else{
+                            if(out != i){
+                                std::memcpy(static_cast<void*>(m_storage + out), static_cast<const void*>(m_storage + i), sizeof(T));
+                            }
+                            ++out;
+                        }
+                    }
+                }catch(...){
+                    // Close the gap over the elements not yet visited, so that [0, m_end) is live again.
+                    std::memmove(static_cast<void*>(m_storage + out), static_cast<const void*>(m_storage + i), (m_end - i) * sizeof(T));
+                    m_end = out + (m_end - i);
+                    throw;
+                }
+                size_type removed = m_end - out;
+                m_end = out;
+                return removed;
+            }
+
+            /**
+             * @brief One pass compaction by move assignment, as std::remove_if does; the leftovers
+             * at the back are destroyed at the end.
+             */
+            template < typename Pred >
+            size_type Compact(Pred & pred, std::false_type){
+                size_type out{0};
+                for(size_type i{0}; i < m_end; ++i){
+                    if(!pred(static_cast<const_reference>(m_storage[i]))){
+                        if(out != i){
+                            m_storage[out] = std::move(m_storage[i]);
+                        }
+                        ++out;
+                    }
+                }
+                size_type removed = m_end - out;
+                Destroy(m_storage + out, m_storage + m_end);
+                m_end = out;
+                return removed;
+            }
+
+            /**
+             * @brief Makes the vector hold copies of the 'count' elements starting at 'src'.
+             * Live slots are assigned, raw slots are constructed and leftovers are destroyed.
+             * The capacity must already be at least 'count'.
+             *
+             * @tparam FwdItr Forward iterator type.
+             * @param src Iterator to the first element that will be copied.
+             * @param count Number of elements to copy.
+             */
+            template < typename FwdItr >
+            void CopyOver(FwdItr src, size_type count){
+                size_type live = std::min(count, m_end);
+                for(size_t i{0}; i < live; i++){
+                    m_storage[i] = *src++;
+                }
+                for(size_t i{live}; i < count; i++){
+                    Construct(m_storage + i, *src++);
+                }
+                if(count < m_end){
+                    Destroy(m_storage + count, m_storage + m_end);
+                }
+                m_end = count;
+            }
+
+            /**
+             * @brief Constructs a new element from 'args' right before the first one.
+             * Without front headroom, room is made first: if at least half the block is free at the
+             * back the elements slide to split the free slots evenly between both ends, otherwise they
+             * move to a larger block that keeps the back room they had and takes all the new room as
+             * headroom. Either way the headroom gained is proportional to the size, so push_front()
+             * is amortized O(1).
+             *
+             * @param args Arguments forwarded to the element's constructor.
+             */
+            template < typename... Args >
+            void EmplaceFront(Args&&... args){
+                if(m_front > 0){
+                    Construct(m_storage - 1, std::forward<Args>(args)...);
+                }else if(shiftable::value && m_capacity - m_end > 0 && m_capacity - m_end >= m_end){
+                    SlideAndEmplaceFront(std::forward<Args>(args)...);
+                }else{
+                    GrowAndEmplaceFront(std::forward<Args>(args)...);
+                }
+                --m_storage;
+                --m_front;
+                ++m_capacity;
+                ++m_end;
+            }
+
+            /**
+             * @brief Slides the elements right to open headroom, and constructs a new element in
+             * the last slot of it. When that slot is already raw the element is built there before
+             * anything moves; otherwise it is built aside, since 'args' may refer to the elements.
+             */
+            template < typename... Args >
+            void SlideAndEmplaceFront(Args&&... args){
+                size_type shift = (m_capacity - m_end + 1) / 2;
+                if(shift > m_end){
+                    Construct(m_storage + shift - 1, std::forward<Args>(args)...);
+                    try{
+                        ShiftElements(static_cast<std::ptrdiff_t>(shift), relocatable{});
+                    }catch(...){
+                        alloc_traits::destroy(m_alloc, m_storage + shift - 1);
+                        throw;
+                    }
+                }else{
+                    T tmp(std::forward<Args>(args)...);
+                    ShiftElements(static_cast<std::ptrdiff_t>(shift), relocatable{});
+                    Construct(m_storage - 1, std::move(tmp));
+                }
+            }
+
+            /**
+             * @brief Moves the elements to a larger block, all of whose new room goes to the front, and
+             * constructs a new element in the last slot of the headroom. As in GrowAndEmplace(), the
+             * new element is built first, while 'args' are still valid.
+             */
+            template < typename... Args >
+            void GrowAndEmplaceFront(Args&&... args){
+                size_type newTotal = Growth::grow(m_capacity, m_end + 1, sizeof(T));
+                if(newTotal < m_capacity + 1){
+                    newTotal = m_capacity + 1;
+                }
+                size_type headroom = newTotal - m_capacity;
+                T* newBlock = Allocate(newTotal);
+                try{
+                    Construct(newBlock + headroom - 1, std::forward<Args>(args)...);
+                }catch(...){
+                    Deallocate(newBlock, newTotal);
+                    throw;
+                }
+                try{
+                    UninitializedRelocate(m_storage, m_storage + m_end, newBlock + headroom);
+                }catch(...){
+                    alloc_traits::destroy(m_alloc, newBlock + headroom - 1);
+                    Deallocate(newBlock, newTotal);
+                    throw;
+                }
+                DestroyRelocated(m_storage, m_storage + m_end);
+                AdoptBlock(newBlock + headroom, newTotal - headroom);
+                m_front = headroom;
+            }
+
+            /**
+             * @brief Moves the elements 'shift' slots within the block (right if positive, left if negative),
+             * trading headroom for back room or the other way around. Trivially relocatable types use one memmove.
+             *
+             * @param shift How many slots to move by; the block must have room for it.
+             */
+            void ShiftElements(std::ptrdiff_t shift, std::true_type){
+                std::memmove(static_cast<void*>(m_storage + shift), static_cast<const void*>(m_storage), m_end * sizeof(T));
+                m_storage += shift;
+                m_front += shift;
+                m_capacity -= shift;
+            }
+
+            /**
+             * @brief Moves the elements 'shift' slots within the block, one by one, so that each
+             * target slot is already raw when it is constructed. Only used when the moves cannot
+             * throw (see 'shiftable'): a failure halfway would leave holes among the live slots.
+             *
+             * @param shift How many slots to move by; the block must have room for it.
+             */
+            void ShiftElements(std::ptrdiff_t shift, std::false_type){
+                if(shift > 0){
+                    for(size_type i{m_end}; i > 0; --i){
+                        Construct(m_storage + (i - 1) + shift, std::move(m_storage[i - 1]));
+                        alloc_traits::destroy(m_alloc, m_storage + (i - 1));
+                    }
+                }else{
+                    for(size_type i{0}; i < m_end; ++i){
+                        Construct(m_storage + i + shift, std::move(m_storage[i]));
+                        alloc_traits::destroy(m_alloc, m_storage + i);
+                    }
+                }
+                m_storage += shift;
+                m_front += shift;
+                m_capacity -= shift;
+            }
+
+            /**
+             * @brief Makes room for 'count' elements from the start of the storage, ahead of a CopyOver().
+             * When they do not fit behind the headroom the elements are dropped, which gives the headroom
+             * back, and only if that is still not enough a fresh block is allocated.
+             *
+             * @param count Number of elements that will be written.
+             */
+            void ClearForOverwrite(size_type count){
+                if(count > m_capacity){
+                    clear();
+                    if(count > m_capacity){
+                        AdoptBlock(Allocate(count), count);
+                    }
+                }
+            }
+
+            /// Gives the headroom of an empty vector back to the back end.
+            void Recenter(void){
+                m_storage -= m_front;
+                m_capacity += m_front;
+                m_front = 0;
+            }
+
+            /// Releases the whole block, headroom included. Its elements must already be destroyed.
+            void ReleaseBlock(void){
+                Deallocate(m_storage - m_front, m_front + m_capacity);
+            }
+
+            /**
+             * @brief Releases the current block and adopts 'block', without headroom, as the storage.
+             *
+             * @param block The new storage, or nullptr.
+             * @param capacity Number of elements 'block' can hold.
+             */
+            void AdoptBlock(pointer block, size_type capacity){
+                ReleaseBlock();
+                m_storage = block;
+                m_capacity = capacity;
+                m_front = 0;
+            }
+
+            /**
+             * @brief Allocates raw storage for 'n' elements, without constructing any of them.
+             *
+             * @param n Number of elements the block must hold.
+             * @return pointer The uninitialized block, or nullptr when 'n' is zero.
+             */
+            pointer Allocate(size_type n){
+                if(n == 0){
+                    return nullptr;
+                }
+                return alloc_traits::allocate(m_alloc, n);
+            }
+
+            /**
+             * @brief Releases a block obtained from Allocate(). Its elements must already be destroyed.
+             *
+             * @param p The block to release.
+             * @param n The number of elements the block was allocated for.
+             */
+            void Deallocate(pointer p, size_type n){
+                if(p != nullptr){
+                    alloc_traits::deallocate(m_alloc, p, n);
+                }
+            }
+
+            /**
+             * @brief Constructs an element in the raw slot 'p' from 'args', through the allocator.
+             *
+             * @param p Raw slot that will hold the new element.
+             * @param args Arguments forwarded to the element's constructor.
+             */
+            template < typename... Args >
+            void Construct(pointer p, Args&&... args){
+                alloc_traits::construct(m_alloc, p, std::forward<Args>(args)...);
+            }
+
+            /// Copy assignment of the allocator, when its traits ask for it to propagate.
+            void CopyAssignAlloc(const Alloc & other, std::true_type){ m_alloc = other; }
+            /// Copy assignment of the allocator, when it must stay put.
+            void CopyAssignAlloc(const Alloc &, std::false_type){ /* empty */ }
+
+            /// Move assignment when the allocator propagates: the storage always changes hands.
+            void MoveAssign(vector & rhs, std::true_type) noexcept{
+                // Our block goes back to our allocator before it is replaced.
+                StealStorage(rhs);
+                m_alloc = std::move(rhs.m_alloc);
+            }
+
+            /// Move assignment when the allocator stays put: steal only if both allocators are interchangeable.
+            void MoveAssign(vector & rhs, std::false_type){
+                if(m_alloc == rhs.m_alloc){
+                    MoveAssign(rhs, std::true_type{});
+                    return;
+                }
+                ClearForOverwrite(rhs.m_end);
+                CopyOver(std::make_move_iterator(rhs.m_storage), rhs.m_end);
+                rhs.clear();
+            }
+
+            /**
+             * @brief Relocates the elements of [first, last) into the raw block at 'dest'.
+             * Trivially relocatable types are copied with one memcpy; the others are moved when that
+             * cannot throw and copied otherwise. If a construction throws, the block is left raw again.
+             * The source must be released with DestroyRelocated() afterwards.
+             *
+             * @param first Pointer to the first element that will be relocated.
+             * @param last Pointer just past the last element that will be relocated.
+             * @param dest Raw, non-overlapping block that receives the elements.
+             */
+            void UninitializedRelocate(pointer first, pointer last, pointer dest){
+                UninitializedRelocate(first, last, dest, relocatable{});
+            }
+
+            void UninitializedRelocate(pointer first, pointer last, pointer dest, std::true_type){
+                CopyBytes(dest, first, static_cast<size_type>(last - first) * sizeof(T));
+            }
+
+            /// memcpy() of 'bytes' bytes that never hands memcpy a null pointer when there is nothing to copy.
+            static void CopyBytes(void * dest, const void * src, std::size_t bytes){
+                if(bytes == 0){
+                    return;
+                }
+                std::memcpy(dest, src, bytes);
+            }
+
+            void UninitializedRelocate(pointer first, pointer last, pointer dest, std::false_type){
+                pointer cur = dest;
+                try{
+                    for(; first != last; ++first, ++cur){
+                        Construct(cur, std::move_if_noexcept(*first));
+                    }
+                }catch(...){
+                    Destroy(dest, cur);
+                    throw;
+                }
+            }
+
+            /**
+             * @brief Ends the lifetime of elements that were relocated by UninitializedRelocate().
+             * For trivially relocatable types the bytes already live elsewhere, so nothing runs.
+             *
+             * @param first Pointer to the first relocated element.
+             * @param last Pointer just past the last relocated element.
+             */
+            void DestroyRelocated(pointer first, pointer last){
+                if(!relocatable::value){
+                    Destroy(first, last);
+                }
+            }
+
+            /**
+             * @brief Calls the destructor of every element in [first, last), keeping the memory.
+             *
+             * @param first Pointer to the first element that will be destroyed.
+             * @param last Pointer just past the last element that will be destroyed.
+             */
+            void Destroy(pointer first, pointer last){
+                for(; first != last; ++first){
+                    alloc_traits::destroy(m_alloc, first);
+                }
+            }
             size_type m_end = 0;                //!< The list's current size (or index past-last valid element).
-            size_type m_capacity = 0;           //!< The list's storage capacity.
+            size_type m_capacity = 0;           //!< The list's storage capacity, counted from m_storage.
+            size_type m_front = 0;              //!< Raw slots kept before m_storage (front headroom).
             // std::unique_ptr<T[]> m_storage; //!< The list's data storage area.
             T *m_storage = nullptr;                   //!< The list's data storage area.
+            Alloc m_alloc;                      //!< The allocator that owns m_storage.
     };
 
     // [VI] Operators
 
+    /// Finds where two arrays of bitwise comparable elements first differ, with memcmp.
+    template < typename T >
+    std::size_t FirstUnequal( const T * a, const T * b, std::size_t n, std::true_type ){
+        return simd::first_unequal_bytes( a, b, n );
+    }
+
+    /// Finds where two arrays first differ by operator==, with the SIMD kernels for float and double.
+    template < typename T >
+    std::size_t FirstUnequal( const T * a, const T * b, std::size_t n, std::false_type ){
+        return simd::first_unequal( a, b, n );
+    }
+
+    /// Bitwise comparable types are totally ordered, so the first byte difference decides operator< too.
+    template < typename T >
+    std::size_t FirstOrderedUnequal( const T * a, const T * b, std::size_t n, std::true_type ){
+        return simd::first_unequal_bytes( a, b, n );
+    }
+
+    /// Finds where operator< first tells two arrays apart, with the SIMD kernels for float and double.
+    template < typename T >
+    std::size_t FirstOrderedUnequal( const T * a, const T * b, std::size_t n, std::false_type ){
+        return simd::first_ordered_unequal( a, b, n );
+    }
+
     /**
      * @brief Checks if the contents of lhs and rhs are equal.
+     * Bitwise comparable types are compared with memcmp; float and double with SIMD
+     * kernels, where NaN is unequal to everything, as with operator==.
      * 
      * @tparam T Type of vector.
+     * @tparam A Allocator type of vector.
+     * @tparam G Growth policy of vector.
      * @param lhs Left vector to be compared.
      * @param rhs Right vector to be compared.
      * @return true If the contents of lhs and rhs are equal.
      * @return false Otherwise.
      */
-    template <typename T>
-    bool operator==( const vector<T> & lhs, const vector<T>& rhs){
+    template <typename T, typename A, typename G>
+    bool operator==( const vector<T, A, G> & lhs, const vector<T, A, G>& rhs){
         if(lhs.size() != rhs.size()){
             return false;
         }
-        for(size_t i{0};i<rhs.size();i++){
-            if(lhs.m_storage[i]!=rhs.m_storage[i]){
-                return false;
-            }
-        }
-        return true;
+        return FirstUnequal(lhs.data(), rhs.data(), lhs.size(), is_bitwise_comparable<T>{}) == lhs.size();
     }
 
     /**
      * @brief Checks if the contents of lhs and rhs are different.
      * 
      * @tparam T Type of vector.
+     * @tparam A Allocator type of vector.
+     * @tparam G Growth policy of vector.
      * @param lhs Left vector to be compared.
      * @param rhs Right vector to be compared. 
      * @return true If the contents of lhs and rhs are different.
      * @return false Otherwise. 
      */
-    template <typename T>
-    bool operator!=( const vector<T> & lhs, const vector<T>& rhs){
+    template <typename T, typename A, typename G>
+    bool operator!=( const vector<T, A, G> & lhs, const vector<T, A, G>& rhs){
         return !(lhs==rhs);
     }
 
+    /**
+     * @brief Checks if the contents of lhs are lexicographically less than those of rhs,
+     * with the same result as std::lexicographical_compare. The position that decides it
+     * is found with the same kernels as operator==; elements holding a NaN are passed over,
+     * since NaN is neither less nor greater than anything.
+     * 
+     * @tparam T Type of vector.
+     * @tparam A Allocator type of vector.
+     * @tparam G Growth policy of vector.
+     * @param lhs Left vector to be compared.
+     * @param rhs Right vector to be compared.
+     * @return true If lhs comes first.
+     * @return false Otherwise.
+     */
+    template <typename T, typename A, typename G>
+    bool operator<( const vector<T, A, G> & lhs, const vector<T, A, G>& rhs){
+        std::size_t n = lhs.size() < rhs.size() ? lhs.size() : rhs.size();
+        std::size_t i = FirstOrderedUnequal(lhs.data(), rhs.data(), n, is_bitwise_comparable<T>{});
+        if(i < n){
+            return lhs.data()[i] < rhs.data()[i];
+        }
+        return lhs.size() < rhs.size();
+    }
+
+    /**
+     * @brief Checks if the contents of lhs are lexicographically greater than those of rhs.
+     * 
+     * @tparam T Type of vector.
+     * @tparam A Allocator type of vector.
+     * @tparam G Growth policy of vector.
+     * @param lhs Left vector to be compared.
+     * @param rhs Right vector to be compared.
+     * @return true If lhs comes last.
+     * @return false Otherwise.
+     */
+    template <typename T, typename A, typename G>
+    bool operator>( const vector<T, A, G> & lhs, const vector<T, A, G>& rhs){
+        return rhs < lhs;
+    }
+
+    /**
+     * @brief Checks if the contents of lhs are lexicographically less than or equivalent to those of rhs.
+     * 
+     * @tparam T Type of vector.
+     * @tparam A Allocator type of vector.
+     * @tparam G Growth policy of vector.
+     * @param lhs Left vector to be compared.
+     * @param rhs Right vector to be compared.
+     * @return true If lhs does not come last.
+     * @return false Otherwise.
+     */
+    template <typename T, typename A, typename G>
+    bool operator<=( const vector<T, A, G> & lhs, const vector<T, A, G>& rhs){
+        return !(rhs < lhs);
+    }
+
+    /**
+     * @brief Checks if the contents of lhs are lexicographically greater than or equivalent to those of rhs.
+     * 
+     * @tparam T Type of vector.
+     * @tparam A Allocator type of vector.
+     * @tparam G Growth policy of vector.
+     * @param lhs Left vector to be compared.
+     * @param rhs Right vector to be compared.
+     * @return true If lhs does not come first.
+     * @return false Otherwise.
+     */
+    template <typename T, typename A, typename G>
+    bool operator>=( const vector<T, A, G> & lhs, const vector<T, A, G>& rhs){
+        return !(lhs < rhs);
+    }
+
+#if __cplusplus > 201703L && defined(__cpp_lib_three_way_comparison)
+    /**
+     * @brief Compares the contents of lhs and rhs lexicographically, as std::lexicographical_compare_three_way.
+     * The first position where the elements are not equal decides; for float and double an
+     * unordered pair (a NaN) makes the result std::partial_ordering::unordered.
+     * It is left unconstrained on purpose: a requires clause would make it win overload
+     * resolution over operator< and friends, whose NaN rules differ.
+     * 
+     * @tparam T Type of vector.
+     * @tparam A Allocator type of vector.
+     * @tparam G Growth policy of vector.
+     * @param lhs Left vector to be compared.
+     * @param rhs Right vector to be compared.
+     * @return The ordering of lhs relative to rhs.
+     */
+    template <typename T, typename A, typename G>
+    std::compare_three_way_result_t<T> operator<=>( const vector<T, A, G> & lhs, const vector<T, A, G>& rhs){
+        std::size_t n = lhs.size() < rhs.size() ? lhs.size() : rhs.size();
+        std::size_t i = FirstUnequal(lhs.data(), rhs.data(), n, is_bitwise_comparable<T>{});
+        if(i < n){
+            return lhs.data()[i] <=> rhs.data()[i];
+        }
+        return lhs.size() <=> rhs.size();
+    }
+#endif
+
 } // namespace sc.
+
+// The bit-packed vector<bool> must be seen wherever vector is.
+#include "vector_bool.h"
 #endif
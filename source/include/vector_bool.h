@@ -0,0 +1,989 @@
+#ifndef _VECTOR_BOOL_H_
+#define _VECTOR_BOOL_H_
+
+#include <cstddef>      // std::size_t, std::ptrdiff_t
+#include <cstdint>      // std::uint64_t
+#include <iterator>     // std::random_access_iterator_tag, std::reverse_iterator, std::distance
+#include <memory>       // std::allocator_traits
+#include <stdexcept>    // std::out_of_range, std::length_error
+#include <string>       // std::string
+#include <type_traits>  // std::conditional, std::enable_if, std::is_integral
+#include <utility>      // std::move
+
+#include "vector.h"
+#include "simd.h"
+
+/// Sequence container namespace.
+namespace sc {
+    /// The word a bit-packed vector<bool> stores its bits in.
+    using bit_word = std::uint64_t;
+
+    /// Index of the lowest bit set in 'word', which must not be zero.
+    inline std::size_t LowestSetBit( bit_word word ){
+#if defined(__GNUC__)
+        return __builtin_ctzll( word );
+#else
+        std::size_t i{0};
+        for( ; ( word & 1 ) == 0 ; word >>= 1 ){
+            ++i;
+        }
+        return i;
+#endif
+    }
+
+    /// Proxy that stands for a single bit of a vector<bool>.
+    class bit_reference
+    {
+        public:
+            /**
+             * @brief Construct a new bit_reference object for the bit selected by 'mask' in '*word'.
+             *
+             * @param word The word holding the bit.
+             * @param mask A word with only that bit set.
+             */
+            bit_reference( bit_word * word, bit_word mask ) noexcept
+                : m_word{word}, m_mask{mask}
+            { /* empty */ }
+
+            bit_reference( const bit_reference & ) = default;
+
+            /// Return the value of the bit.
+            operator bool( void ) const noexcept{ return ( *m_word & m_mask ) != 0; }
+            /// Return the opposite of the value of the bit.
+            bool operator~( void ) const noexcept{ return ( *m_word & m_mask ) == 0; }
+
+            /// Sets the bit to 'value'.
+            bit_reference & operator=( bool value ) noexcept{
+                if( value ){
+                    *m_word |= m_mask;
+                }else{
+                    *m_word &= ~m_mask;
+                }
+                return *this;
+            }
+
+            /// Sets the bit to the value of the bit 'other' stands for.
+            bit_reference & operator=( const bit_reference & other ) noexcept{
+                return *this = bool( other );
+            }
+
+            /// Inverts the bit.
+            void flip( void ) noexcept{ *m_word ^= m_mask; }
+
+            friend void swap( bit_reference a, bit_reference b ) noexcept{
+                bool tmp = a;
+                a = bool( b );
+                b = tmp;
+            }
+
+        private:
+            bit_word * m_word;  //!< The word holding the bit.
+            bit_word m_mask;    //!< The bit within the word.
+    };
+
+    /// Random access iterator over the bits of a vector<bool>, read-only when IsConst is true.
+    template < bool IsConst >
+    class bit_iterator
+    {
+        public:
+            using iterator_category = std::random_access_iterator_tag; //!< Iterator category.
+            using value_type = bool;                                    //!< Value type the iterator points to.
+            using difference_type = std::ptrdiff_t;                     //!< Difference type used to calculated distance between iterators.
+            using pointer = void;                                       //!< Bits have no address.
+            using reference = typename std::conditional< IsConst, bool, bit_reference >::type; //!< What dereferencing yields.
+            using word_pointer = typename std::conditional< IsConst, const bit_word *, bit_word * >::type; //!< Pointer to the words.
+
+            bit_iterator( void ) = default;
+
+            /**
+             * @brief Construct a new bit_iterator object pointing to bit 'bit' of '*word'.
+             *
+             * @param word The word holding the bit.
+             * @param bit The bit within the word, in [0, 64).
+             */
+            bit_iterator( word_pointer word, unsigned bit )
+                : m_word{word}, m_bit{bit}
+            { /* empty */ }
+
+            /// Converts an iterator into a const iterator.
+            template < bool C, typename = typename std::enable_if< IsConst && !C >::type >
+            bit_iterator( const bit_iterator<C> & other )
+                : m_word{other.m_word}, m_bit{other.m_bit}
+            { /* empty */ }
+
+            reference operator*( void ) const{ return Deref( std::integral_constant<bool, IsConst>{} ); }
+            reference operator[]( difference_type n ) const{ return *( *this + n ); }
+
+            bit_iterator & operator++( void ){
+                if( ++m_bit == 64 ){
+                    m_bit = 0;
+                    ++m_word;
+                }
+                return *this;
+            }
+            bit_iterator operator++( int ){ bit_iterator tmp{*this}; ++*this; return tmp; }
+            bit_iterator & operator--( void ){
+                if( m_bit-- == 0 ){
+                    m_bit = 63;
+                    --m_word;
+                }
+                return *this;
+            }
+            bit_iterator operator--( int ){ bit_iterator tmp{*this}; --*this; return tmp; }
+
+            bit_iterator & operator+=( difference_type n ){
+                difference_type pos = difference_type( m_bit ) + n;
+                difference_type words = pos >= 0 ? pos / 64 : -( ( -pos + 63 ) / 64 );
+                m_word += words;
+                m_bit = unsigned( pos - words * 64 );
+                return *this;
+            }
+            bit_iterator & operator-=( difference_type n ){ return *this += -n; }
+
+            friend bit_iterator operator+( bit_iterator it, difference_type n ){ return it += n; }
+            friend bit_iterator operator+( difference_type n, bit_iterator it ){ return it += n; }
+            friend bit_iterator operator-( bit_iterator it, difference_type n ){ return it -= n; }
+            friend difference_type operator-( const bit_iterator & lhs, const bit_iterator & rhs ){
+                return ( lhs.m_word - rhs.m_word ) * 64 + difference_type( lhs.m_bit ) - difference_type( rhs.m_bit );
+            }
+
+            friend bool operator==( const bit_iterator & lhs, const bit_iterator & rhs ){ return lhs.m_word == rhs.m_word && lhs.m_bit == rhs.m_bit; }
+            friend bool operator!=( const bit_iterator & lhs, const bit_iterator & rhs ){ return !( lhs == rhs ); }
+            friend bool operator<( const bit_iterator & lhs, const bit_iterator & rhs ){ return lhs - rhs < 0; }
+            friend bool operator>( const bit_iterator & lhs, const bit_iterator & rhs ){ return rhs < lhs; }
+            friend bool operator<=( const bit_iterator & lhs, const bit_iterator & rhs ){ return !( rhs < lhs ); }
+            friend bool operator>=( const bit_iterator & lhs, const bit_iterator & rhs ){ return !( lhs < rhs ); }
+
+        private:
+            bool Deref( std::true_type ) const{ return ( *m_word >> m_bit ) & 1; }
+            bit_reference Deref( std::false_type ) const{ return bit_reference( m_word, bit_word( 1 ) << m_bit ); }
+
+            template < bool C >
+            friend class bit_iterator;
+
+            word_pointer m_word = nullptr;  //!< The word holding the bit.
+            unsigned m_bit = 0;             //!< The bit within the word.
+    };
+
+    /// Bit-packed specialization of sc::vector for bool.
+    /*!
+     * The bits are packed 64 to a word into an sc::vector of words, so the
+     * vector takes an eighth of the memory of one bool per byte and grows
+     * with the same growth policy. Elements are reached through bit_reference
+     * proxies, so there are no bool& or bool* into the vector.
+     *
+     * Bitmap operations work a word at a time: count() with popcount,
+     * find_first() / find_next() by skipping empty words, bulk set() and
+     * reset() of ranges, and &=, |=, ^= between vectors of the same size with
+     * the SIMD kernels of simd.h. The bits past size() in the last word are
+     * always zero, which keeps them from leaking into any of these.
+     *
+     * The modifiers of sc::vector are all there, but the bits have no front
+     * headroom: push_front(), pop_front() and inserts or erases in the middle
+     * shift the following words, which is O(n / 64). The policy overloads of
+     * the constructors and assign() are not provided.
+     *
+     * \tparam Alloc An allocator of bool, rebound to allocate words.
+     * \tparam Growth The growth policy of the words.
+     */
+    template < typename Alloc, typename Growth >
+    class vector< bool, Alloc, Growth >
+    {
+        using word_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<bit_word>;
+        using word_vector = vector< bit_word, word_allocator, Growth >;
+
+        //=== Aliases
+        public:
+            using size_type = std::size_t;                                  //!< The size type.
+            using difference_type = std::ptrdiff_t;                         //!< The difference type.
+            using value_type = bool;                                        //!< The value type.
+            using allocator_type = Alloc;                                   //!< The allocator type.
+            using word_type = bit_word;                                     //!< The word the bits are packed into.
+            using reference = bit_reference;                                //!< Proxy for a single bit.
+            using const_reference = bool;                                   //!< Value of a single bit.
+            using iterator = bit_iterator<false>;                           //!< The iterator.
+            using const_iterator = bit_iterator<true>;                      //!< The const iterator.
+            using reverse_iterator = std::reverse_iterator<iterator>;       //!< The reverse iterator.
+            using const_reverse_iterator = std::reverse_iterator<const_iterator>; //!< The const reverse iterator.
+
+            static const size_type npos = size_type( -1 );                  //!< Returned by find_first() and find_next() when no bit is set.
+
+        public:
+            //=== [I] SPECIAL MEMBERS
+
+            /**
+             * @brief Construct a new vector object with 'count' bits, all clear.
+             *
+             * @param count Initial size, by default is 0.
+             * @param alloc Allocator used for all memory of this vector.
+             */
+            explicit vector( size_type count = 0, const Alloc & alloc = Alloc())
+                : m_words( WordsFor( count ), word_allocator( alloc ) ), m_size{count}
+            { /* empty */ }
+
+            /**
+             * @brief Construct a new vector object with 'count' bits, all equal to 'value'.
+             *
+             * @param count Initial size.
+             * @param value Value of every bit.
+             * @param alloc Allocator used for all memory of this vector.
+             */
+            vector( size_type count, bool value, const Alloc & alloc = Alloc())
+                : m_words( WordsFor( count ), value ? ~bit_word( 0 ) : bit_word( 0 ), word_allocator( alloc ) ), m_size{count}
+            {
+                ClearTail();
+            }
+
+            /**
+             * @brief Construct a new empty vector object that will allocate through 'alloc'.
+             *
+             * @param alloc Allocator used for all memory of this vector.
+             */
+            explicit vector( const Alloc & alloc )
+                : m_words( word_allocator( alloc ) )
+            { /* empty */ }
+
+            /**
+             * @brief Construct a new vector object with the bits in 'init', in the same order.
+             *
+             * @param init An initializer_list object.
+             * @param alloc Allocator used for all memory of this vector.
+             */
+            vector( std::initializer_list<bool> init, const Alloc & alloc = Alloc())
+                : m_words( word_allocator( alloc ) )
+            {
+                assign( init.begin(), init.end() );
+            }
+
+            /**
+             * @brief Construct a new vector object with the values of the range [first, last).
+             *
+             * @tparam InputItr Input iterator type
+             * @param first Input iterator to the initial position in a range.
+             * @param last Input iterator to the final position in a range.
+             * @param alloc Allocator used for all memory of this vector.
+             */
+            template < typename InputItr,
+                       typename = typename std::enable_if< !std::is_integral<InputItr>::value >::type >
+            vector( InputItr first, InputItr last, const Alloc & alloc = Alloc())
+                : m_words( word_allocator( alloc ) )
+            {
+                assign( first, last );
+            }
+
+            vector( const vector & other ) = default;
+
+            /**
+             * @brief Construct a new vector object that takes over the words of 'other', which is left empty.
+             *
+             * @param other Another vector object of the same type.
+             */
+            vector( vector && other ) noexcept
+                : m_words( std::move( other.m_words ) ), m_size{other.m_size}
+            {
+                other.m_size = 0;
+            }
+
+            vector & operator=( const vector & rhs ) = default;
+
+            /**
+             * @brief Takes over the words of 'rhs', leaving it empty.
+             *
+             * @param rhs A vector object of the same type.
+             * @return vector& always returns *this enabling things like a = b = c.
+             */
+            vector & operator=( vector && rhs ){
+                if( this != &rhs ){
+                    m_words = std::move( rhs.m_words );
+                    m_size = rhs.m_size;
+                    rhs.m_size = 0;
+                }
+                return *this;
+            }
+
+            /**
+             * @brief Replaces the contents with the bits in 'ilist'.
+             *
+             * @param ilist An initializer_list object.
+             * @return vector& always returns *this enabling things like a = b = c.
+             */
+            vector & operator=( std::initializer_list<bool> ilist ){
+                assign( ilist.begin(), ilist.end() );
+                return *this;
+            }
+
+            //=== [II] ITERATORS
+
+            iterator begin( void ){ return iterator( m_words.data(), 0 ); }
+            iterator end( void ){ return begin() + difference_type( m_size ); }
+            const_iterator begin( void ) const{ return const_iterator( m_words.data(), 0 ); }
+            const_iterator end( void ) const{ return begin() + difference_type( m_size ); }
+            const_iterator cbegin( void ) const{ return begin(); }
+            const_iterator cend( void ) const{ return end(); }
+            reverse_iterator rbegin( void ){ return reverse_iterator( end() ); }
+            reverse_iterator rend( void ){ return reverse_iterator( begin() ); }
+            const_reverse_iterator rbegin( void ) const{ return const_reverse_iterator( end() ); }
+            const_reverse_iterator rend( void ) const{ return const_reverse_iterator( begin() ); }
+            const_reverse_iterator crbegin( void ) const{ return rbegin(); }
+            const_reverse_iterator crend( void ) const{ return rend(); }
+
+            //=== [III] CAPACITY
+
+            /// Return the number of bits.
+            size_type size( void ) const{ return m_size; }
+            /// Check whether there are no bits.
+            bool empty( void ) const{ return m_size == 0; }
+            /// Return how many bits fit before the words grow.
+            size_type capacity( void ) const{ return m_words.capacity() * 64; }
+            /// Makes room for at least 'n' bits.
+            void reserve( size_type n ){ m_words.reserve( WordsFor( n ) ); }
+            /// Releases the words that hold no bits.
+            void shrink_to_fit( void ){ m_words.shrink_to_fit(); }
+
+            //=== [IV] MODIFIERS
+
+            /// Removes every bit.
+            void clear( void ){
+                m_words.clear();
+                m_size = 0;
+            }
+
+            /**
+             * @brief Appends a bit.
+             *
+             * @param value The value of the new bit.
+             */
+            void push_back( bool value ){
+                if( m_size % 64 == 0 ){
+                    m_words.push_back( value ? 1 : 0 );
+                }else if( value ){
+                    m_words[WordIndex( m_size )] |= BitMask( m_size );
+                }
+                ++m_size;
+            }
+
+            /**
+             * @brief Appends a bit built from 'args', as bool( args... ).
+             *
+             * @return reference Proxy for the new bit.
+             */
+            template < typename... Args >
+            reference emplace_back( Args&&... args ){
+                push_back( value_type( std::forward<Args>( args )... ) );
+                return back();
+            }
+
+            /**
+             * @brief Prepends a bit, shifting all the others a word at a time.
+             *
+             * @param value The value of the new bit.
+             */
+            void push_front( bool value ){
+                insert( cbegin(), value );
+            }
+
+            /**
+             * @brief Prepends a bit built from 'args', as bool( args... ).
+             *
+             * @return reference Proxy for the new bit.
+             */
+            template < typename... Args >
+            reference emplace_front( Args&&... args ){
+                push_front( value_type( std::forward<Args>( args )... ) );
+                return front();
+            }
+
+            /// Removes the first bit, shifting all the others a word at a time.
+            void pop_front( void ){
+                if( !empty() ){
+                    erase( cbegin() );
+                }
+            }
+
+            /// Removes the last bit.
+            void pop_back( void ){
+                if( empty() ){
+                    throw std::length_error ("[vector::pop_back()]: não posso remover um elemento de um vector vazio.");
+                }
+                --m_size;
+                if( m_size % 64 == 0 ){
+                    m_words.pop_back();
+                }else{
+                    m_words[WordIndex( m_size )] &= ~BitMask( m_size );
+                }
+            }
+
+            /**
+             * @brief Inserts a bit before 'pos', shifting the following ones a word at a time.
+             *
+             * @param pos Position of the new bit.
+             * @param value Its value.
+             * @return iterator The new bit.
+             */
+            iterator insert( const_iterator pos, bool value ){
+                size_type index = size_type( pos - cbegin() );
+                push_back( false );
+                bit_word * words = m_words.data();
+                size_type first = WordIndex( index );
+                for( size_type w = m_words.size() - 1 ; w > first ; --w ){
+                    words[w] = ( words[w] << 1 ) | ( words[w - 1] >> 63 );
+                }
+                bit_word below = BitMask( index ) - 1;
+                words[first] = ( words[first] & below ) | ( ( words[first] & ~below ) << 1 );
+                ( *this )[index] = value;
+                return begin() + difference_type( index );
+            }
+
+            /**
+             * @brief Removes the bit at 'pos', shifting the following ones a word at a time.
+             *
+             * @param pos Position of the bit.
+             * @return iterator The bit that followed it.
+             */
+            iterator erase( const_iterator pos ){
+                size_type index = size_type( pos - cbegin() );
+                bit_word * words = m_words.data();
+                size_type first = WordIndex( index );
+                size_type last = m_words.size() - 1;
+                bit_word below = BitMask( index ) - 1;
+                words[first] = ( words[first] & below ) | ( ( words[first] >> 1 ) & ~below );
+                for( size_type w = first ; w < last ; ++w ){
+                    if( w != first ){
+                        words[w] >>= 1;
+                    }
+                    words[w] |= words[w + 1] << 63;
+                }
+                if( last != first ){
+                    words[last] >>= 1;
+                }
+                // The last bit is now a stale copy, or zero; dropping it keeps the tail clear.
+                pop_back();
+                return begin() + difference_type( index );
+            }
+
+            /**
+             * @brief Inserts a bit built from 'args', as bool( args... ), before 'pos'.
+             *
+             * @param pos Position of the new bit.
+             * @return iterator The new bit.
+             */
+            template < typename... Args >
+            iterator emplace( const_iterator pos, Args&&... args ){
+                return insert( pos, value_type( std::forward<Args>( args )... ) );
+            }
+
+            /**
+             * @brief Inserts the values of the range [first, last) before 'pos'. The following bits
+             * are shifted once, by the whole count, a word at a time.
+             *
+             * @tparam InputItr Input iterator type
+             * @param pos Position of the first new bit.
+             * @param first Input iterator to the initial position in a range.
+             * @param last Input iterator to the final position in a range.
+             * @return iterator The first of the new bits.
+             */
+            template < typename InputItr,
+                       typename = typename std::enable_if< !std::is_integral<InputItr>::value >::type >
+            iterator insert( const_iterator pos, InputItr first, InputItr last ){
+                return InsertRange( size_type( pos - cbegin() ), first, last,
+                                    typename std::iterator_traits<InputItr>::iterator_category{} );
+            }
+
+            /**
+             * @brief Inserts the bits in 'ilist' before 'pos'.
+             *
+             * @param pos Position of the first new bit.
+             * @param ilist An initializer_list object.
+             * @return iterator The first of the new bits.
+             */
+            iterator insert( const_iterator pos, std::initializer_list<bool> ilist ){
+                return insert( pos, ilist.begin(), ilist.end() );
+            }
+
+            /**
+             * @brief Removes the bits in [first, last), shifting the following ones down once, a word at a time.
+             *
+             * @param first Position of the first bit removed.
+             * @param last Position past the last bit removed.
+             * @return iterator The bit that followed the removed ones.
+             */
+            iterator erase( const_iterator first, const_iterator last ){
+                size_type index = size_type( first - cbegin() );
+                size_type count = size_type( last - first );
+                if( count != 0 ){
+                    ShiftDown( index, count );
+                }
+                return begin() + difference_type( index );
+            }
+
+            /**
+             * @brief Removes all the bits for which 'pred' returns true, in a single pass.
+             * The order of the remaining bits is preserved.
+             *
+             * @tparam Pred Unary predicate type.
+             * @param pred Predicate called once for each bit, in order.
+             * @return size_type The number of bits removed.
+             */
+            template < typename Pred >
+            size_type erase_if( Pred pred ){
+                size_type out{0};
+                for( size_type i{0} ; i < m_size ; ++i ){
+                    bool bit = ( *this )[i];
+                    if( !pred( bit ) ){
+                        SetMasked( WordIndex( out ), BitMask( out ), bit );
+                        ++out;
+                    }
+                }
+                size_type removed = m_size - out;
+                Truncate( out );
+                return removed;
+            }
+
+            /**
+             * @brief Keeps only the bits for which 'pred' returns true, in a single pass.
+             * The order of the remaining bits is preserved.
+             *
+             * @tparam Pred Unary predicate type.
+             * @param pred Predicate called once for each bit, in order.
+             * @return size_type The number of bits removed.
+             */
+            template < typename Pred >
+            size_type retain( Pred pred ){
+                return erase_if( [&pred]( bool bit ){ return !pred( bit ); } );
+            }
+
+            /**
+             * @brief The new contents are 'count' bits, all equal to 'value'.
+             *
+             * @param count Number of bits.
+             * @param value Value of every bit.
+             */
+            void assign( size_type count, bool value ){
+                m_words.assign( WordsFor( count ), value ? ~bit_word( 0 ) : bit_word( 0 ) );
+                m_size = count;
+                ClearTail();
+            }
+
+            /**
+             * @brief The new contents are the values of the range [first, last), in the same order.
+             *
+             * @tparam InputItr Input iterator type
+             * @param first Input iterator to the initial position in a range.
+             * @param last Input iterator to the final position in a range.
+             */
+            template < typename InputItr,
+                       typename = typename std::enable_if< !std::is_integral<InputItr>::value >::type >
+            void assign( InputItr first, InputItr last ){
+                clear();
+                for( ; first != last ; ++first ){
+                    push_back( bool( *first ) );
+                }
+            }
+
+            /**
+             * @brief The new contents are the bits in 'ilist'.
+             *
+             * @param ilist An initializer_list object.
+             */
+            void assign( std::initializer_list<bool> ilist ){
+                assign( ilist.begin(), ilist.end() );
+            }
+
+            //=== [V] ELEMENT ACCESS
+
+            reference operator[]( size_type pos ){ return reference( &m_words[WordIndex( pos )], BitMask( pos ) ); }
+            const_reference operator[]( size_type pos ) const{ return ( m_words[WordIndex( pos )] & BitMask( pos ) ) != 0; }
+
+            /**
+             * @brief Return the bit at 'pos', with bounds checking.
+             *
+             * @param pos Position of the bit.
+             * @return reference Proxy for the bit.
+             */
+            reference at( size_type pos ){
+                if( pos >= m_size ){
+                    throw std::out_of_range{"Posição Acessada Fora do Range"};
+                }
+                return ( *this )[pos];
+            }
+
+            /**
+             * @brief Return the bit at 'pos', with bounds checking.
+             *
+             * @param pos Position of the bit.
+             * @return const_reference The value of the bit.
+             */
+            const_reference at( size_type pos ) const{
+                if( pos >= m_size ){
+                    throw std::out_of_range{"Posição Acessada Fora do Range"};
+                }
+                return ( *this )[pos];
+            }
+
+            reference front( void ){
+                if( empty() ){
+                    throw std::length_error ("[vector::front()]: vector vazio.");
+                }
+                return ( *this )[0];
+            }
+            const_reference front( void ) const{
+                if( empty() ){
+                    throw std::length_error ("[vector::front()]: vector vazio.");
+                }
+                return ( *this )[0];
+            }
+            reference back( void ){
+                if( empty() ){
+                    throw std::length_error ("[vector::back()]: vector vazio.");
+                }
+                return ( *this )[m_size - 1];
+            }
+            const_reference back( void ) const{
+                if( empty() ){
+                    throw std::length_error ("[vector::back()]: vector vazio.");
+                }
+                return ( *this )[m_size - 1];
+            }
+
+            /// Return the words holding the bits, bit i being bit i % 64 of word i / 64.
+            word_type * data( void ){ return m_words.data(); }
+            /// Return the words holding the bits, bit i being bit i % 64 of word i / 64.
+            const word_type * data( void ) const{ return m_words.data(); }
+            /// Return the number of words behind data().
+            size_type word_count( void ) const{ return m_words.size(); }
+
+            /// Returns a copy of the allocator associated with the vector.
+            allocator_type get_allocator( void ) const{ return allocator_type( m_words.get_allocator() ); }
+
+            //=== [VI] BITMAP OPERATIONS
+
+            /// Return the number of bits set, by popcount over whole words.
+            size_type count( void ) const{ return simd::popcount_words( m_words.data(), m_words.size() ); }
+            /// Check whether any bit is set.
+            bool any( void ) const{ return find_first() != npos; }
+            /// Check whether no bit is set.
+            bool none( void ) const{ return !any(); }
+            /// Check whether every bit is set.
+            bool all( void ) const{ return count() == m_size; }
+
+            /**
+             * @brief Return the index of the first bit set, skipping whole empty words.
+             *
+             * @return size_type The index, or npos if no bit is set.
+             */
+            size_type find_first( void ) const{
+                return FindFrom( 0 );
+            }
+
+            /**
+             * @brief Return the index of the first bit set after 'pos'.
+             *
+             * @param pos The index the search starts after.
+             * @return size_type The index, or npos if no bit after 'pos' is set.
+             */
+            size_type find_next( size_type pos ) const{
+                return pos + 1 >= m_size ? npos : FindFrom( pos + 1 );
+            }
+
+            /**
+             * @brief Sets the bits in [first, last) to 'value': the whole words in between are filled at once.
+             *
+             * @param first Index of the first bit.
+             * @param last Index past the last bit.
+             * @param value The value, by default true.
+             */
+            void set( size_type first, size_type last, bool value = true ){
+                if( first >= last ){
+                    return;
+                }
+                size_type fw = WordIndex( first );
+                size_type lw = WordIndex( last - 1 );
+                bit_word head = ~( BitMask( first ) - 1 );
+                bit_word tail = ~bit_word( 0 ) >> ( 63 - ( last - 1 ) % 64 );
+                if( fw == lw ){
+                    SetMasked( fw, head & tail, value );
+                    return;
+                }
+                SetMasked( fw, head, value );
+                simd::fill( m_words.data() + fw + 1, lw - fw - 1, value ? ~bit_word( 0 ) : bit_word( 0 ) );
+                SetMasked( lw, tail, value );
+            }
+
+            /// Sets every bit.
+            void set( void ){ set( 0, m_size ); }
+            /// Clears the bits in [first, last).
+            void reset( size_type first, size_type last ){ set( first, last, false ); }
+            /// Clears every bit.
+            void reset( void ){ simd::fill( m_words.data(), m_words.size(), bit_word( 0 ) ); }
+
+            /// Inverts every bit.
+            void flip( void ){
+                for( auto & w : m_words ){
+                    w = ~w;
+                }
+                ClearTail();
+            }
+
+            /// Inverts the bit at 'pos'.
+            void flip( size_type pos ){ m_words[WordIndex( pos )] ^= BitMask( pos ); }
+
+            /// Keeps the bits also set in 'rhs', which must have the same size.
+            vector & operator&=( const vector & rhs ){ return Combine<simd::and_words_op>( rhs, "[vector<bool>::operator&=()]: os vectors têm tamanhos diferentes." ); }
+            /// Sets the bits also set in 'rhs', which must have the same size.
+            vector & operator|=( const vector & rhs ){ return Combine<simd::or_words_op>( rhs, "[vector<bool>::operator|=()]: os vectors têm tamanhos diferentes." ); }
+            /// Inverts the bits set in 'rhs', which must have the same size.
+            vector & operator^=( const vector & rhs ){ return Combine<simd::xor_words_op>( rhs, "[vector<bool>::operator^=()]: os vectors têm tamanhos diferentes." ); }
+
+            /// Return a copy with every bit inverted.
+            vector operator~( void ) const{
+                vector result{ *this };
+                result.flip();
+                return result;
+            }
+
+            friend vector operator&( vector lhs, const vector & rhs ){ return lhs &= rhs; }
+            friend vector operator|( vector lhs, const vector & rhs ){ return lhs |= rhs; }
+            friend vector operator^( vector lhs, const vector & rhs ){ return lhs ^= rhs; }
+
+            // [VII] Friend functions.
+            friend std::ostream & operator<<( std::ostream & os_, const vector & v_ )
+            {
+                // The bits are written out a word at a time, into one string.
+                std::string bits;
+                bits.reserve( 2 * v_.m_size );
+                for( size_type w{0} ; w < v_.m_words.size() ; ++w ){
+                    bit_word word = v_.m_words[w];
+                    size_type n = std::min<size_type>( 64, v_.m_size - w * 64 );
+                    for( size_type b{0} ; b < n ; ++b, word >>= 1 ){
+                        bits += char( '0' + ( word & 1 ) );
+                        bits += ' ';
+                    }
+                }
+                os_ << "{ " << bits << "| }, m_end=" << v_.m_size << ", m_capacity=" << v_.capacity();
+                return os_;
+            }
+
+            friend void swap( vector & first_, vector & second_ )
+            {
+                using std::swap;
+                swap( first_.m_words, second_.m_words );
+                swap( first_.m_size, second_.m_size );
+            }
+
+        private:
+            static size_type WordIndex( size_type pos ){ return pos / 64; }
+            static bit_word BitMask( size_type pos ){ return bit_word( 1 ) << ( pos % 64 ); }
+            static size_type WordsFor( size_type bits ){ return ( bits + 63 ) / 64; }
+
+            /// Clears the bits of the last word that lie past size().
+            void ClearTail( void ){
+                if( m_size % 64 != 0 ){
+                    m_words.back() &= BitMask( m_size ) - 1;
+                }
+            }
+
+            /// Inserts the 'count' bits of a multi-pass range at 'index'.
+            template < typename FwdItr >
+            iterator InsertRange( size_type index, FwdItr first, FwdItr last, std::forward_iterator_tag ){
+                size_type count = size_type( std::distance( first, last ) );
+                ShiftUp( index, count );
+                for( size_type i{index} ; first != last ; ++first, ++i ){
+                    SetMasked( WordIndex( i ), BitMask( i ), bool( *first ) );
+                }
+                return begin() + difference_type( index );
+            }
+
+            /// Inserts a single-pass range at 'index', by way of a temporary vector, so the bits still shift once.
+            template < typename InputItr >
+            iterator InsertRange( size_type index, InputItr first, InputItr last, std::input_iterator_tag ){
+                vector bits( first, last, get_allocator() );
+                return InsertRange( index, bits.cbegin(), bits.cend(), std::forward_iterator_tag{} );
+            }
+
+            /**
+             * @brief Moves the bits in [index, size()) up by 'count', a word at a time, leaving a gap
+             * of 'count' bits of unspecified value at 'index' that the caller overwrites.
+             */
+            void ShiftUp( size_type index, size_type count ){
+                if( count == 0 ){
+                    return;
+                }
+                size_type oldSize = m_size;
+                m_words.reserve( WordsFor( m_size + count ) );
+                while( m_words.size() < WordsFor( m_size + count ) ){
+                    m_words.push_back( 0 );
+                }
+                m_size += count;
+                if( index == oldSize ){
+                    return;
+                }
+                bit_word * words = m_words.data();
+                size_type fw = WordIndex( index );
+                size_type q = count / 64;
+                unsigned r = unsigned( count % 64 );
+                bit_word saved = words[fw];
+                // Each word is built from the (at most two) source words it straddles, from the top
+                // down, so no source word is overwritten before it is read. Source bits below 'index'
+                // only land in the gap or below 'index' in word fw, which is restored afterwards.
+                for( size_type w = m_words.size() - 1 ; ; --w ){
+                    size_type src = w - q;
+                    bit_word word = words[src] << r;
+                    if( r != 0 && src > fw ){
+                        word |= words[src - 1] >> ( 64 - r );
+                    }
+                    words[w] = word;
+                    if( w == fw + q ){
+                        break;
+                    }
+                }
+                bit_word below = BitMask( index ) - 1;
+                words[fw] = ( words[fw] & ~below ) | ( saved & below );
+                ClearTail();
+            }
+
+            /// Removes the 'count' bits at 'index' by moving the ones after them down, a word at a time.
+            void ShiftDown( size_type index, size_type count ){
+                bit_word * words = m_words.data();
+                size_type n = m_words.size();
+                size_type fw = WordIndex( index );
+                size_type q = count / 64;
+                unsigned r = unsigned( count % 64 );
+                bit_word saved = words[fw];
+                // Bottom up: each word reads the source words at or above it, which are not written yet.
+                for( size_type w = fw ; w + q < n ; ++w ){
+                    size_type src = w + q;
+                    bit_word word = words[src] >> r;
+                    if( r != 0 && src + 1 < n ){
+                        word |= words[src + 1] << ( 64 - r );
+                    }
+                    words[w] = word;
+                }
+                bit_word below = BitMask( index ) - 1;
+                words[fw] = ( words[fw] & ~below ) | ( saved & below );
+                Truncate( m_size - count );
+            }
+
+            /// Drops the bits from 'newSize' on, with the words that no longer hold any.
+            void Truncate( size_type newSize ){
+                m_size = newSize;
+                while( m_words.size() > WordsFor( m_size ) ){
+                    m_words.pop_back();
+                }
+                ClearTail();
+            }
+
+            /// Sets or clears the bits of word 'w' selected by 'mask'.
+            void SetMasked( size_type w, bit_word mask, bool value ){
+                if( value ){
+                    m_words[w] |= mask;
+                }else{
+                    m_words[w] &= ~mask;
+                }
+            }
+
+            /// Index of the first bit set at or after 'pos', which must be below size().
+            size_type FindFrom( size_type pos ) const{
+                size_type w = WordIndex( pos );
+                if( w >= m_words.size() ){
+                    return npos;
+                }
+                bit_word word = m_words[w] & ~( BitMask( pos ) - 1 );
+                while( word == 0 ){
+                    if( ++w == m_words.size() ){
+                        return npos;
+                    }
+                    word = m_words[w];
+                }
+                return w * 64 + LowestSetBit( word );
+            }
+
+            /// Applies Op word by word with 'rhs', after checking that the sizes match.
+            template < typename Op >
+            vector & Combine( const vector & rhs, const char * sizeError ){
+                if( rhs.m_size != m_size ){
+                    throw std::length_error( sizeError );
+                }
+                simd::bitwise_words<Op>( m_words.data(), rhs.m_words.data(), m_words.size() );
+                return *this;
+            }
+
+            word_vector m_words;    //!< The bits, 64 to a word, the tail past m_size kept clear.
+            size_type m_size = 0;   //!< The number of bits.
+    };
+
+    template < typename Alloc, typename Growth >
+    const typename vector< bool, Alloc, Growth >::size_type vector< bool, Alloc, Growth >::npos;
+
+    /// Index of the first bit where 'lhs' and 'rhs' differ among their first 'n', or 'n'.
+    template < typename A, typename G >
+    std::size_t FirstUnequalBit( const vector<bool, A, G> & lhs, const vector<bool, A, G> & rhs, std::size_t n ){
+        const bit_word * a = lhs.data();
+        const bit_word * b = rhs.data();
+        for( std::size_t w{0} ; w * 64 < n ; ++w ){
+            bit_word diff = a[w] ^ b[w];
+            if( diff != 0 ){
+                std::size_t i = w * 64 + LowestSetBit( diff );
+                return i < n ? i : n;
+            }
+        }
+        return n;
+    }
+
+    /**
+     * @brief Checks if the bits of lhs and rhs are equal, comparing whole words.
+     *
+     * @return true If the contents of lhs and rhs are equal.
+     * @return false Otherwise.
+     */
+    template < typename A, typename G >
+    bool operator==( const vector<bool, A, G> & lhs, const vector<bool, A, G> & rhs ){
+        return lhs.size() == rhs.size() && FirstUnequalBit( lhs, rhs, lhs.size() ) == lhs.size();
+    }
+
+    /// Checks if the bits of lhs and rhs are different.
+    template < typename A, typename G >
+    bool operator!=( const vector<bool, A, G> & lhs, const vector<bool, A, G> & rhs ){
+        return !( lhs == rhs );
+    }
+
+    /**
+     * @brief Checks if the bits of lhs are lexicographically less than those of rhs (false < true),
+     * finding the first difference a word at a time.
+     *
+     * @return true If lhs comes first.
+     * @return false Otherwise.
+     */
+    template < typename A, typename G >
+    bool operator<( const vector<bool, A, G> & lhs, const vector<bool, A, G> & rhs ){
+        std::size_t n = lhs.size() < rhs.size() ? lhs.size() : rhs.size();
+        std::size_t i = FirstUnequalBit( lhs, rhs, n );
+        if( i < n ){
+            return rhs[i];
+        }
+        return lhs.size() < rhs.size();
+    }
+
+    /// Checks if the bits of lhs are lexicographically greater than those of rhs.
+    template < typename A, typename G >
+    bool operator>( const vector<bool, A, G> & lhs, const vector<bool, A, G> & rhs ){ return rhs < lhs; }
+    /// Checks if the bits of lhs are lexicographically less than or equivalent to those of rhs.
+    template < typename A, typename G >
+    bool operator<=( const vector<bool, A, G> & lhs, const vector<bool, A, G> & rhs ){ return !( rhs < lhs ); }
+    /// Checks if the bits of lhs are lexicographically greater than or equivalent to those of rhs.
+    template < typename A, typename G >
+    bool operator>=( const vector<bool, A, G> & lhs, const vector<bool, A, G> & rhs ){ return !( lhs < rhs ); }
+
+#if __cplusplus > 201703L && defined(__cpp_lib_three_way_comparison)
+    /// Compares the bits of lhs and rhs lexicographically, a word at a time.
+    template < typename A, typename G >
+    std::strong_ordering operator<=>( const vector<bool, A, G> & lhs, const vector<bool, A, G> & rhs ){
+        std::size_t n = lhs.size() < rhs.size() ? lhs.size() : rhs.size();
+        std::size_t i = FirstUnequalBit( lhs, rhs, n );
+        if( i < n ){
+            return lhs[i] <=> rhs[i];
+        }
+        return lhs.size() <=> rhs.size();
+    }
+#endif
+} // namespace sc.
+#endif
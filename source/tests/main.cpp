@@ -1,11 +1,128 @@
 #include<iostream>
 #include<vector>
+#include<sstream>
+#include<iterator>
+#include<algorithm>
+#include<type_traits>
+#include<string>
+#include<limits>
+#include<cstdint>
+#include<atomic>
+#include<numeric>
+#include<stdexcept>
+#include<functional>
+#include<thread>
+#include<cmath>
+#include<memory>
+#include<cstdio>
+#include<unistd.h>
 #include "include/tm/test_manager.h"
 #include "../include/vector.h"
+#include "../include/allocator.h"
+#include "../include/small_vector.h"
+#include "../include/growth.h"
+#include "../include/parallel.h"
+#include "../include/flat_set.h"
+#include "../include/flat_map.h"
+#include "../include/soa_vector.h"
+#include "../include/stable_vector.h"
+#include "../include/mmap_vector.h"
+#include "../include/snapshot.h"
+#include "../include/concurrent_vector.h"
+#include "../include/rcu_vector.h"
+#include "../include/radix_sort.h"
 #define which_lib sc
 // To run tests with the STL's vector, uncomment the line below.
 //define which_lib std
 
+/// Element type that counts how many of its objects are alive and how they were built.
+struct Tracked {
+    static int alive;         //!< Objects currently constructed.
+    static int default_ctors; //!< Calls to the default constructor.
+    static int copies;        //!< Calls to the copy constructor.
+    static int moves;         //!< Calls to the move constructor.
+    int value;                //!< The payload.
+
+    Tracked( ) : value{0} { ++alive; ++default_ctors; }
+    Tracked( int v ) : value{v} { ++alive; }
+    Tracked( const Tracked & other ) : value{other.value} { ++alive; ++copies; }
+    Tracked( Tracked && other ) noexcept : value{other.value} { ++alive; ++moves; }
+    Tracked & operator=( const Tracked & other ) = default;
+    Tracked & operator=( Tracked && other ) = default;
+    ~Tracked( ) { --alive; }
+
+    /// Resets all counters (but the ones alive).
+    static void reset( void ) { default_ctors = 0; copies = 0; moves = 0; }
+};
+int Tracked::alive{0};
+int Tracked::default_ctors{0};
+int Tracked::copies{0};
+int Tracked::moves{0};
+
+/// Like Tracked, but declared trivially relocatable, so the vector may move it around with memcpy.
+struct Relocatable : Tracked {
+    using Tracked::Tracked;
+};
+namespace sc {
+    template <> struct is_trivially_relocatable< Relocatable > : std::true_type {};
+}
+
+/// Element type whose copies and moves may throw: when 'fuse' counts down to zero, that one throws.
+struct Fragile {
+    static int alive;   //!< Objects currently constructed.
+    static int fuse;    //!< Copies and moves left until one throws; 0 means never.
+    static int assign_fuse; //!< Likewise for assignments.
+    int value;          //!< The payload.
+
+    Fragile( int v = 0 ) : value{v} { ++alive; }
+    Fragile( const Fragile & other ) : value{other.value} { burn(); ++alive; }
+    Fragile( Fragile && other ) : value{other.value} { burn(); ++alive; }
+    Fragile & operator=( const Fragile & other ) { burn( assign_fuse ); value = other.value; return *this; }
+    Fragile & operator=( Fragile && other ) { burn( assign_fuse ); value = other.value; return *this; }
+    ~Fragile( ) { --alive; value = -1; }   // Poisoned, so a destroyed slot read as live shows up.
+
+    /// Counts one copy or move down on 'count', throwing when it runs out.
+    static void burn( int & count = fuse ) {
+        if( count > 0 && --count == 0 )
+            throw std::runtime_error( "fragile" );
+    }
+};
+int Fragile::alive{0};
+int Fragile::fuse{0};
+int Fragile::assign_fuse{0};
+
+/// Move-only element type with no default constructor, safe to build and destroy from many threads.
+struct Ticket {
+    static std::atomic<int> alive;  //!< Objects currently constructed.
+    int value;                      //!< The payload.
+
+    explicit Ticket( int v ) : value{v} { ++alive; }
+    Ticket( const Ticket & ) = delete;
+    Ticket( Ticket && other ) noexcept : value{other.value} { ++alive; }
+    Ticket & operator=( const Ticket & ) = delete;
+    Ticket & operator=( Ticket && other ) = default;
+    ~Ticket( ) { --alive; }
+};
+std::atomic<int> Ticket::alive{0};
+
+/// Allocator tagged with an id, that asks to be propagated on copy, move and swap.
+template < typename T >
+struct TaggedAllocator {
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    int id;
+
+    TaggedAllocator( int i = 0 ) : id{i} { /* empty */ }
+    template < typename U >
+    TaggedAllocator( const TaggedAllocator<U> & other ) : id{other.id} { /* empty */ }
+    T * allocate( std::size_t n ) { return std::allocator<T>{}.allocate( n ); }
+    void deallocate( T * p, std::size_t n ) { std::allocator<T>{}.deallocate( p, n ); }
+    bool operator==( const TaggedAllocator & other ) const { return id == other.id; }
+    bool operator!=( const TaggedAllocator & other ) const { return id != other.id; }
+};
+
 // ============================================================================
 // TESTING VECTOR AS A CONTAINER OF INTEGERS
 // ============================================================================
@@ -89,19 +206,19 @@ int main( void )
             EXPECT_EQ( (int)i+1, vec2[i] );
     }
 
-    // {
-    // BEGIN_TEST(tm, "MoveConstructor", "move the elements from another");
-    // // Range = the entire vector.
-    // which_lib::vector<int> vec{ 1, 2, 3, 4, 5 };
-    // which_lib::vector<int> vec2( std::move( vec ) );
+    {
+        BEGIN_TEST(tm, "MoveConstructor", "move the elements from another");
+        // Range = the entire vector.
+        which_lib::vector<int> vec{ 1, 2, 3, 4, 5 };
+        which_lib::vector<int> vec2( std::move( vec ) );
 
-    // EXPECT_EQ( vec2.size(), 5 );
-    // // EXPECT_FALSE( vec2.empty() );
+        EXPECT_EQ( vec2.size(), 5 );
+        EXPECT_FALSE( vec2.empty() );
 
-    // // CHeck whether the copy worked.
-    // for( auto i{0u} ; i < vec2.size() ; ++i )
-    // EXPECT_EQ( (int)i+1, vec2[i] );
-    // }
+        // CHeck whether the copy worked.
+        for( auto i{0u} ; i < vec2.size() ; ++i )
+            EXPECT_EQ( (int)i+1, vec2[i] );
+    }
 
     
     {
@@ -121,23 +238,23 @@ int main( void )
     }
 
 
-        // {
-        // BEGIN_TEST(tm, "MoveAssignOperator", "Move Assign Operator");
-        // // Range = the entire vector.
-        // which_lib::vector<int> vec{ 1, 2, 3, 4, 5 };
-        // which_lib::vector<int> vec2;
+    {
+        BEGIN_TEST(tm, "MoveAssignOperator", "Move Assign Operator");
+        // Range = the entire vector.
+        which_lib::vector<int> vec{ 1, 2, 3, 4, 5 };
+        which_lib::vector<int> vec2;
 
-        // vec2 = std::move( vec );
-        // EXPECT_EQ( vec2.size(), 5 );
-        // EXPECT_FALSE( vec2.empty() );
-        // EXPECT_EQ( vec.size(), 0 );
-        // EXPECT_EQ( vec.capacity(), 0 );
-        // EXPECT_TRUE( vec.empty() );
+        vec2 = std::move( vec );
+        EXPECT_EQ( vec2.size(), 5 );
+        EXPECT_FALSE( vec2.empty() );
+        EXPECT_EQ( vec.size(), 0 );
+        EXPECT_EQ( vec.capacity(), 0 );
+        EXPECT_TRUE( vec.empty() );
 
-        // // CHeck whether the copy worked.
-        // for( auto i{0u} ; i < vec2.size() ; ++i )
-        // EXPECT_EQ( (int)i+1, vec2[i] );
-        // }
+        // CHeck whether the copy worked.
+        for( auto i{0u} ; i < vec2.size() ; ++i )
+            EXPECT_EQ( (int)i+1, vec2[i] );
+    }
 
 
     {
@@ -484,6 +601,68 @@ int main( void )
         EXPECT_NE( vec, vec3 );
         EXPECT_NE( vec,vec4 );
     }
+
+    {
+        BEGIN_TEST(tm, "OperatorLess","vec1 < vec2, <=, >, >=");
+        which_lib::vector<int> vec { 1, 2, 3, 4, 5 };
+        which_lib::vector<int> vec2 { 1, 2, 3, 4, 5 };
+        which_lib::vector<int> vec3 { 1, 2, 8, 4, 5 };
+        which_lib::vector<int> vec4 { 1, 2, 3 };
+        which_lib::vector<int> vec5 { -1, 2, 3, 4, 5 };
+
+        EXPECT_TRUE( vec < vec3 );
+        EXPECT_FALSE( vec3 < vec );
+        EXPECT_TRUE( vec4 < vec );
+        EXPECT_TRUE( vec5 < vec );      // Signed order, not byte order.
+        EXPECT_FALSE( vec < vec2 );
+        EXPECT_TRUE( vec <= vec2 );
+        EXPECT_TRUE( vec3 > vec );
+        EXPECT_TRUE( vec >= vec4 );
+        EXPECT_FALSE( vec4 >= vec );
+
+        // Long vectors differing far from the start, and types that need operator< and operator==.
+        which_lib::vector<long> big( 1000 ), big2( 1000 );
+        big2[777] = 1;
+        EXPECT_TRUE( big < big2 );
+        EXPECT_NE( big, big2 );
+        which_lib::vector<std::string> words { "abc", "abd" };
+        which_lib::vector<std::string> words2 { "abc", "abe" };
+        EXPECT_TRUE( words < words2 );
+        EXPECT_NE( words, words2 );
+    }
+
+    {
+        BEGIN_TEST(tm, "FloatingPointCompare","==, < and <=> follow the IEEE rules for NaN and zero");
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        which_lib::vector<double> vec( 37 ), vec2( 37 );
+        for( auto i{0u} ; i < vec.size() ; ++i )
+            vec[i] = vec2[i] = i * 0.5;
+        EXPECT_EQ( vec, vec2 );
+        vec[0] = -0.0;                  // -0.0 == 0.0, although the bytes differ.
+        EXPECT_EQ( vec, vec2 );
+        vec[30] = nan;
+        vec2[30] = nan;                 // NaN != NaN, although the bytes are the same.
+        EXPECT_NE( vec, vec2 );
+        EXPECT_FALSE( vec < vec2 );     // NaN is neither less nor greater: the vectors are equivalent.
+        EXPECT_FALSE( vec2 < vec );
+        vec2[35] = 100;
+        EXPECT_TRUE( vec < vec2 );
+
+        which_lib::vector<float> fvec, fvec2;
+        fvec.assign( 20, 1.0f );
+        fvec2.assign( 20, 1.0f );
+        EXPECT_EQ( fvec, fvec2 );
+        fvec2[19] = 2.0f;               // Decided by the scalar tail.
+        EXPECT_TRUE( fvec < fvec2 );
+        fvec[3] = std::numeric_limits<float>::quiet_NaN();
+        EXPECT_TRUE( fvec < fvec2 );
+        EXPECT_NE( fvec, fvec2 );
+#if __cplusplus > 201703L
+        EXPECT_TRUE( ( vec <=> vec2 ) == std::partial_ordering::unordered );
+        EXPECT_TRUE( ( fvec2 <=> fvec2 ) == std::partial_ordering::equivalent );
+        EXPECT_TRUE( ( which_lib::vector<int>{ 1, 2 } <=> which_lib::vector<int>{ 1, 3 } ) < 0 );
+#endif
+    }
     
     
     {
@@ -577,6 +756,39 @@ int main( void )
     }
 
     
+    {
+        BEGIN_TEST(tm, "FillConstructor","vector<T> vec( count, value ) and bulk assign( count, value )");
+        which_lib::vector<int> vec( 5, 3 );     // Two ints pick the fill constructor, not the range one.
+        EXPECT_EQ( vec , ( which_lib::vector<int>{ 3, 3, 3, 3, 3 } ) );
+        EXPECT_EQ( vec.capacity() , 5 );
+
+        // Zero and byte patterns, then values that need broadcasting, across the vector widths and tails.
+        const int patterns[] = { 0, -1, 0x01010101, 7, -123456 };
+        for( auto p : patterns ){
+            for( auto n : { 1u, 7u, 8u, 33u, 1000u } ){
+                which_lib::vector<int> ivec( n, p );
+                EXPECT_EQ( ivec.size() , n );
+                EXPECT_TRUE( std::all_of( ivec.begin(), ivec.end(), [p]( int x ){ return x == p; } ) );
+            }
+        }
+        which_lib::vector<float> fvec( 20, 1.5f );
+        EXPECT_TRUE( std::all_of( fvec.begin(), fvec.end(), []( float x ){ return x == 1.5f; } ) );
+        which_lib::vector<double> dvec( 4000 );  // Value-initialized: zeroed in bulk.
+        EXPECT_TRUE( std::all_of( dvec.begin(), dvec.end(), []( double x ){ return x == 0.0; } ) );
+        which_lib::vector<std::uint16_t> svec( 37, std::uint16_t( 0x1234 ) );
+        EXPECT_TRUE( std::all_of( svec.begin(), svec.end(), []( std::uint16_t x ){ return x == 0x1234; } ) );
+
+        // Shrinking, growing, and a value that lives in the vector itself.
+        vec.assign( 2, vec[0] );
+        EXPECT_EQ( vec , ( which_lib::vector<int>{ 3, 3 } ) );
+        vec[1] = 9;
+        vec.assign( 40, vec[1] );
+        EXPECT_EQ( vec.size() , 40 );
+        EXPECT_TRUE( std::all_of( vec.begin(), vec.end(), []( int x ){ return x == 9; } ) );
+        vec.assign( 0, 1 );
+        EXPECT_TRUE( vec.empty() );
+    }
+
     {
         BEGIN_TEST(tm, "EraseRange","vec.erase(first, last)");
         // Initial vector.
@@ -925,8 +1137,1981 @@ int main( void )
         }
         EXPECT_FALSE( it1 != it2 );
     }
+
+    {
+        BEGIN_TEST(tm2, "RandomAccess","it[n], it += n, it -= n and relational operators");
+
+        which_lib::vector<int> vec { 1, 2, 4, 5, 6 };
+
+        auto it = vec.begin();
+        EXPECT_EQ( it[3], 5 );
+        it += 4;
+        EXPECT_EQ( *it, 6 );
+        it -= 2;
+        EXPECT_EQ( *it, 4 );
+        EXPECT_TRUE( vec.begin() < it );
+        EXPECT_TRUE( it > vec.begin() );
+        EXPECT_TRUE( it <= it );
+        EXPECT_TRUE( vec.end() >= it );
+        EXPECT_FALSE( vec.end() < it );
+
+        // Iterators convert to const_iterators and compare with them.
+        which_lib::vector<int>::const_iterator cit = it;
+        EXPECT_TRUE( cit == it );
+        EXPECT_EQ( vec.cend() - it, 3 );
+        it[0] = 3;
+        EXPECT_EQ( vec[2], 3 );
+    }
+
+    {
+        BEGIN_TEST(tm2, "StandardAlgorithms","std::sort, std::lower_bound and reverse iterators");
+
+        using iter = which_lib::vector<int>::iterator;
+        EXPECT_TRUE( ( std::is_same< std::iterator_traits<iter>::iterator_category, std::random_access_iterator_tag >::value ) );
+#if __cplusplus > 201703L
+        static_assert( std::contiguous_iterator< iter >, "the iterator must be contiguous" );
+        static_assert( std::contiguous_iterator< which_lib::vector<int>::const_iterator >, "the const_iterator must be contiguous" );
+#endif
+
+        which_lib::vector<int> vec { 9, 3, 7, 1, 5, 8, 2 };
+        std::sort( vec.begin(), vec.end() );
+        EXPECT_EQ( vec, ( which_lib::vector<int>{ 1, 2, 3, 5, 7, 8, 9 } ) );
+        auto pos = std::lower_bound( vec.begin(), vec.end(), 6 );
+        EXPECT_EQ( *pos, 7 );
+        EXPECT_EQ( std::distance( vec.begin(), pos ), 4 );
+
+        which_lib::vector<int> reversed( vec.rbegin(), vec.rend() );
+        EXPECT_EQ( reversed, ( which_lib::vector<int>{ 9, 8, 7, 5, 3, 2, 1 } ) );
+        const which_lib::vector<int> & cvec = vec;
+        EXPECT_EQ( *cvec.rbegin(), 9 );
+        EXPECT_EQ( cvec.crend() - cvec.crbegin(), 7 );
+        auto sum{0};
+        for( auto x : cvec )
+            sum += x;
+        EXPECT_EQ( sum, 35 );
+    }
     
     tm2.summary();
-    
+    std::cout << "\n\n";
+
+
+    // Third batch of tests, focused on the lifetime of the stored elements.
+
+    TestManager tm3{ "Element lifetime testing"};
+
+    {
+        BEGIN_TEST(tm3, "GrowthNoDefaultCtor","push_back() never default constructs spare capacity");
+
+        Tracked::reset();
+        {
+            which_lib::vector<Tracked> vec;
+            for( auto i{0} ; i < 100 ; ++i )
+            {
+                vec.push_back( Tracked{i} );
+                EXPECT_EQ( Tracked::alive, (int)vec.size() );
+            }
+            EXPECT_EQ( Tracked::default_ctors, 0 );
+
+            // A single growth relocates exactly size() elements, by move since it is noexcept.
+            Tracked::reset();
+            auto sz = vec.size();
+            vec.reserve( vec.capacity() + 1 );
+            EXPECT_EQ( Tracked::moves, (int)sz );
+            EXPECT_EQ( Tracked::copies, 0 );
+            EXPECT_EQ( Tracked::alive, (int)sz );
+            EXPECT_EQ( Tracked::default_ctors, 0 );
+        }
+        EXPECT_EQ( Tracked::alive, 0 );
+    }
+
+    {
+        BEGIN_TEST(tm3, "ModifiersDestroy","erase(), pop_back() and clear() end the lifetime of removed elements");
+
+        {
+            which_lib::vector<Tracked> vec{ 1, 2, 3, 4, 5, 6, 7, 8 };
+            EXPECT_EQ( Tracked::alive, 8 );
+            vec.pop_back();
+            EXPECT_EQ( Tracked::alive, 7 );
+            vec.erase( vec.begin() );
+            EXPECT_EQ( Tracked::alive, 6 );
+            vec.erase( vec.begin(), vec.begin()+2 );
+            EXPECT_EQ( Tracked::alive, 4 );
+            vec.insert( vec.begin()+1, Tracked{10} );
+            EXPECT_EQ( Tracked::alive, 5 );
+            vec.assign( 2, Tracked{0} );
+            EXPECT_EQ( Tracked::alive, 2 );
+            vec.clear();
+            EXPECT_EQ( Tracked::alive, 0 );
+            EXPECT_EQ( Tracked::default_ctors, 0 );
+        }
+        EXPECT_EQ( Tracked::alive, 0 );
+    }
+
+    {
+        BEGIN_TEST(tm3, "MoveStealsBuffer","moving a vector never touches its elements");
+
+        {
+            which_lib::vector<Tracked> vec{ 1, 2, 3 };
+            Tracked::reset();
+            auto storage = &vec[0];
+
+            which_lib::vector<Tracked> vec2( std::move( vec ) );
+            EXPECT_EQ( &vec2[0], storage );
+            which_lib::vector<Tracked> vec3;
+            vec3 = std::move( vec2 );
+            EXPECT_EQ( &vec3[0], storage );
+            EXPECT_EQ( Tracked::copies + Tracked::moves, 0 );
+            EXPECT_EQ( Tracked::alive, 3 );
+
+            // Nested vectors are relocated by stealing their buffers too.
+            which_lib::vector< which_lib::vector<Tracked> > outer;
+            for( auto i{0} ; i < 9 ; ++i )
+                outer.push_back( vec3 );
+            Tracked::reset();
+            outer.reserve( outer.capacity() + 1 );
+            EXPECT_EQ( Tracked::copies + Tracked::moves, 0 );
+        }
+        EXPECT_EQ( Tracked::alive, 0 );
+    }
+
+    {
+        BEGIN_TEST(tm3, "TriviallyRelocatable","opted-in types are relocated without running constructors");
+
+        {
+            which_lib::vector<Relocatable> vec;
+            for( auto i{0} ; i < 10 ; ++i )
+                vec.push_back( Relocatable{i} );
+            Tracked::reset();
+            vec.reserve( 100 );
+            vec.push_front( Relocatable{-1} );
+            vec.insert( vec.begin()+5, Relocatable{42} );
+            vec.erase( vec.begin()+1, vec.begin()+3 );
+            // Only the two new elements were built; nothing that was already stored moved by constructor.
+            EXPECT_EQ( Tracked::copies + Tracked::moves, 2 );
+            EXPECT_EQ( Tracked::alive, 10 );
+            int expected[]{ -1, 2, 3, 42, 4, 5, 6, 7, 8, 9 };
+            for( auto i{0u} ; i < vec.size() ; ++i )
+                EXPECT_EQ( vec[i].value, expected[i] );
+        }
+        EXPECT_EQ( Tracked::alive, 0 );
+    }
+
+    {
+        BEGIN_TEST(tm3, "InsertOwnElement","inserting a reference to an element of the same vector");
+
+        which_lib::vector<int> vec{ 1, 2, 3, 4 };
+        vec.insert( vec.begin(), vec[2] );    // Full: grows while copying.
+        EXPECT_EQ( vec, ( which_lib::vector<int>{ 3, 1, 2, 3, 4 } ) );
+        vec.insert( vec.begin(), vec[4] );    // Room available: memmove path.
+        EXPECT_EQ( vec, ( which_lib::vector<int>{ 4, 3, 1, 2, 3, 4 } ) );
+
+        which_lib::vector<Tracked> vec2{ 1, 2, 3, 4 };
+        vec2.reserve( 8 );
+        vec2.insert( vec2.begin()+1, vec2[3] ); // Room available: element by element path.
+        int expected[]{ 1, 4, 2, 3, 4 };
+        for( auto i{0u} ; i < vec2.size() ; ++i )
+            EXPECT_EQ( vec2[i].value, expected[i] );
+
+        // An assignment that throws while the elements shift leaves no element past the end.
+        Fragile::alive = 0;
+        {
+            which_lib::vector<Fragile> fragile;
+            fragile.reserve( 8 );
+            for( auto i{0} ; i < 4 ; ++i )
+                fragile.emplace_back( i );
+            Fragile::assign_fuse = 2;
+            bool caught{false};
+            try{
+                fragile.insert( fragile.begin(), Fragile{ -1 } );
+            }catch( const std::runtime_error & ){
+                caught = true;
+            }
+            Fragile::assign_fuse = 0;
+            EXPECT_TRUE( caught );
+            EXPECT_EQ( fragile.size(), 4u );
+            EXPECT_EQ( Fragile::alive, 4 );
+        }
+        EXPECT_EQ( Fragile::alive, 0 );
+    }
+    {
+        BEGIN_TEST(tm3, "Emplace","emplace_back() and emplace() build elements in place, rvalues are moved");
+
+        which_lib::vector<Tracked> vec;
+        vec.reserve( 8 );
+        Tracked::reset();
+        auto & last = vec.emplace_back( 5 );
+        EXPECT_EQ( last.value, 5 );
+        EXPECT_EQ( Tracked::copies, 0 );
+        EXPECT_EQ( Tracked::moves, 0 );
+
+        vec.push_back( Tracked{ 7 } );
+        vec.insert( vec.begin(), Tracked{ 1 } );
+        EXPECT_EQ( Tracked::copies, 0 );
+
+        vec.emplace( vec.begin()+1, 3 );
+        vec.emplace( vec.end(), 9 );
+        vec.emplace( vec.begin(), vec[2] );     // Argument aliases an element that shifts.
+        int expected[]{ 5, 1, 3, 5, 7, 9 };
+        EXPECT_EQ( vec.size(), 6u );
+        for( auto i{0u} ; i < vec.size() ; ++i )
+            EXPECT_EQ( vec[i].value, expected[i] );
+
+        which_lib::vector<int> vec2;
+        for( auto i{0} ; i < 5 ; ++i )
+            vec2.push_back( vec2.empty() ? 1 : vec2.back() );   // Argument aliases the buffer that grows.
+        EXPECT_EQ( vec2, ( which_lib::vector<int>{ 1, 1, 1, 1, 1 } ) );
+    }
+    {
+        BEGIN_TEST(tm3, "FrontHeadroom","push_front() and pop_front() are amortized O(1)");
+
+        {
+            which_lib::vector<Tracked> vec;
+            Tracked::reset();
+            for( auto i{0} ; i < 1000 ; ++i )
+                vec.push_front( Tracked{ i } );
+            // Each push moves its own temporary, plus a bounded share of relocations.
+            EXPECT_LT( Tracked::copies + Tracked::moves, 3000 );
+            EXPECT_GT( vec.front_capacity(), 0u );
+            bool ok{ true };
+            for( auto i{0} ; i < 1000 ; ++i )
+                ok = ok && vec[i].value == 999 - i && &vec[i] == vec.data() + i;
+            EXPECT_TRUE( ok );
+
+            vec.push_front( vec[10] );      // Argument aliases an element.
+            EXPECT_EQ( vec.front().value, 989 );
+            vec.emplace_front( -1 );
+            EXPECT_EQ( vec.front().value, -1 );
+            EXPECT_EQ( vec.size(), 1002u );
+        }
+        EXPECT_EQ( Tracked::alive, 0 );
+
+        // Work queue: the headroom left by pop_front() is reused, so the block stays small.
+        which_lib::vector<int> queue;
+        for( auto i{0} ; i < 100000 ; ++i ){
+            queue.push_back( i );
+            queue.push_back( i );
+            queue.pop_front();
+        }
+        EXPECT_EQ( queue.size(), 100000u );
+        EXPECT_EQ( queue.front(), 50000 );
+        EXPECT_EQ( queue.back(), 99999 );
+        EXPECT_LT( queue.front_capacity() + queue.capacity(), 300000u );
+        while( !queue.empty() )
+            queue.pop_front();
+        EXPECT_EQ( queue.front_capacity(), 0u );
+
+        // Sliding a small vector keeps it inline.
+        sc::small_vector<int, 8> small{ 1, 2, 3 };
+        small.pop_front();
+        small.push_front( 0 );
+        small.push_front( -1 );
+        EXPECT_TRUE( small.is_inline() );
+        EXPECT_EQ( small.front(), -1 );
+        EXPECT_EQ( small.size(), 4u );
+
+        // Assignments that fit once the headroom is given back reuse the block.
+        {
+            which_lib::vector<int> target{ 1, 2, 3, 4, 5, 6, 7, 8 };
+            target.pop_front();
+            target.pop_front();
+            const int * block = target.data() - target.front_capacity();
+            which_lib::vector<int> source{ 9, 8, 7, 6, 5, 4, 3 };
+            target = source;
+            EXPECT_EQ( target.data(), block );
+            EXPECT_EQ( target, source );
+            target.pop_front();
+            target.assign( { 1, 2, 3, 4, 5, 6, 7, 8 } );
+            EXPECT_EQ( target.data(), block );
+            EXPECT_EQ( target.back(), 8 );
+
+            sc::small_vector<int, 4> inline_target{ 1, 2, 3, 4 };
+            inline_target.pop_front();
+            inline_target.pop_front();
+            sc::small_vector<int, 4> inline_source{ 5, 6, 7, 8 };
+            inline_target = std::move( inline_source );
+            EXPECT_TRUE( inline_target.is_inline() );   // No heap block inside the noexcept move.
+            EXPECT_EQ( inline_target, ( sc::small_vector<int, 4>{ 5, 6, 7, 8 } ) );
+        }
+
+        // Elements whose move may throw never slide in place, so a throw leaves the vector as it was.
+        {
+            which_lib::vector<Fragile> fragile;
+            for( auto i{0} ; i < 8 ; ++i )
+                fragile.push_back( Fragile{ i } );
+            for( auto i{0} ; i < 4 ; ++i )
+                fragile.pop_front();
+            Fragile::fuse = 3;
+            try{
+                fragile.push_back( Fragile{ 8 } );
+                fragile.push_back( Fragile{ 9 } );
+            }catch( const std::runtime_error & ){ /* expected */ }
+            Fragile::fuse = 0;
+            bool ok{ true };
+            for( auto i{0u} ; i < fragile.size() ; ++i )
+                ok = ok && fragile[i].value == 4 + (int)i;
+            EXPECT_TRUE( ok );
+            EXPECT_EQ( Fragile::alive, (int)fragile.size() );
+
+            which_lib::vector<Fragile> roomy;
+            roomy.reserve( 16 );
+            for( auto i{0} ; i < 4 ; ++i )
+                roomy.push_back( Fragile{ i } );
+            Fragile::fuse = 3;
+            try{
+                roomy.push_front( Fragile{ -1 } );
+            }catch( const std::runtime_error & ){ /* expected */ }
+            Fragile::fuse = 0;
+            EXPECT_EQ( roomy.size(), 4u );
+            EXPECT_EQ( roomy.front().value, 0 );
+            EXPECT_EQ( roomy.back().value, 3 );
+            EXPECT_EQ( Fragile::alive, (int)( fragile.size() + roomy.size() ) );
+        }
+        EXPECT_EQ( Fragile::alive, 0 );
+    }
+    {
+        BEGIN_TEST(tm3, "EraseIf","range erase moves the tail once, erase_if() and retain() compact in one pass");
+
+        {
+            which_lib::vector<Tracked> vec;
+            vec.reserve( 10 );
+            for( auto i{0} ; i < 10 ; ++i )
+                vec.emplace_back( i );
+            Tracked::reset();
+            vec.erase( vec.begin()+1, vec.begin()+4 );
+            EXPECT_EQ( Tracked::alive, 7 );
+            EXPECT_EQ( vec[1].value, 4 );
+            EXPECT_EQ( vec.back().value, 9 );
+
+            auto calls{0};
+            auto removed = vec.erase_if( [&calls]( const Tracked & t ){ ++calls; return t.value % 2 == 0; } );
+            EXPECT_EQ( removed, 4u );
+            EXPECT_EQ( calls, 7 );
+            EXPECT_EQ( Tracked::alive, 3 );
+            EXPECT_EQ( Tracked::copies, 0 );
+            int expected[]{ 5, 7, 9 };
+            for( auto i{0u} ; i < vec.size() ; ++i )
+                EXPECT_EQ( vec[i].value, expected[i] );
+        }
+        EXPECT_EQ( Tracked::alive, 0 );
+
+        {
+            which_lib::vector<Relocatable> vec;
+            for( auto i{0} ; i < 10 ; ++i )
+                vec.emplace_back( i );
+            Tracked::reset();
+            EXPECT_EQ( vec.retain( []( const Relocatable & r ){ return r.value < 3 || r.value > 7; } ), 5u );
+            EXPECT_EQ( Tracked::copies + Tracked::moves, 0 );
+            EXPECT_EQ( Tracked::alive, 5 );
+            int expected[]{ 0, 1, 2, 8, 9 };
+            for( auto i{0u} ; i < vec.size() ; ++i )
+                EXPECT_EQ( vec[i].value, expected[i] );
+        }
+        EXPECT_EQ( Tracked::alive, 0 );
+
+        // Arithmetic types of every width go through the compaction kernel, tail included.
+        which_lib::vector<int> ints;
+        which_lib::vector<double> doubles;
+        which_lib::vector<char> chars;
+        for( auto i{0} ; i < 1003 ; ++i ){
+            ints.push_back( i );
+            doubles.push_back( i );
+            chars.push_back( static_cast<char>( i % 100 ) );
+        }
+        EXPECT_EQ( ints.erase_if( []( int x ){ return x % 3 == 0; } ), 335u );
+        EXPECT_EQ( doubles.retain( []( double x ){ return x >= 1000; } ), 1000u );
+        EXPECT_EQ( chars.erase_if( []( char c ){ return c >= 10; } ), 900u );
+        bool ok{ true };
+        for( auto i{0u} ; i < ints.size() ; ++i )
+            ok = ok && ints[i] == static_cast<int>( i / 2 * 3 + i % 2 + 1 );
+        EXPECT_TRUE( ok );
+        EXPECT_EQ( doubles, ( which_lib::vector<double>{ 1000, 1001, 1002 } ) );
+        EXPECT_EQ( chars.size(), 103u );
+        EXPECT_EQ( chars[100], 0 );
+    }
+    {
+        BEGIN_TEST(tm3, "FillLifetime","fill construction copies the value once per element and keeps it alive while growing");
+        Tracked::reset();
+        {
+            which_lib::vector<Tracked> vec( 6, Tracked( 4 ) );
+            EXPECT_EQ( Tracked::copies , 6 );
+            EXPECT_EQ( Tracked::default_ctors , 0 );
+            EXPECT_EQ( Tracked::alive , 6 );
+
+            Tracked::reset();
+            vec.assign( 20, vec[5] );           // Grows: the old block holds the value until the new one is full.
+            EXPECT_EQ( vec.size() , 20 );
+            EXPECT_EQ( Tracked::copies , 20 );
+            EXPECT_EQ( Tracked::alive , 20 );
+            EXPECT_TRUE( std::all_of( vec.begin(), vec.end(), []( const Tracked & t ){ return t.value == 4; } ) );
+
+            vec.assign( 3, Tracked( 8 ) );      // Shrinks in place: assigned, never rebuilt.
+            EXPECT_EQ( Tracked::alive , 3 );
+            EXPECT_EQ( vec[2].value , 8 );
+        }
+        EXPECT_EQ( Tracked::alive , 0 );
+    }
+    {
+        BEGIN_TEST(tm3, "InsertEngine","range inserts grow at most once and build new elements in place");
+
+        {
+            which_lib::vector<Tracked> source;
+            for( auto i{0} ; i < 5 ; ++i )
+                source.emplace_back( 100 + i );
+            which_lib::vector<Tracked> vec;
+            vec.reserve( 10 );
+            for( auto i{0} ; i < 10 ; ++i )
+                vec.emplace_back( i );
+
+            // Full: one new block, the old elements move once, the new ones are copied once.
+            Tracked::reset();
+            vec.insert( vec.begin()+4, source.begin(), source.end() );
+            EXPECT_EQ( Tracked::copies, 5 );
+            EXPECT_EQ( Tracked::moves, 10 );
+            EXPECT_GE( vec.capacity(), 15u );
+
+            // Room available: only the tail after the position moves.
+            vec.reserve( 40 );
+            Tracked::reset();
+            vec.insert( vec.begin()+12, { Tracked{ -1 }, Tracked{ -2 } } );
+            EXPECT_EQ( Tracked::moves, 3 );
+            EXPECT_EQ( Tracked::copies, 2 );
+
+            // A range larger than doubling would give still takes a single growth.
+            which_lib::vector<Tracked> big;
+            for( auto i{0} ; i < 100 ; ++i )
+                big.emplace_back( i );
+            which_lib::vector<Tracked> small;
+            small.emplace_back( -5 );
+            Tracked::reset();
+            small.insert( small.begin(), big.begin(), big.end() );
+            EXPECT_EQ( Tracked::moves, 1 );
+            EXPECT_EQ( small.size(), 101u );
+            EXPECT_EQ( small.back().value, -5 );
+
+            int expected[]{ 0, 1, 2, 3, 100, 101, 102, 103, 104, 4, 5, 6, -1, -2, 7, 8, 9 };
+            EXPECT_EQ( vec.size(), 17u );
+            for( auto i{0u} ; i < vec.size() ; ++i )
+                EXPECT_EQ( vec[i].value, expected[i] );
+        }
+        EXPECT_EQ( Tracked::alive, 0 );
+
+        // Elements whose move may throw are not shifted to open the gap, so a throw loses nothing.
+        {
+            which_lib::vector<Fragile> fragile;
+            fragile.reserve( 16 );
+            for( auto i{0} ; i < 6 ; ++i )
+                fragile.push_back( Fragile{ i } );
+            which_lib::vector<Fragile> source;
+            source.push_back( Fragile{ 10 } );
+            source.push_back( Fragile{ 11 } );
+            Fragile::fuse = 4;
+            try{
+                fragile.insert( fragile.begin()+1, source.begin(), source.end() );
+            }catch( const std::runtime_error & ){ /* expected */ }
+            Fragile::fuse = 0;
+            bool ok{ fragile.size() == 6u };
+            for( auto i{0u} ; i < fragile.size() ; ++i )
+                ok = ok && fragile[i].value == (int)i;
+            EXPECT_TRUE( ok );
+            EXPECT_EQ( Fragile::alive, 8 );
+
+            // Without a throw the insertion keeps the capacity it had room in.
+            fragile.insert( fragile.begin()+1, source.begin(), source.end() );
+            EXPECT_EQ( fragile.capacity(), 16u );
+            EXPECT_EQ( fragile[1].value, 10 );
+            EXPECT_EQ( fragile[3].value, 1 );
+        }
+        EXPECT_EQ( Fragile::alive, 0 );
+
+        // Single-pass input: appended with geometric growth, then rotated into place.
+        which_lib::vector<int> vec{ 1, 2, 3 };
+        std::istringstream in{ "7 8 9 10" };
+        vec.insert( vec.begin()+1, std::istream_iterator<int>{ in }, std::istream_iterator<int>{} );
+        EXPECT_EQ( vec, ( which_lib::vector<int>{ 1, 7, 8, 9, 10, 2, 3 } ) );
+
+        // At the front, the headroom left by pop_front() is used.
+        vec.pop_front();
+        vec.pop_front();
+        auto capacity = vec.capacity();
+        vec.insert( vec.begin(), { -2, -1 } );
+        EXPECT_EQ( vec.capacity(), capacity + 2 );
+        EXPECT_EQ( vec, ( which_lib::vector<int>{ -2, -1, 8, 9, 10, 2, 3 } ) );
+    }
+
+    tm3.summary();
+    std::cout << "\n\n";
+
+
+    // Fourth batch of tests, focused on custom allocators.
+
+    TestManager tm4{ "Allocator testing"};
+
+    {
+        BEGIN_TEST(tm4, "ArenaAllocator","vector drawing memory from an arena");
+
+        sc::arena arena;
+        {
+            sc::vector< int, sc::arena_allocator<int> > vec{ sc::arena_allocator<int>{ arena } };
+            for( auto i{0} ; i < 1000 ; ++i )
+                vec.push_back( i );
+            for( auto i{0u} ; i < vec.size() ; ++i )
+                EXPECT_EQ( vec[i], (int)i );
+            EXPECT_GE( arena.bytes_allocated(), 1000 * sizeof(int) );
+
+            // Copies keep drawing from the same arena.
+            auto before = arena.bytes_allocated();
+            auto vec2 = vec;
+            EXPECT_EQ( vec2.get_allocator(), vec.get_allocator() );
+            EXPECT_GT( arena.bytes_allocated(), before );
+        }
+        arena.release();
+        EXPECT_EQ( arena.bytes_allocated(), 0u );
+
+        // Over-aligned requests are aligned on the address, not just on the offset in the chunk.
+        struct alignas(64) Wide { float lanes[16]; };
+        arena.allocate( 1, 1 );
+        for( auto i{0} ; i < 4 ; ++i ){
+            Wide * w = sc::arena_allocator<Wide>{ arena }.allocate( 1 );
+            EXPECT_EQ( reinterpret_cast<std::uintptr_t>( w ) % alignof( Wide ), 0u );
+            EXPECT_EQ( reinterpret_cast<std::uintptr_t>( arena.allocate( 8, 256 ) ) % 256, 0u );
+        }
+    }
+
+    {
+        BEGIN_TEST(tm4, "PoolAllocator","vector drawing memory from a fixed-size pool");
+
+        sc::fixed_pool pool( 16 * sizeof(long), 4 );
+        {
+            sc::vector< long, sc::pool_allocator<long> > vec( 0, sc::pool_allocator<long>{ pool } );
+            vec.reserve( 16 );
+            EXPECT_EQ( pool.in_use(), 1u );
+            for( auto i{0} ; i < 16 ; ++i )
+                vec.push_back( i );
+            EXPECT_EQ( pool.in_use(), 1u );
+            // Too big for a block: served by the global heap.
+            vec.push_back( 16 );
+            EXPECT_EQ( pool.in_use(), 0u );
+            for( auto i{0u} ; i < vec.size() ; ++i )
+                EXPECT_EQ( vec[i], (long)i );
+            vec.shrink_to_fit();
+        }
+        EXPECT_EQ( pool.in_use(), 0u );
+    }
+
+    {
+        BEGIN_TEST(tm4, "AllocatorPropagation","copy, move and swap follow the allocator traits");
+
+        using tagged_vec = sc::vector< int, TaggedAllocator<int> >;
+        tagged_vec vec1( { 1, 2, 3 }, TaggedAllocator<int>{ 1 } );
+        tagged_vec vec2( { 4, 5 }, TaggedAllocator<int>{ 2 } );
+
+        vec2 = vec1;
+        EXPECT_EQ( vec2.get_allocator().id, 1 );
+        EXPECT_EQ( vec2, vec1 );
+
+        tagged_vec vec3( TaggedAllocator<int>{ 3 } );
+        vec3 = std::move( vec1 );
+        EXPECT_EQ( vec3.get_allocator().id, 1 );
+        EXPECT_EQ( vec3.size(), 3u );
+
+        tagged_vec vec4( { 9 }, TaggedAllocator<int>{ 4 } );
+        swap( vec3, vec4 );
+        EXPECT_EQ( vec3.get_allocator().id, 4 );
+        EXPECT_EQ( vec4.get_allocator().id, 1 );
+        EXPECT_EQ( vec4.size(), 3u );
+
+        // Arena allocators do not propagate: moving between arenas moves the elements instead.
+        sc::arena a1, a2;
+        sc::vector< int, sc::arena_allocator<int> > avec1( { 1, 2, 3 }, sc::arena_allocator<int>{ a1 } );
+        sc::vector< int, sc::arena_allocator<int> > avec2( sc::arena_allocator<int>{ a2 } );
+        avec2 = std::move( avec1 );
+        EXPECT_EQ( avec2.get_allocator().resource(), &a2 );
+        EXPECT_EQ( avec2.size(), 3u );
+        EXPECT_TRUE( avec1.empty() );
+    }
+
+    {
+        BEGIN_TEST(tm4, "GrowthPolicy","the capacity follows the chosen growth policy");
+
+        sc::vector< int, std::allocator<int>, sc::one_and_half_growth > vec;
+        sc::vector< int >::size_type expected[]{ 1, 2, 3, 4, 6, 6, 9, 9, 9, 13 };
+        for( auto i{0} ; i < 10 ; ++i ){
+            vec.push_back( i );
+            EXPECT_EQ( vec.capacity(), expected[i] );
+        }
+
+        sc::vector< int, std::allocator<int>, sc::geometric_growth< 2, 1, 16 > > vec2;
+        vec2.push_back( 1 );
+        EXPECT_EQ( vec2.capacity(), 16u );
+        vec2.insert( vec2.begin(), { 2, 3 } );
+        EXPECT_EQ( vec2, ( sc::vector< int, std::allocator<int>, sc::geometric_growth< 2, 1, 16 > >{ 2, 3, 1 } ) );
+
+        // Small blocks are rounded to malloc size classes, large ones to whole pages.
+        sc::vector< char, std::allocator<char>, sc::size_class_growth<> > vec3;
+        vec3.push_back( 'a' );
+        EXPECT_EQ( vec3.capacity(), 16u );
+        EXPECT_EQ( sc::size_class_growth<>::RoundBytes( 129 ), 160u );
+        EXPECT_EQ( sc::size_class_growth<>::RoundBytes( 257 ), 320u );
+        sc::vector< double, std::allocator<double>, sc::size_class_growth<> > vec4;
+        for( auto i{0} ; i < 5000 ; ++i )
+            vec4.push_back( i );
+        EXPECT_EQ( vec4.capacity() * sizeof( double ) % 4096, 0u );
+        EXPECT_EQ( vec4[4999], 4999.0 );
+    }
+
+    {
+        BEGIN_TEST(tm4, "ReallocateInPlace","trivially relocatable elements grow through realloc()");
+
+        EXPECT_TRUE( sc::has_reallocate< sc::malloc_allocator<int> >::value );
+        EXPECT_FALSE( sc::has_reallocate< std::allocator<int> >::value );
+
+        sc::vector< int, sc::malloc_allocator<int> > vec;
+        for( auto i{0} ; i < 100000 ; ++i )
+            vec.push_back( i );
+        vec.push_back( vec[7] );    // Argument aliases the block being resized.
+        bool ok{ true };
+        for( auto i{0} ; i < 100000 ; ++i )
+            ok = ok && vec[i] == i;
+        EXPECT_TRUE( ok );
+        EXPECT_EQ( vec.back(), 7 );
+        vec.shrink_to_fit();
+        EXPECT_EQ( vec.capacity(), 100001u );
+
+        {
+            sc::vector< Relocatable, sc::malloc_allocator<Relocatable> > vec2;
+            Tracked::reset();
+            for( auto i{0} ; i < 100 ; ++i )
+                vec2.emplace_back( i );
+            EXPECT_EQ( Tracked::copies, 0 );
+            EXPECT_EQ( vec2[99].value, 99 );
+            EXPECT_EQ( Tracked::alive, 100 );
+        }
+        EXPECT_EQ( Tracked::alive, 0 );
+    }
+
+    tm4.summary();
+    std::cout << "\n\n";
+
+
+    // Fifth batch of tests, focused on the small vector.
+
+    TestManager tm5{ "Small vector testing"};
+
+    {
+        BEGIN_TEST(tm5, "InlineStorage","small_vector keeps up to N elements inline");
+
+        sc::small_vector<int, 8> vec;
+        EXPECT_EQ( vec.capacity(), 8u );
+        EXPECT_TRUE( vec.is_inline() );
+        for( auto i{0} ; i < 8 ; ++i )
+            vec.push_back( i );
+        EXPECT_TRUE( vec.is_inline() );
+        EXPECT_EQ( vec.capacity(), 8u );
+
+        // The ninth element spills to the heap.
+        vec.push_back( 8 );
+        EXPECT_FALSE( vec.is_inline() );
+        EXPECT_EQ( vec.capacity(), 16u );
+        for( auto i{0u} ; i < vec.size() ; ++i )
+            EXPECT_EQ( vec[i], (int)i );
+
+        // Back inline once it fits again.
+        vec.erase( vec.begin()+4, vec.end() );
+        vec.shrink_to_fit();
+        EXPECT_TRUE( vec.is_inline() );
+        EXPECT_EQ( vec, ( sc::small_vector<int, 8>{ 0, 1, 2, 3 } ) );
+    }
+
+    {
+        BEGIN_TEST(tm5, "CopyMoveSwap","copying, moving and swapping small vectors");
+
+        {
+            sc::small_vector<Tracked, 4> vec{ 1, 2, 3 };
+            sc::small_vector<Tracked, 4> copy{ vec };
+            EXPECT_TRUE( copy.is_inline() );
+            EXPECT_EQ( copy.size(), 3u );
+            EXPECT_EQ( copy[2].value, 3 );
+
+            sc::small_vector<Tracked, 4> moved{ std::move( copy ) };
+            EXPECT_TRUE( moved.is_inline() );
+            EXPECT_EQ( moved.size(), 3u );
+            EXPECT_TRUE( copy.empty() );
+
+            sc::small_vector<Tracked, 4> big{ 1, 2, 3, 4, 5, 6 };
+            EXPECT_FALSE( big.is_inline() );
+            swap( moved, big );
+            EXPECT_EQ( moved.size(), 6u );
+            EXPECT_EQ( big.size(), 3u );
+            EXPECT_EQ( big[0].value, 1 );
+            EXPECT_EQ( moved[5].value, 6 );
+
+            // A spilled vector hands its heap block over instead of moving the elements.
+            Tracked::reset();
+            const Tracked * block = moved.data();
+            sc::small_vector<Tracked, 4> stolen{ std::move( moved ) };
+            EXPECT_EQ( stolen.data(), block );
+            EXPECT_EQ( Tracked::moves, 0 );
+            EXPECT_TRUE( moved.empty() );
+            EXPECT_TRUE( moved.is_inline() );
+            big = std::move( stolen );
+            EXPECT_EQ( big.data(), block );
+            EXPECT_EQ( big.size(), 6u );
+            EXPECT_EQ( Tracked::moves, 0 );
+            EXPECT_TRUE( stolen.is_inline() );
+            stolen.push_back( 7 );
+            EXPECT_EQ( stolen[0].value, 7 );
+
+            // So a vector of small vectors moves them when it regrows.
+            static_assert( std::is_nothrow_move_constructible< sc::small_vector<Tracked, 4> >::value,
+                           "small_vector must move without throwing" );
+
+            // A plain vector copied out of a small_vector gets a heap-only allocator, not our buffer.
+            sc::vector< Tracked, sc::inline_allocator<Tracked, 4> > sliced = big;
+            EXPECT_EQ( sliced.get_allocator().buffer(), nullptr );
+            EXPECT_NE( sliced.data(), big.data() );
+            EXPECT_EQ( sliced.size(), 6u );
+        }
+        EXPECT_EQ( Tracked::alive, 0 );
+    }
+
+    {
+        BEGIN_TEST(tm5, "Constructors","small_vector takes the constructor arguments sc::vector takes");
+        sc::small_vector<int, 4> filled( 3, 5 );        // Two ints: a count and a value, not a range.
+        EXPECT_EQ( filled, ( sc::small_vector<int, 4>{ 5, 5, 5 } ) );
+        EXPECT_TRUE( filled.is_inline() );
+        sc::small_vector<int, 4> spilled( 6u, 1 );
+        EXPECT_EQ( spilled.size(), 6u );
+        EXPECT_FALSE( spilled.is_inline() );
+        EXPECT_EQ( std::count( spilled.begin(), spilled.end(), 1 ), 6 );
+
+        sc::small_vector<int, 4>::allocator_type alloc;
+        sc::small_vector<int, 4> empty( alloc );
+        EXPECT_TRUE( empty.empty() );
+        EXPECT_EQ( empty.capacity(), 4u );
+        sc::small_vector<int, 4> sized( 2, alloc );
+        EXPECT_EQ( sized, ( sc::small_vector<int, 4>{ 0, 0 } ) );
+        int raw[] = { 7, 8, 9 };
+        sc::small_vector<int, 4> ranged( raw, raw + 3, alloc );
+        EXPECT_EQ( ranged.back(), 9 );
+        EXPECT_TRUE( ranged.is_inline() );              // The buffer is its own, whatever was passed.
+        sc::small_vector<int, 4> listed( { 1, 2 }, alloc );
+        EXPECT_EQ( listed.size(), 2u );
+    }
+
+    tm5.summary();
+    std::cout << "\n\n";
+
+
+    // Sixth batch of tests, focused on the parallel algorithms.
+
+    TestManager tm6{ "Parallel algorithms testing"};
+
+    {
+        BEGIN_TEST(tm6, "ThreadPool","every task runs once, nested batches run inline and the first exception reaches the caller");
+        sc::par::thread_pool pool( 4 );
+        EXPECT_EQ( pool.size(), 4u );
+        std::vector< std::atomic<int> > hits( 1000 );
+        for( int round{0} ; round < 3 ; ++round ){
+            pool.run( hits.size(), [&]( std::size_t i ){ ++hits[i]; } );
+        }
+        EXPECT_TRUE( std::all_of( hits.begin(), hits.end(), []( const std::atomic<int> & h ){ return h == 3; } ) );
+
+        // Nested batches run inline, whichever thread, the caller's included, picks the outer task up.
+        std::atomic<int> inner{0};
+        for( int round{0} ; round < 100 ; ++round ){
+            pool.run( 8, [&]( std::size_t ){ pool.run( 4, [&]( std::size_t ){ ++inner; } ); } );
+        }
+        EXPECT_EQ( inner, 3200 );
+        sc::vector<long long> sums( 8 );
+        pool.run( sums.size(), [&]( std::size_t i ){
+            sc::vector<long long> part( 100000, static_cast<long long>( i ) );
+            sums[i] = sc::par::reduce( part, 0LL, std::plus<long long>(), pool );
+        } );
+        EXPECT_EQ( sums[7], 700000 );
+
+        bool caught = false;
+        try{
+            pool.run( 100, []( std::size_t i ){ if( i == 42 ) throw std::runtime_error( "task" ); } );
+        }catch( const std::runtime_error & ){
+            caught = true;
+        }
+        EXPECT_TRUE( caught );
+        pool.run( hits.size(), [&]( std::size_t i ){ ++hits[i]; } );   // Still usable afterwards.
+        EXPECT_EQ( hits[999], 4 );
+    }
+
+    {
+        BEGIN_TEST(tm6, "ForEachTransform","for_each() and transform() visit every element exactly once");
+        sc::par::thread_pool pool( 4 );
+        sc::vector<int> vec( 1000003, 1 );
+        sc::par::for_each( vec, []( int & x ){ x += 1; }, pool );
+        EXPECT_TRUE( std::all_of( vec.begin(), vec.end(), []( int x ){ return x == 2; } ) );
+
+        sc::vector<double> out( vec.size() );
+        sc::par::transform( vec, out, []( int x ){ return x * 0.5; }, pool );
+        EXPECT_TRUE( std::all_of( out.begin(), out.end(), []( double x ){ return x == 1.0; } ) );
+        sc::par::transform( vec, vec, []( int x ){ return -x; }, pool );    // In place.
+        EXPECT_EQ( std::count( vec.begin(), vec.end(), -2 ), 1000003 );
+
+        sc::vector<double> tooShort( 10 );
+        bool caught = false;
+        try{
+            sc::par::transform( vec, tooShort, []( int x ){ return x * 1.0; }, pool );
+        }catch( const std::length_error & ){
+            caught = true;
+        }
+        EXPECT_TRUE( caught );
+    }
+
+    {
+        BEGIN_TEST(tm6, "Reduce","reduce() and transform_reduce() match the serial results");
+        sc::par::thread_pool pool( 4 );
+        sc::vector<long long> vec( 2000000 );
+        for( std::size_t i{0} ; i < vec.size() ; ++i )
+            vec[i] = i;
+        const long long n = vec.size();
+        EXPECT_EQ( sc::par::reduce( vec, 0LL, std::plus<long long>(), pool ), n * ( n - 1 ) / 2 );
+        EXPECT_EQ( sc::par::reduce( vec, 5LL ), n * ( n - 1 ) / 2 + 5 );
+        EXPECT_EQ( sc::par::reduce( vec, 0LL, []( long long a, long long b ){ return a > b ? a : b; }, pool ), n - 1 );
+        EXPECT_EQ( sc::par::transform_reduce( vec, 0LL, std::plus<long long>(), []( long long x ){ return x % 2; }, pool ), n / 2 );
+        EXPECT_EQ( sc::par::transform_reduce( vec, vec, 0LL, std::plus<long long>(), std::multiplies<long long>(), pool ),
+                   ( n - 1 ) * n / 2 * ( 2 * n - 1 ) / 3 );
+
+        // Partial results are combined in order, so a non-commutative operation still works.
+        sc::vector<int> digits( 300000, 0 );
+        digits.back() = 1;
+        auto last = []( int /*a*/, int b ){ return b; };
+        EXPECT_EQ( sc::par::reduce( digits, 7, last, pool ), 1 );
+        EXPECT_EQ( sc::par::reduce( sc::vector<int>(), 7, last, pool ), 7 );
+
+        // bool results: each chunk writes a slot of its own, not a bit of a shared word.
+        bool all_ok{ true };
+        for( auto round{0} ; round < 20 ; ++round ){
+            all_ok = all_ok && sc::par::transform_reduce( vec, true, std::logical_and<bool>(),
+                                                          []( long long x ){ return x >= 0; }, pool );
+        }
+        EXPECT_TRUE( all_ok );
+        vec[vec.size() / 2] = -1;
+        EXPECT_FALSE( sc::par::transform_reduce( vec, true, std::logical_and<bool>(), []( long long x ){ return x >= 0; }, pool ) );
+        EXPECT_TRUE( sc::par::transform_reduce( vec, false, std::logical_or<bool>(), []( long long x ){ return x < 0; }, pool ) );
+    }
+
+    {
+        BEGIN_TEST(tm6, "InclusiveScan","inclusive_scan() matches std::partial_sum, in and out of place");
+        sc::par::thread_pool pool( 4 );
+        sc::vector<long long> vec( 1500001 );
+        for( std::size_t i{0} ; i < vec.size() ; ++i )
+            vec[i] = i % 7 + 1;
+        std::vector<long long> expected( vec.size() );
+        std::partial_sum( vec.begin(), vec.end(), expected.begin() );
+
+        sc::vector<long long> out( vec.size() );
+        sc::par::inclusive_scan( vec, out, std::plus<long long>(), pool );
+        EXPECT_TRUE( std::equal( out.begin(), out.end(), expected.begin() ) );
+        sc::par::inclusive_scan( vec, vec );
+        EXPECT_TRUE( std::equal( vec.begin(), vec.end(), expected.begin() ) );
+
+        sc::vector<int> small{ 3, 1, 2 };
+        sc::par::inclusive_scan( small, small, []( int a, int b ){ return a * b; }, pool );
+        EXPECT_EQ( small, ( sc::vector<int>{ 3, 3, 6 } ) );
+    }
+
+    {
+        BEGIN_TEST(tm6, "Sort","sort() and stable_sort() match std::sort and std::stable_sort, with odd and even merge rounds");
+        sc::par::thread_pool pool( 4 );
+        for( std::size_t n : { std::size_t( 200003 ), std::size_t( 80000 ), std::size_t( 1000 ) } ){
+            sc::vector<std::uint64_t> vec( n );
+            std::uint64_t x{88172645463325252ULL};
+            for( auto & v : vec ){
+                x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+                v = x;
+            }
+            std::vector<std::uint64_t> expected( vec.begin(), vec.end() );
+            std::sort( expected.begin(), expected.end() );
+            sc::par::sort( vec, std::less<std::uint64_t>(), pool );
+            EXPECT_TRUE( std::equal( vec.begin(), vec.end(), expected.begin() ) );
+            sc::par::sort( vec, std::greater<std::uint64_t>(), pool );
+            EXPECT_TRUE( std::equal( vec.begin(), vec.end(), expected.rbegin() ) );
+        }
+
+        // Few distinct keys: every run holds many equivalent elements.
+        sc::vector<std::pair<int, int>> pairs;
+        for( int i{0} ; i < 150000 ; ++i ){
+            pairs.push_back( std::make_pair( ( i * 7919 ) % 13, i ) );
+        }
+        auto by_key = []( const std::pair<int, int> & a, const std::pair<int, int> & b ){ return a.first < b.first; };
+        std::vector<std::pair<int, int>> expected( pairs.begin(), pairs.end() );
+        std::stable_sort( expected.begin(), expected.end(), by_key );
+        sc::par::stable_sort( pairs, by_key, pool );
+        EXPECT_TRUE( std::equal( pairs.begin(), pairs.end(), expected.begin() ) );
+    }
+
+    {
+        BEGIN_TEST(tm6, "SortMoveOnly","sort() and stable_sort() take move-only types with no default constructor");
+        sc::par::thread_pool pool( 4 );
+        for( std::size_t n : { std::size_t( 200003 ), std::size_t( 80000 ) } ){
+            {
+                std::vector<Ticket> source;
+                source.reserve( n );
+                for( std::size_t i{0} ; i < n ; ++i ){
+                    source.push_back( Ticket( static_cast<int>( ( i * 7919 ) % n ) ) );
+                }
+                // sc::vector's size constructor would need a default constructor; the range one does not.
+                sc::vector<Ticket> vec( std::make_move_iterator( source.begin() ), std::make_move_iterator( source.end() ) );
+                source.clear();
+                auto by_value = []( const Ticket & a, const Ticket & b ){ return a.value < b.value; };
+                sc::par::sort( vec, by_value, pool );
+                EXPECT_TRUE( std::is_sorted( vec.begin(), vec.end(), by_value ) );
+                auto by_parity = []( const Ticket & a, const Ticket & b ){ return a.value % 2 < b.value % 2; };
+                sc::par::stable_sort( vec, by_parity, pool );
+                EXPECT_TRUE( std::is_sorted( vec.begin(), vec.begin() + ( n + 1 ) / 2, by_value ) );
+                EXPECT_EQ( static_cast<std::size_t>( Ticket::alive.load() ), n );  // The scratch copies are gone.
+            }
+            EXPECT_EQ( Ticket::alive.load(), 0 );
+        }
+    }
+
+    {
+        BEGIN_TEST(tm6, "FirstTouch","the first_touch constructors and assign() overloads build the same contents as the serial ones");
+        sc::par::thread_pool pool( 4 );
+        sc::par::first_touch policy( pool );
+        sc::vector<double> zeros( 300001, policy );
+        EXPECT_EQ( zeros.size(), 300001u );
+        EXPECT_TRUE( std::all_of( zeros.begin(), zeros.end(), []( double x ){ return x == 0.0; } ) );
+
+        sc::vector<double> vec( 10, 7.0 );
+        vec.assign( 300001, 2.5, policy );             // Grows.
+        EXPECT_EQ( std::count( vec.begin(), vec.end(), 2.5 ), 300001 );
+        vec.assign( 1000, vec[3], policy );            // Shrinks, from one of its own elements.
+        EXPECT_EQ( std::count( vec.begin(), vec.end(), 2.5 ), 1000 );
+
+        std::iota( zeros.begin(), zeros.end(), 0.0 );
+        sc::vector<double> copy( zeros, policy );
+        EXPECT_TRUE( copy == zeros );
+        vec.assign( zeros, policy );
+        EXPECT_TRUE( vec == zeros );
+
+        // Nothrow but not trivially copyable: live slots are assigned, raw ones constructed.
+        auto one = std::make_shared<int>( 1 );
+        auto two = std::make_shared<int>( 2 );
+        sc::vector<std::shared_ptr<int>> ptrs( 200000, policy );
+        EXPECT_TRUE( std::all_of( ptrs.begin(), ptrs.end(), []( const std::shared_ptr<int> & p ){ return !p; } ) );
+        ptrs.assign( 100000, one, policy );
+        ptrs.assign( 250000, two, policy );
+        EXPECT_EQ( one.use_count(), 1 );
+        EXPECT_EQ( two.use_count(), 250001 );
+        sc::vector<std::shared_ptr<int>> ptrCopy( ptrs, policy );
+        EXPECT_EQ( two.use_count(), 500001 );
+        ptrCopy.assign( sc::vector<std::shared_ptr<int>>( 70000, one ), policy );
+        EXPECT_EQ( ptrCopy.size(), 70000u );
+        EXPECT_EQ( one.use_count(), 70001 );
+        EXPECT_EQ( two.use_count(), 250001 );
+
+        // A copy that may throw takes the serial path.
+        sc::vector<std::string> words( 5000, std::string( "first touch" ) );
+        sc::vector<std::string> wordCopy( words, policy );
+        EXPECT_TRUE( wordCopy == words );
+        wordCopy.assign( 3, std::string( "x" ), policy );
+        EXPECT_EQ( wordCopy.size(), 3u );
+        EXPECT_EQ( wordCopy[2], std::string( "x" ) );
+    }
+
+    tm6.summary();
+    std::cout << "\n\n";
+
+
+    // Seventh batch of tests, focused on the sorted flat containers.
+
+    TestManager tm7{ "Flat container testing"};
+
+    {
+        BEGIN_TEST(tm7, "FlatSet","flat_set keeps its keys sorted and unique in one sc::vector");
+        sc::flat_set<int> set{ 5, 1, 4, 1, 3 };
+        EXPECT_EQ( set.size(), 4u );
+        EXPECT_TRUE( std::is_sorted( set.begin(), set.end() ) );
+        EXPECT_EQ( set.sequence(), ( sc::vector<int>{ 1, 3, 4, 5 } ) );
+        EXPECT_EQ( set.data(), &*set.begin() );
+
+        EXPECT_TRUE( set.insert( 2 ).second );
+        EXPECT_FALSE( set.insert( 4 ).second );
+        EXPECT_EQ( *set.insert( 4 ).first, 4 );
+        EXPECT_TRUE( set.contains( 2 ) );
+        EXPECT_FALSE( set.contains( 6 ) );
+        EXPECT_TRUE( set.find( 6 ) == set.end() );
+        EXPECT_EQ( *set.lower_bound( 0 ), 1 );
+        EXPECT_TRUE( set.upper_bound( 5 ) == set.end() );
+        EXPECT_EQ( set.equal_range( 3 ).second - set.equal_range( 3 ).first, 1 );
+
+        EXPECT_EQ( set.erase( 3 ), 1u );
+        EXPECT_EQ( set.erase( 3 ), 0u );
+        set.erase( set.begin() );
+        EXPECT_EQ( set.sequence(), ( sc::vector<int>{ 2, 4, 5 } ) );
+
+        sc::flat_set<int, std::greater<int>> desc{ 1, 2, 3 };
+        EXPECT_EQ( *desc.begin(), 3 );
+
+        sc::vector<int> keys = set.extract();
+        EXPECT_TRUE( set.empty() );
+        sc::flat_set<int> adopted( sc::sorted_unique, std::move( keys ) );
+        EXPECT_EQ( adopted.size(), 3u );
+    }
+
+    {
+        BEGIN_TEST(tm7, "FlatMap","flat_map lookup, operator[], try_emplace and insert_or_assign");
+        sc::flat_map<std::string, int> map{ { "b", 2 }, { "a", 1 }, { "c", 3 }, { "a", 100 } };
+        EXPECT_EQ( map.size(), 3u );
+        EXPECT_EQ( map.at( "a" ), 1 );              // The first of the duplicates wins.
+        EXPECT_EQ( map.begin()->first, "a" );
+        EXPECT_EQ( map["c"], 3 );
+        map["d"] = 4;
+        EXPECT_EQ( map.size(), 4u );
+        EXPECT_EQ( map.rbegin()->second, 4 );
+
+        EXPECT_FALSE( map.try_emplace( "b", 20 ).second );
+        EXPECT_EQ( map.at( "b" ), 2 );
+        EXPECT_FALSE( map.insert_or_assign( "b", 20 ).second );
+        EXPECT_EQ( map.at( "b" ), 20 );
+        EXPECT_TRUE( map.emplace( "e", 5 ).second );
+
+        bool caught = false;
+        try{
+            map.at( "z" );
+        }catch( const std::out_of_range & ){
+            caught = true;
+        }
+        EXPECT_TRUE( caught );
+        EXPECT_EQ( map.count( "e" ), 1u );
+        EXPECT_EQ( map.erase( "e" ), 1u );
+        EXPECT_FALSE( map.contains( "e" ) );
+        EXPECT_TRUE( std::is_sorted( map.begin(), map.end(), map.value_comp() ) );
+    }
+
+    {
+        BEGIN_TEST(tm7, "BulkInsert","range inserts append, sort and merge, keeping the first of equivalent keys");
+        sc::flat_map<int, int> map;
+        for( int i{0} ; i < 100 ; i += 2 )
+            map[i] = i;
+        std::vector< std::pair<int, int> > batch;
+        for( int i{99} ; i >= 0 ; --i )
+            batch.push_back( { i, -i } );             // Half of the keys are new, all in reverse order.
+        batch.push_back( { 1, 1000 } );               // Duplicate of a new key: the earlier one wins.
+        map.insert( batch.begin(), batch.end() );
+        EXPECT_EQ( map.size(), 100u );
+        EXPECT_TRUE( std::is_sorted( map.begin(), map.end(), map.value_comp() ) );
+        EXPECT_EQ( map.at( 10 ), 10 );                // Existing keys keep their values.
+        EXPECT_EQ( map.at( 11 ), -11 );
+        EXPECT_EQ( map.at( 1 ), -1 );
+
+        sc::flat_set<int> set{ 10, 20 };
+        std::istringstream in( "30 5 20 15 5" );      // Single-pass input iterators.
+        set.insert( std::istream_iterator<int>( in ), std::istream_iterator<int>() );
+        EXPECT_EQ( set.sequence(), ( sc::vector<int>{ 5, 10, 15, 20, 30 } ) );
+    }
+
+    tm7.summary();
+    std::cout << "\n\n";
+
+
+    // Eighth batch of tests, focused on the bit-packed vector<bool>.
+
+    TestManager tm8{ "Bit vector testing"};
+
+    {
+        BEGIN_TEST(tm8, "BitPacked","vector<bool> packs 64 bits to a word and behaves as a sequence of bool");
+        sc::vector<bool> vec( 130 );
+        EXPECT_EQ( vec.size(), 130u );
+        EXPECT_EQ( vec.word_count(), 3u );
+        EXPECT_EQ( vec.count(), 0u );
+        vec[0] = true;
+        vec[129] = vec[0];
+        EXPECT_TRUE( vec[129] );
+        EXPECT_TRUE( vec.at( 0 ) );
+        EXPECT_FALSE( vec.at( 1 ) );
+        vec.at( 1 ).flip();
+        EXPECT_TRUE( vec[1] );
+        swap( vec[1], vec[2] );
+        EXPECT_FALSE( vec[1] );
+        EXPECT_TRUE( vec[2] );
+
+        bool caught = false;
+        try{
+            vec.at( 130 );
+        }catch( const std::out_of_range & ){
+            caught = true;
+        }
+        EXPECT_TRUE( caught );
+
+        // Random access iterators and the standard algorithms.
+        EXPECT_EQ( vec.end() - vec.begin(), 130 );
+        EXPECT_EQ( std::count( vec.cbegin(), vec.cend(), true ), 3 );
+        EXPECT_EQ( std::find( vec.begin() + 3, vec.end(), true ) - vec.begin(), 129 );
+        EXPECT_TRUE( *vec.rbegin() );
+        EXPECT_TRUE( vec.begin()[129] );
+        sc::vector<bool>::const_iterator cit = vec.begin() + 70;
+        EXPECT_TRUE( cit - 70 == vec.cbegin() );
+
+        // Modifiers, checked against std::vector<bool>.
+        std::vector<bool> ref( vec.begin(), vec.end() );
+        for( int k{0} ; k < 200 ; ++k ){
+            std::size_t i = ( k * 37 ) % ( ref.size() + 1 );
+            vec.insert( vec.begin() + i, k % 3 == 0 );
+            ref.insert( ref.begin() + i, k % 3 == 0 );
+            if( k % 2 == 0 ){
+                std::size_t j = ( k * 53 ) % ref.size();
+                vec.erase( vec.begin() + j );
+                ref.erase( ref.begin() + j );
+            }
+        }
+        vec.push_back( true );
+        ref.push_back( true );
+        vec.pop_back();
+        ref.pop_back();
+        EXPECT_EQ( vec.size(), ref.size() );
+        EXPECT_TRUE( std::equal( vec.begin(), vec.end(), ref.begin() ) );
+        EXPECT_EQ( vec.count(), std::size_t( std::count( ref.begin(), ref.end(), true ) ) );
+
+        sc::vector<bool> ones( 100, true );
+        EXPECT_EQ( ones.count(), 100u );
+        EXPECT_TRUE( ones.all() );
+        ones.assign( 3, false );
+        EXPECT_EQ( ones, ( sc::vector<bool>{ false, false, false } ) );
+        EXPECT_TRUE( ( sc::vector<bool>{ true, false, true } < sc::vector<bool>{ true, true } ) );
+        EXPECT_TRUE( ( sc::vector<bool>{ true } < sc::vector<bool>{ true, false } ) );
+        EXPECT_FALSE( ( sc::vector<bool>{ true, true } < sc::vector<bool>{ true, false, true } ) );
+    }
+
+    {
+        BEGIN_TEST(tm8, "BitRangeModifiers","range insert/erase, emplace, push_front/pop_front and erase_if keep the sc::vector interface");
+        sc::vector<bool> vec;
+        std::vector<bool> ref;
+        bool ok{ true };
+        for( int k{0} ; k < 300 ; ++k ){
+            // Counts on both sides of a word boundary, at every bit offset.
+            std::size_t count = ( k * 29 ) % 150;
+            std::vector<bool> bits;
+            for( std::size_t b{0} ; b < count ; ++b )
+                bits.push_back( ( b * 7 + k ) % 3 == 0 );
+            std::size_t i = ( k * 41 ) % ( ref.size() + 1 );
+            vec.insert( vec.cbegin() + i, bits.begin(), bits.end() );
+            ref.insert( ref.begin() + i, bits.begin(), bits.end() );
+            if( k % 2 == 1 && !ref.empty() ){
+                std::size_t first = ( k * 13 ) % ref.size();
+                std::size_t last = first + ( k * 31 ) % ( ref.size() - first + 1 );
+                vec.erase( vec.begin() + first, vec.begin() + last );
+                ref.erase( ref.begin() + first, ref.begin() + last );
+            }
+            ok = ok && vec.size() == ref.size() && std::equal( vec.begin(), vec.end(), ref.begin() );
+        }
+        EXPECT_TRUE( ok );
+        // The bits past size() stay clear.
+        EXPECT_EQ( vec.count(), std::size_t( std::count( ref.begin(), ref.end(), true ) ) );
+
+        vec.push_front( true );
+        ref.insert( ref.begin(), true );
+        vec.emplace_front( 0 );
+        ref.insert( ref.begin(), false );
+        vec.emplace_back( 1 );
+        ref.push_back( true );
+        vec.emplace( vec.cbegin() + 5, true );
+        ref.insert( ref.begin() + 5, true );
+        vec.insert( vec.cbegin() + 3, { true, true, false } );
+        ref.insert( ref.begin() + 3, { true, true, false } );
+        std::istringstream in{ "1 0 1 1" };
+        vec.insert( vec.cbegin() + 70, std::istream_iterator<int>{ in }, std::istream_iterator<int>{} );
+        ref.insert( ref.begin() + 70, { true, false, true, true } );
+        vec.pop_front();
+        ref.erase( ref.begin() );
+        EXPECT_EQ( vec.size(), ref.size() );
+        EXPECT_TRUE( std::equal( vec.begin(), vec.end(), ref.begin() ) );
+
+        std::size_t ones = std::size_t( std::count( ref.begin(), ref.end(), true ) );
+        EXPECT_EQ( vec.erase_if( []( bool b ){ return !b; } ), ref.size() - ones );
+        EXPECT_EQ( vec.size(), ones );
+        EXPECT_TRUE( vec.all() );
+        EXPECT_EQ( vec.retain( []( bool b ){ return !b; } ), ones );
+        EXPECT_TRUE( vec.empty() );
+
+        // Generic code over sc::vector<T> works for bool too.
+        sc::flat_set<bool> flags{ true, false, true };
+        EXPECT_EQ( flags.size(), 2u );
+        EXPECT_TRUE( flags.contains( false ) );
+        flags.erase( false );
+        EXPECT_EQ( flags.size(), 1u );
+    }
+
+    {
+        BEGIN_TEST(tm8, "BitmapOperations","count, find_first/find_next, range set/reset and bitwise operators work on whole words");
+        sc::vector<bool> vec( 1000 );
+        EXPECT_EQ( vec.find_first(), sc::vector<bool>::npos );
+        EXPECT_TRUE( vec.none() );
+        vec.set( 5, 900 );
+        EXPECT_EQ( vec.count(), 895u );
+        vec.reset( 64, 128 );
+        EXPECT_EQ( vec.count(), 831u );
+        EXPECT_EQ( vec.find_first(), 5u );
+        EXPECT_EQ( vec.find_next( 63 ), 128u );
+        EXPECT_EQ( vec.find_next( 899 ), sc::vector<bool>::npos );
+        vec.set( 10, 12, false );
+        EXPECT_EQ( vec.find_next( 9 ), 12u );
+
+        std::size_t visited{0};
+        for( std::size_t i = vec.find_first() ; i != sc::vector<bool>::npos ; i = vec.find_next( i ) )
+            ++visited;
+        EXPECT_EQ( visited, vec.count() );
+
+        sc::vector<bool> evens( 1000 );
+        for( std::size_t i{0} ; i < evens.size() ; i += 2 )
+            evens[i] = true;
+        sc::vector<bool> both = vec & evens;
+        sc::vector<bool> either = vec | evens;
+        sc::vector<bool> one = vec ^ evens;
+        EXPECT_EQ( both.count() + either.count(), vec.count() + evens.count() );
+        EXPECT_EQ( one.count(), either.count() - both.count() );
+        EXPECT_EQ( ( ~vec ).count(), 1000 - vec.count() );      // The tail past size() stays clear.
+        vec.flip();
+        EXPECT_TRUE( vec[999] );
+        vec.flip( 999 );
+        EXPECT_FALSE( vec[999] );
+        vec.reset();
+        EXPECT_TRUE( vec.none() );
+
+        bool caught = false;
+        try{
+            vec &= sc::vector<bool>( 10 );
+        }catch( const std::length_error & ){
+            caught = true;
+        }
+        EXPECT_TRUE( caught );
+    }
+
+    tm8.summary();
+    std::cout << "\n\n";
+
+
+    // Ninth batch of tests, focused on the structure-of-arrays container.
+
+    TestManager tm9{ "Structure of arrays testing"};
+
+    {
+        BEGIN_TEST(tm9, "Columns","soa_vector keeps one aligned column per field, all in one block");
+        sc::soa_vector<float, double, std::string> soa;
+        EXPECT_TRUE( soa.empty() );
+        EXPECT_EQ( soa.columns(), 3u );
+        for( int i{0} ; i < 100 ; ++i )
+            soa.push_back( float( i ), i * 2.0, std::to_string( i ) );
+        soa.emplace_back( soa.get<0>( 5 ), soa.get<1>( 5 ), soa.get<2>( 5 ) );   // Fields of the vector itself, while it grows.
+        EXPECT_EQ( soa.size(), 101u );
+        EXPECT_GE( soa.capacity(), 101u );
+        EXPECT_EQ( soa.get<2>( 100 ), "5" );
+
+        // Every column is 64-byte aligned and they follow each other within a single block.
+        const char * c0 = reinterpret_cast<const char *>( soa.data<0>() );
+        const char * c1 = reinterpret_cast<const char *>( soa.data<1>() );
+        const char * c2 = reinterpret_cast<const char *>( soa.data<2>() );
+        EXPECT_EQ( reinterpret_cast<std::uintptr_t>( c1 ) % 64, 0u );
+        EXPECT_EQ( reinterpret_cast<std::uintptr_t>( c2 ) % 64, 0u );
+        EXPECT_TRUE( c0 < c1 && c1 < c2 );
+        EXPECT_LT( std::size_t( c2 - c0 ), soa.capacity() * ( sizeof( float ) + sizeof( double ) ) + 128 );
+
+        double sum{0};
+        for( double x : soa.column<1>() )
+            sum += x;
+        EXPECT_EQ( sum, 9900.0 + 10.0 );
+
+        // Rows are tuples of references.
+        std::get<0>( soa[0] ) = 42.0f;
+        EXPECT_EQ( soa.get<0>( 0 ), 42.0f );
+        std::size_t rows{0};
+        for( auto row : soa ){
+            if( std::get<2>( row ) == "5" )
+                ++rows;
+        }
+        EXPECT_EQ( rows, 2u );
+        sc::soa_vector<float, double, std::string>::const_iterator it = soa.begin();
+        EXPECT_EQ( soa.end() - it, 101 );
+        EXPECT_EQ( std::get<1>( it[3] ), 6.0 );
+
+        sc::soa_vector<float, double, std::string> copy{ soa };
+        copy.pop_back();
+        EXPECT_EQ( copy.size(), 100u );
+        EXPECT_EQ( std::get<2>( copy.at( 99 ) ), "99" );
+        copy.shrink_to_fit();
+        EXPECT_EQ( copy.capacity(), 100u );
+        soa = std::move( copy );
+        EXPECT_EQ( soa.size(), 100u );
+        EXPECT_TRUE( copy.empty() );
+
+        bool caught = false;
+        try{
+            soa.at( 100 );
+        }catch( const std::out_of_range & ){
+            caught = true;
+        }
+        EXPECT_TRUE( caught );
+    }
+
+    {
+        BEGIN_TEST(tm9, "ColumnLifetime","growing moves each column once, relocatable columns are memcpy'd");
+        Tracked::reset();
+        {
+            sc::soa_vector<Tracked, Relocatable, int> soa;
+            soa.emplace_back( 1, 2, 3 );
+            soa.emplace_back( 4, 5, 6 );
+            Tracked::reset();
+            soa.emplace_back( 7, 8, 9 );                // Grows from 2 to 4 rows.
+            EXPECT_EQ( Tracked::alive, 6 );
+            EXPECT_EQ( Tracked::moves, 2 );             // The Tracked column moved; the Relocatable one was memcpy'd.
+            EXPECT_EQ( Tracked::copies, 0 );
+            soa.clear();
+            EXPECT_EQ( Tracked::alive, 0 );
+            EXPECT_EQ( soa.capacity(), 4u );
+            sc::soa_vector<Tracked, Relocatable, int> many( 5 );
+            EXPECT_EQ( Tracked::alive, 10 );
+        }
+        EXPECT_EQ( Tracked::alive, 0 );
+
+        // A column whose copy throws next to a nothrow-movable one: the strings are copied, not
+        // moved out of the old block, so a throw while growing leaves every row as it was.
+        {
+            sc::soa_vector<std::string, Fragile> soa;
+            for( int i{0} ; i < 4 ; ++i )
+                soa.emplace_back( std::string( 40, char( 'a' + i ) ), i );
+            Fragile::fuse = 4;
+            bool caught{ false };
+            try{
+                soa.emplace_back( std::string( 40, 'e' ), 4 );   // Grows from 4 to 8 rows.
+            }catch( const std::runtime_error & ){
+                caught = true;
+            }
+            Fragile::fuse = 0;
+            EXPECT_TRUE( caught );
+            EXPECT_EQ( soa.size(), 4u );
+            bool ok{ true };
+            for( int i{0} ; i < 4 ; ++i )
+                ok = ok && soa.column<0>()[i] == std::string( 40, char( 'a' + i ) ) && soa.column<1>()[i].value == i;
+            EXPECT_TRUE( ok );
+            EXPECT_EQ( Fragile::alive, 4 );
+        }
+        EXPECT_EQ( Fragile::alive, 0 );
+    }
+
+    tm9.summary();
+    std::cout << "\n\n";
+
+    TestManager tm10{ "Stable vector testing"};
+
+    {
+        BEGIN_TEST(tm10, "StableAddresses","growing allocates a new segment and never moves an element");
+        sc::stable_vector<int, std::allocator<int>, 4> sv;
+        std::vector<const int *> addresses;
+        for( int i{0} ; i < 1000 ; ++i ){
+            sv.push_back( i );
+            addresses.push_back( &sv.back() );
+        }
+        EXPECT_EQ( sv.size(), 1000u );
+        EXPECT_EQ( sv.segment_count(), 8u );            // 4 + 8 + ... + 512 = 1020 slots.
+        EXPECT_EQ( sv.capacity(), 1020u );
+        bool same{true};
+        for( int i{0} ; i < 1000 ; ++i ){
+            same = same && &sv[i] == addresses[i] && sv[i] == i;
+        }
+        EXPECT_TRUE( same );
+        EXPECT_EQ( std::distance( sv.begin(), sv.end() ), 1000 );
+        EXPECT_EQ( std::accumulate( sv.begin(), sv.end(), 0 ), 999 * 1000 / 2 );
+        auto it = sv.begin() + 500;
+        EXPECT_EQ( *it, 500 );
+        EXPECT_EQ( *( it - 497 ), 3 );
+        EXPECT_EQ( it[11], 511 );
+        sc::stable_vector<int, std::allocator<int>, 4>::const_iterator cit = it;
+        EXPECT_TRUE( cit == it );
+        std::size_t counted{0};
+        for( std::size_t k{0} ; k < sv.segment_count() ; ++k ){
+            counted += sv.segment_size( k );
+        }
+        EXPECT_EQ( counted, 1000u );
+        EXPECT_EQ( sv.segment_size( 7 ), 492u );
+        bool caught{false};
+        try{
+            sv.at( 1000 );
+        }catch( const std::out_of_range & ){
+            caught = true;
+        }
+        EXPECT_TRUE( caught );
+        while( sv.size() > 10 ){
+            sv.pop_back();
+        }
+        sv.shrink_to_fit();
+        EXPECT_EQ( sv.capacity(), 12u );
+        EXPECT_EQ( &sv[9], addresses[9] );
+    }
+
+    {
+        BEGIN_TEST(tm10, "StableLifetime","no element is copied or moved by growth; copies and moves of the container");
+        Tracked::reset();
+        {
+            sc::stable_vector<Tracked> sv;
+            for( int i{0} ; i < 100 ; ++i ){
+                sv.emplace_back( i );
+            }
+            EXPECT_EQ( Tracked::alive, 100 );
+            EXPECT_EQ( Tracked::moves, 0 );
+            EXPECT_EQ( Tracked::copies, 0 );
+            sc::stable_vector<Tracked> copy{ sv };
+            EXPECT_EQ( Tracked::copies, 100 );
+            EXPECT_EQ( copy[42].value, 42 );
+            EXPECT_NE( &copy[42], &sv[42] );
+            sc::stable_vector<Tracked> moved{ std::move( copy ) };
+            EXPECT_EQ( Tracked::alive, 200 );
+            EXPECT_EQ( Tracked::moves, 0 );
+            EXPECT_TRUE( copy.empty() );
+            EXPECT_EQ( moved.back().value, 99 );
+            moved.clear();
+            EXPECT_EQ( Tracked::alive, 100 );
+            copy = sv;
+            EXPECT_EQ( Tracked::alive, 200 );
+        }
+        EXPECT_EQ( Tracked::alive, 0 );
+    }
+
+    tm10.summary();
+    std::cout << "\n\n";
+
+    TestManager tm11{ "Memory mapped vector testing"};
+
+    {
+        BEGIN_TEST(tm11, "MappedFile","the elements outlive the vector in its file, which close() trims to size");
+        std::string path = "/tmp/sc_mmap_vector_" + std::to_string( ::getpid() ) + ".bin";
+        std::remove( path.c_str() );
+        {
+            sc::mmap_vector<long long> mv{ path };
+            EXPECT_TRUE( mv.is_open() );
+            EXPECT_TRUE( mv.empty() );
+            for( long long i{0} ; i < 10000 ; ++i ){
+                mv.push_back( i * i );
+            }
+            mv.push_back( mv[3] );                      // Grows while copying one of its own elements.
+            EXPECT_EQ( mv.size(), 10001u );
+            EXPECT_GE( mv.capacity(), 10001u );
+            EXPECT_EQ( mv.back(), 9 );
+            mv.pop_back();
+            mv.advise( sc::mmap_vector<long long>::access::sequential );
+            mv.flush();
+        }
+        {
+            sc::mmap_vector<long long> mv{ path };
+            EXPECT_EQ( mv.size(), 10000u );              // The capacity-sized tail was cut off.
+            EXPECT_EQ( mv.capacity(), 10000u );
+            EXPECT_EQ( std::accumulate( mv.begin(), mv.end(), 0LL ), 9999LL * 10000 * 19999 / 6 );
+            mv.resize( 5 );
+            mv.resize( 8, -1 );
+            EXPECT_EQ( mv[4], 16 );
+            EXPECT_EQ( mv[7], -1 );
+        }
+        {
+            auto ro = sc::mmap_vector<long long>::open_readonly( path );
+            EXPECT_TRUE( ro.read_only() );
+            EXPECT_EQ( ro.size(), 8u );
+            EXPECT_EQ( ro.at( 6 ), -1 );
+            ro.advise( sc::mmap_vector<long long>::access::random );
+            bool caught{false};
+            try{
+                ro.push_back( 1 );
+            }catch( const std::logic_error & ){
+                caught = true;
+            }
+            EXPECT_TRUE( caught );
+        }
+        {
+            sc::mmap_vector<long long> mv{ path };
+            mv.clear();
+            mv.shrink_to_fit();
+            EXPECT_EQ( mv.capacity(), 0u );
+            long long values[] = { 4, 5, 6 };
+            mv.assign( values, 3 );
+            EXPECT_EQ( mv.size(), 3u );
+            EXPECT_EQ( mv.front(), 4 );
+        }
+        EXPECT_EQ( sc::mmap_vector<long long>::open_readonly( path ).size(), 3u );
+        std::remove( path.c_str() );
+        bool caught{false};
+        try{
+            sc::mmap_vector<long long>::open_readonly( path );
+        }catch( const std::system_error & ){
+            caught = true;
+        }
+        EXPECT_TRUE( caught );
+    }
+
+    {
+        BEGIN_TEST(tm11, "FlushedFile","a file flushed but never closed reads back with size() elements");
+        std::string path = "/tmp/sc_mmap_flush_" + std::to_string( ::getpid() ) + ".bin";
+        std::remove( path.c_str() );
+        sc::mmap_vector<long long> mv{ path };
+        for( long long i{0} ; i < 1000 ; ++i ){
+            mv.push_back( i );
+        }
+        EXPECT_GT( mv.capacity(), 1000u );
+        mv.flush();
+        EXPECT_EQ( mv.capacity(), 1000u );
+        {
+            // Reopened while 'mv' still holds the file, as after a crash.
+            auto ro = sc::mmap_vector<long long>::open_readonly( path );
+            EXPECT_EQ( ro.size(), 1000u );
+            EXPECT_EQ( ro.back(), 999 );
+        }
+        mv.push_back( 1000 );                           // Grows the trimmed file again.
+        mv.pop_back();
+        mv.pop_back();
+        mv.flush();
+        EXPECT_EQ( sc::mmap_vector<long long>::open_readonly( path ).size(), 999u );
+        mv.clear();
+        mv.flush();
+        EXPECT_EQ( mv.capacity(), 0u );
+        EXPECT_TRUE( sc::mmap_vector<long long>::open_readonly( path ).empty() );
+        mv.close();
+        std::remove( path.c_str() );
+    }
+
+    tm11.summary();
+    std::cout << "\n\n";
+
+    TestManager tm12{ "Snapshot testing"};
+
+    {
+        BEGIN_TEST(tm12, "SaveAndLoad","a snapshot maps back in place and reads back into a vector");
+        std::string path = "/tmp/sc_snapshot_" + std::to_string( ::getpid() ) + ".bin";
+        sc::vector<double> v;
+        for( int i{0} ; i < 1001 ; ++i ){
+            v.push_back( i * 0.5 );
+        }
+        sc::save( v, path );
+        {
+            sc::snapshot_view<double> view = sc::load_view<double>( path, true );
+            EXPECT_EQ( view.size(), 1001u );
+            EXPECT_EQ( reinterpret_cast<std::uintptr_t>( view.data() ) % sc::snapshot_alignment, 0u );
+            EXPECT_TRUE( std::equal( view.begin(), view.end(), v.begin() ) );
+            EXPECT_EQ( view.back(), 500.0 );
+            EXPECT_TRUE( view.verify() );
+        }
+        sc::vector<double> copy = sc::load<double>( path );
+        EXPECT_TRUE( copy == v );
+
+        sc::save( sc::vector<double>{}, path );
+        EXPECT_TRUE( sc::load_view<double>( path ).empty() );
+        EXPECT_TRUE( sc::load<double>( path ).empty() );
+        std::remove( path.c_str() );
+    }
+
+    {
+        BEGIN_TEST(tm12, "SnapshotChecks","wrong element types, truncation and corruption are refused");
+        std::string path = "/tmp/sc_snapshot_checks_" + std::to_string( ::getpid() ) + ".bin";
+        sc::vector<int> v{ 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+        sc::save( v, path );
+        bool caught{false};
+        try{
+            sc::load_view<long long>( path );
+        }catch( const std::runtime_error & ){
+            caught = true;
+        }
+        EXPECT_TRUE( caught );
+
+        {
+            std::FILE * f = std::fopen( path.c_str(), "r+b" );
+            std::fseek( f, -4, SEEK_END );
+            std::fputc( 0x7f, f );
+            std::fclose( f );
+        }
+        EXPECT_EQ( sc::load_view<int>( path ).size(), 9u );     // The header alone is still fine...
+        EXPECT_FALSE( sc::load_view<int>( path ).verify() );    // ...but the elements are not.
+        caught = false;
+        try{
+            sc::load<int>( path );
+        }catch( const std::runtime_error & ){
+            caught = true;
+        }
+        EXPECT_TRUE( caught );
+
+        EXPECT_EQ( ::truncate( path.c_str(), 64 ), 0 );
+        caught = false;
+        try{
+            sc::load_view<int>( path );
+        }catch( const std::runtime_error & ){
+            caught = true;
+        }
+        EXPECT_TRUE( caught );
+        std::remove( path.c_str() );
+    }
+
+    {
+        BEGIN_TEST(tm12, "ConcurrentSave","saves racing on one path each leave a whole snapshot behind");
+        std::string path = "/tmp/sc_snapshot_race_" + std::to_string( ::getpid() ) + ".bin";
+        // A fixed temporary name would collide with this.
+        EXPECT_EQ( ::mkdir( ( path + ".tmp" ).c_str(), 0755 ), 0 );
+        std::atomic<int> failures{0};
+        std::vector<std::thread> savers;
+        for( int t{0} ; t < 4 ; ++t ){
+            savers.push_back( std::thread( [&path, &failures, t](){
+                sc::vector<int> mine( 4096 );
+                for( int round{0} ; round < 20 ; ++round ){
+                    std::fill( mine.begin(), mine.end(), t * 100 + round );
+                    try{
+                        sc::save( mine, path );
+                    }catch( const std::exception & ){
+                        ++failures;
+                    }
+                }
+            } ) );
+        }
+        for( auto & saver : savers ){
+            saver.join();
+        }
+        EXPECT_EQ( failures.load(), 0 );
+        sc::snapshot_view<int> view = sc::load_view<int>( path, true );
+        EXPECT_EQ( view.size(), 4096u );
+        EXPECT_TRUE( std::all_of( view.begin(), view.end(), [&view]( int x ){ return x == view.front(); } ) );
+        ::rmdir( ( path + ".tmp" ).c_str() );
+        std::remove( path.c_str() );
+    }
+
+    tm12.summary();
+    std::cout << "\n\n";
+
+    TestManager tm13{ "Concurrent vector testing"};
+
+    {
+        BEGIN_TEST(tm13, "ConcurrentAppend","threads appending at once publish every element exactly once");
+        sc::concurrent_vector<long long, 16> cv;
+        const int threads{8};
+        const int per_thread{5000};
+        std::atomic<bool> reader_ok{true};
+        std::atomic<bool> done{false};
+        std::thread reader( [&](){
+            // Slots start zeroed, so a published element read before it was built would be 0.
+            while( !done.load() ){
+                std::size_t n = cv.size();
+                for( std::size_t i{0} ; i < n ; i += 97 ){
+                    if( cv[i] == 0 ){
+                        reader_ok = false;
+                    }
+                }
+            }
+        } );
+        std::vector<std::thread> writers;
+        for( int t{0} ; t < threads ; ++t ){
+            writers.emplace_back( [&cv, t, per_thread](){
+                for( int i{0} ; i < per_thread ; i += 10 ){
+                    cv.grow_by( 5, -1 );
+                    for( int j{0} ; j < 5 ; ++j ){
+                        cv.push_back( (long long)t * per_thread + i + j + 1 );
+                    }
+                }
+            } );
+        }
+        for( auto & w : writers ){
+            w.join();
+        }
+        done = true;
+        reader.join();
+        EXPECT_TRUE( reader_ok.load() );
+        EXPECT_EQ( cv.size(), std::size_t( threads * per_thread ) );
+        std::vector<int> seen( threads * per_thread + 1, 0 );
+        std::size_t fillers{0};
+        for( long long x : cv ){
+            if( x == -1 ){
+                ++fillers;
+            }else{
+                ++seen[x];
+            }
+        }
+        EXPECT_EQ( fillers, std::size_t( threads * per_thread / 2 ) );
+        EXPECT_EQ( std::count( seen.begin(), seen.end(), 1 ), std::ptrdiff_t( threads * per_thread / 2 ) );
+        EXPECT_GE( cv.capacity(), cv.size() );
+    }
+
+    {
+        BEGIN_TEST(tm13, "ConcurrentLifetime","elements never move; copies and clear() destroy what was built");
+        Tracked::reset();
+        {
+            sc::concurrent_vector<Tracked, 4> cv;
+            cv.emplace_back( 1 );
+            const Tracked * first = &cv[0];
+            cv.grow_by( 100 );
+            cv.push_back( Tracked{ 7 } );
+            EXPECT_EQ( &cv[0], first );
+            EXPECT_EQ( cv.size(), 102u );
+            EXPECT_EQ( Tracked::alive, 102 );
+            EXPECT_EQ( Tracked::default_ctors, 100 );
+            EXPECT_EQ( Tracked::moves, 1 );
+            EXPECT_EQ( cv.at( 101 ).value, 7 );
+            sc::concurrent_vector<Tracked, 4> copy{ cv };
+            EXPECT_EQ( Tracked::alive, 204 );
+            EXPECT_EQ( std::distance( copy.begin(), copy.end() ), 102 );
+            copy.clear();
+            EXPECT_TRUE( copy.empty() );
+            EXPECT_EQ( Tracked::alive, 102 );
+        }
+        EXPECT_EQ( Tracked::alive, 0 );
+    }
+
+    {
+        BEGIN_TEST(tm13, "ConcurrentThrow","a push that throws leaves a dead slot that publication passes over");
+        Fragile::alive = 0;
+        Fragile::fuse = 0;
+        {
+            Fragile one{ 1 };
+            sc::concurrent_vector<Fragile, 4> cv;
+            cv.push_back( one );
+            cv.push_back( one );
+            Fragile::fuse = 1;
+            bool caught{false};
+            try{
+                cv.push_back( one );
+            }catch( const std::runtime_error & ){
+                caught = true;
+            }
+            EXPECT_TRUE( caught );
+            cv.emplace_back( 4 );
+            EXPECT_EQ( cv.size(), 4u );                 // Not stuck at the failed slot.
+            EXPECT_TRUE( cv.is_dead( 2 ) );
+            EXPECT_FALSE( cv.is_dead( 3 ) );
+            EXPECT_EQ( cv.at( 3 ).value, 4 );
+            EXPECT_EQ( Fragile::alive, 4 );
+
+            Fragile::fuse = 2;                          // The second of three copies throws.
+            caught = false;
+            try{
+                cv.grow_by( 3, one );
+            }catch( const std::runtime_error & ){
+                caught = true;
+            }
+            EXPECT_TRUE( caught );
+            EXPECT_EQ( cv.size(), 7u );
+            EXPECT_FALSE( cv.is_dead( 4 ) );
+            EXPECT_TRUE( cv.is_dead( 5 ) );
+            EXPECT_TRUE( cv.is_dead( 6 ) );
+            EXPECT_EQ( Fragile::alive, 5 );
+
+            sc::concurrent_vector<Fragile, 4> copy{ cv };
+            EXPECT_EQ( copy.size(), 4u );               // The dead slots are not copied.
+            EXPECT_EQ( copy[2].value, 4 );
+            EXPECT_EQ( Fragile::alive, 9 );
+        }
+        EXPECT_EQ( Fragile::alive, 0 );                 // Dead slots were not destroyed.
+    }
+
+    tm13.summary();
+    std::cout << "\n\n";
+
+    TestManager tm14{ "RCU vector testing"};
+
+    {
+        BEGIN_TEST(tm14, "Versions","snapshots keep their version; retired versions go once unheld");
+        Tracked::reset();
+        {
+            sc::rcu_vector<Tracked> table{ sc::vector<Tracked>{ Tracked{ 1 }, Tracked{ 2 } } };
+            auto before = table.read();
+            table.update( []( sc::vector<Tracked> & next ){
+                next.push_back( Tracked{ 3 } );
+                next[0].value = 10;
+            } );
+            auto after = table.read();
+            EXPECT_EQ( before.size(), 2u );
+            EXPECT_EQ( before[0].value, 1 );
+            EXPECT_EQ( after.size(), 3u );
+            EXPECT_EQ( after[0].value, 10 );
+            EXPECT_EQ( table.retired(), 1u );           // 'before' still holds the first version.
+            EXPECT_EQ( Tracked::alive, 5 );
+            {
+                auto copy = before;
+                before = after;
+                table.reclaim();
+                EXPECT_EQ( table.retired(), 1u );       // 'copy' does now.
+            }
+            table.reclaim();
+            EXPECT_EQ( table.retired(), 0u );
+            EXPECT_EQ( Tracked::alive, 3 );
+            bool caught{false};
+            try{
+                table.update( []( sc::vector<Tracked> & next ){
+                    next.clear();
+                    throw std::runtime_error( "abandoned" );
+                } );
+            }catch( const std::runtime_error & ){
+                caught = true;
+            }
+            EXPECT_TRUE( caught );
+            EXPECT_EQ( table.read().size(), 3u );       // Nothing was published.
+            table.assign( sc::vector<Tracked>{} );
+            EXPECT_TRUE( table.read().empty() );
+        }
+        EXPECT_EQ( Tracked::alive, 0 );
+    }
+
+    {
+        BEGIN_TEST(tm14, "ReadersAndWriter","readers always see a whole version while a writer publishes");
+        sc::rcu_vector<long long> table{ sc::vector<long long>( 256, 0LL ) };
+        std::atomic<bool> done{false};
+        std::atomic<bool> consistent{true};
+        std::vector<std::thread> readers;
+        for( int r{0} ; r < 4 ; ++r ){
+            readers.emplace_back( [&](){
+                while( !done.load() ){
+                    auto snap = table.read();
+                    // Every version holds one value repeated.
+                    for( long long x : snap ){
+                        if( x != snap[0] ){
+                            consistent = false;
+                        }
+                    }
+                }
+            } );
+        }
+        for( long long v{1} ; v <= 200 ; ++v ){
+            table.update( [v]( sc::vector<long long> & next ){
+                for( auto & x : next ){
+                    x = v;
+                }
+            } );
+        }
+        done = true;
+        for( auto & r : readers ){
+            r.join();
+        }
+        table.reclaim();
+        EXPECT_TRUE( consistent.load() );
+        EXPECT_EQ( table.read()[255], 200 );
+        EXPECT_EQ( table.retired(), 0u );
+    }
+
+    tm14.summary();
+    std::cout << "\n\n";
+
+    TestManager tm15{ "Radix sort testing"};
+
+    {
+        BEGIN_TEST(tm15, "RadixSort","radix_sort() matches std::sort for unsigned, signed and floating point keys");
+        std::uint64_t x{88172645463325252ULL};
+        auto next = [&x](){ x ^= x << 13; x ^= x >> 7; x ^= x << 17; return x; };
+        for( std::size_t n : { std::size_t( 100 ), std::size_t( 5000 ), std::size_t( 70001 ) } ){
+            sc::vector<std::uint32_t> u32;
+            sc::vector<std::uint64_t> u64;
+            sc::vector<long long> i64;
+            sc::vector<float> f32;
+            sc::vector<double> f64;
+            for( std::size_t i{0} ; i < n ; ++i ){
+                std::uint64_t r = next();
+                u32.push_back( std::uint32_t( r ) );
+                u64.push_back( r & 0xffffffffffULL );                   // Upper digits all zero, so their passes are skipped.
+                i64.push_back( static_cast<long long>( r ) >> ( r % 40 ) );
+                f32.push_back( float( static_cast<long long>( r ) % 100000 ) / 7.0f );
+                f64.push_back( ( r % 3 == 0 ? -1.0 : 1.0 ) * double( r % 1000003 ) * 1e-3 );
+            }
+            f32[0] = -0.0f;
+            f32[1] = 0.0f;
+            f64[0] = -std::numeric_limits<double>::infinity();
+            f64[1] = std::numeric_limits<double>::infinity();
+            std::vector<std::uint32_t> e32( u32.begin(), u32.end() );
+            std::vector<std::uint64_t> e64( u64.begin(), u64.end() );
+            std::vector<long long> ei64( i64.begin(), i64.end() );
+            std::vector<float> ef32( f32.begin(), f32.end() );
+            std::vector<double> ef64( f64.begin(), f64.end() );
+            std::sort( e32.begin(), e32.end() );
+            std::sort( e64.begin(), e64.end() );
+            std::sort( ei64.begin(), ei64.end() );
+            std::sort( ef32.begin(), ef32.end() );
+            std::sort( ef64.begin(), ef64.end() );
+            sc::radix_sort( u32 );
+            sc::radix_sort( u64 );
+            sc::radix_sort( i64 );
+            sc::radix_sort( f32 );
+            sc::radix_sort( f64 );
+            EXPECT_TRUE( std::equal( u32.begin(), u32.end(), e32.begin() ) );
+            EXPECT_TRUE( std::equal( u64.begin(), u64.end(), e64.begin() ) );
+            EXPECT_TRUE( std::equal( i64.begin(), i64.end(), ei64.begin() ) );
+            EXPECT_TRUE( std::equal( f32.begin(), f32.end(), ef32.begin() ) );
+            EXPECT_TRUE( std::equal( f64.begin(), f64.end(), ef64.begin() ) );
+        }
+        sc::vector<float> zeros{ 0.0f, -0.0f, 0.0f, -0.0f };
+        sc::radix_sort( zeros );
+        EXPECT_TRUE( std::signbit( zeros[0] ) && std::signbit( zeros[1] ) && !std::signbit( zeros[2] ) );
+    }
+
+    {
+        BEGIN_TEST(tm15, "RadixSortByKey","radix_sort_by_key() is stable and moves the values with their keys");
+        for( int n : { 50, 40000 } ){
+            sc::vector<int> keys;
+            sc::vector<std::string> values;
+            for( int i{0} ; i < n ; ++i ){
+                keys.push_back( ( i * 7919 ) % 101 - 50 );
+                values.push_back( std::to_string( i ) );
+            }
+            std::vector<std::pair<int, int>> expected;
+            for( int i{0} ; i < n ; ++i ){
+                expected.push_back( std::make_pair( keys[i], i ) );
+            }
+            std::stable_sort( expected.begin(), expected.end(), []( const std::pair<int, int> & a, const std::pair<int, int> & b ){
+                return a.first < b.first;
+            } );
+            sc::radix_sort_by_key( keys, values );
+            bool same{true};
+            for( int i{0} ; i < n ; ++i ){
+                same = same && keys[i] == expected[i].first && values[i] == std::to_string( expected[i].second );
+            }
+            EXPECT_TRUE( same );
+        }
+        sc::vector<int> keys{ 1, 2 };
+        sc::vector<int> values{ 1 };
+        bool caught{false};
+        try{
+            sc::radix_sort_by_key( keys, values );
+        }catch( const std::length_error & ){
+            caught = true;
+        }
+        EXPECT_TRUE( caught );
+
+        // Move-only values with no default constructor: the scratch values are built by moves.
+        {
+            std::vector<Ticket> source;
+            sc::vector<std::uint32_t> ids;
+            for( int i{0} ; i < 40000 ; ++i ){
+                source.push_back( Ticket( i ) );
+                ids.push_back( static_cast<std::uint32_t>( 39999 - i ) << 12 );
+            }
+            sc::vector<Ticket> tickets( std::make_move_iterator( source.begin() ), std::make_move_iterator( source.end() ) );
+            source.clear();
+            sc::radix_sort_by_key( ids, tickets );
+            EXPECT_EQ( tickets.front().value, 39999 );
+            EXPECT_EQ( tickets.back().value, 0 );
+            EXPECT_EQ( Ticket::alive.load(), 40000 );
+        }
+        EXPECT_EQ( Ticket::alive.load(), 0 );
+
+        // A value move that throws halfway through the first pass leaves no value built twice or leaked.
+        Fragile::alive = 0;
+        Fragile::fuse = 0;
+        {
+            sc::vector<int> shuffled;
+            sc::vector<Fragile> fragile;
+            fragile.reserve( 40000 );
+            for( int i{0} ; i < 40000 ; ++i ){
+                shuffled.push_back( ( i * 7919 ) % 40000 );
+                fragile.emplace_back( i );
+            }
+            Fragile::fuse = 20000;
+            caught = false;
+            try{
+                sc::radix_sort_by_key( shuffled, fragile );
+            }catch( const std::runtime_error & ){
+                caught = true;
+            }
+            Fragile::fuse = 0;
+            EXPECT_TRUE( caught );
+            EXPECT_EQ( Fragile::alive, 40000 );
+        }
+        EXPECT_EQ( Fragile::alive, 0 );
+    }
+
+    tm15.summary();
+
     return 0;
 }